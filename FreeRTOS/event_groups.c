@@ -215,7 +215,7 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
         xEventGroupSetBits( xEventGroup, uxBitsToSet );
         if ( pxHigherPriorityTaskWoken != NULL)
         {
-            pxHigherPriorityTaskWoken = pdFALSE;
+            *pxHigherPriorityTaskWoken = pdFALSE;
         }
 
         return pdPASS;
@@ -122,12 +122,7 @@
 /* The following features are not supported by RT-Thread */
 #define INCLUDE_xTimerPendFunctionCall          0
 #define configUSE_CO_ROUTINES                   0
-#define configQUEUE_REGISTRY_SIZE               0
-#define configUSE_QUEUE_SETS                    0
 #define configUSE_TICKLESS_IDLE                 0
-#define configGENERATE_RUN_TIME_STATS           0
-#define configUSE_TRACE_FACILITY                0
-#define configUSE_STATS_FORMATTING_FUNCTIONS    0
 
 /*
  * Check all the required application specific macros have been defined.
@@ -291,6 +286,58 @@
     #endif
 #endif
 
+/* Set to 1 to back queueQUEUE_TYPE_BASE queues with the wrapper's own
+ * contiguous ring buffer instead of rt_messagequeue.  Queue storage is then
+ * exactly uxQueueLength * uxItemSize bytes, as in FreeRTOS. */
+#ifndef configUSE_QUEUE_RING_BUFFER
+    #ifdef PKG_FREERTOS_USING_QUEUE_RING_BUFFER
+        #define configUSE_QUEUE_RING_BUFFER    1
+    #else
+        #define configUSE_QUEUE_RING_BUFFER    0
+    #endif
+#endif
+
+/* Set to 1 to back binary and counting semaphores with the wrapper's own
+ * semaphore, which gives and takes with compare-and-swap and only masks
+ * interrupts to block or to wake a blocked task. */
+#ifndef configUSE_NATIVE_SEMAPHORES
+    #ifdef PKG_FREERTOS_USING_NATIVE_SEMAPHORES
+        #define configUSE_NATIVE_SEMAPHORES    1
+    #else
+        #define configUSE_NATIVE_SEMAPHORES    0
+    #endif
+#endif
+
+/* Set to 1 to back mutexes created by xSemaphoreCreateMutex() with the
+ * wrapper's own mutex, which takes and gives with a single compare-and-swap
+ * when uncontended and only enters the kernel, with priority inheritance, when
+ * a task has to wait.  Recursive mutexes always use rt_mutex. */
+#ifndef configUSE_LEAN_MUTEXES
+    #ifdef PKG_FREERTOS_USING_LEAN_MUTEXES
+        #define configUSE_LEAN_MUTEXES    1
+    #else
+        #define configUSE_LEAN_MUTEXES    0
+    #endif
+#endif
+
+/* Set to 1 to make FromISR functions only ready the tasks they wake and report
+ * in *pxHigherPriorityTaskWoken whether one outranks the interrupted task, so
+ * the ISR switches context once, in portYIELD_FROM_ISR(), however many
+ * objects it signalled. */
+#ifndef configUSE_DEFERRED_ISR_YIELD
+    #ifdef PKG_FREERTOS_USING_DEFERRED_ISR_YIELD
+        #define configUSE_DEFERRED_ISR_YIELD    1
+    #else
+        #define configUSE_DEFERRED_ISR_YIELD    0
+    #endif
+#endif
+
+#ifndef configUSE_QUEUE_SETS
+    #ifdef PKG_FREERTOS_USING_QUEUE_SETS
+        #define configUSE_QUEUE_SETS    1
+    #endif
+#endif
+
 #ifndef configUSE_ALTERNATIVE_API
     #define configUSE_ALTERNATIVE_API    0
 #endif
@@ -351,7 +398,181 @@
 #endif
 
 #ifndef configQUEUE_REGISTRY_SIZE
-    #define configQUEUE_REGISTRY_SIZE    0U
+    #ifdef PKG_FREERTOS_QUEUE_REGISTRY_SIZE
+        #define configQUEUE_REGISTRY_SIZE    PKG_FREERTOS_QUEUE_REGISTRY_SIZE
+    #else
+        #define configQUEUE_REGISTRY_SIZE    0U
+    #endif
+#endif
+
+/* Set to 1 to keep per-queue counters of sends, receives and blocking, which
+ * can be read with vQueueGetStatistics(). */
+#ifndef configUSE_QUEUE_STATISTICS
+    #ifdef PKG_FREERTOS_USING_QUEUE_STATISTICS
+        #define configUSE_QUEUE_STATISTICS    1
+    #else
+        #define configUSE_QUEUE_STATISTICS    0
+    #endif
+#endif
+
+/* Set to 1 to let a callback or a task notification report when a queue fills
+ * past a high mark and drains back to a low mark.  See xQueueSetWatermarks(). */
+#ifndef configUSE_QUEUE_WATERMARKS
+    #ifdef PKG_FREERTOS_USING_QUEUE_WATERMARKS
+        #define configUSE_QUEUE_WATERMARKS    1
+    #else
+        #define configUSE_QUEUE_WATERMARKS    0
+    #endif
+#endif
+
+/* Set to 1 to time every mutex take and give, and keep per-mutex counts of
+ * contention, wait and hold times that can be read with
+ * vQueueGetMutexProfile().  configMUTEX_PROFILING_CLOCK() reads the time base;
+ * it defaults to the tick count and can be set to a cycle counter for a finer
+ * resolution. */
+#ifndef configUSE_MUTEX_PROFILING
+    #ifdef PKG_FREERTOS_USING_MUTEX_PROFILING
+        #define configUSE_MUTEX_PROFILING    1
+    #else
+        #define configUSE_MUTEX_PROFILING    0
+    #endif
+#endif
+
+#ifndef configMUTEX_PROFILING_CLOCK
+    #define configMUTEX_PROFILING_CLOCK()    ( ( uint32_t ) rt_tick_get() )
+#endif
+
+/* Buckets in each histogram of a mutex profile.  Bucket 0 counts times of 0,
+ * bucket n times from 2^(n-1) up to 2^n - 1, and the last bucket everything
+ * longer. */
+#ifndef configMUTEX_PROFILING_BUCKETS
+    #define configMUTEX_PROFILING_BUCKETS    8
+#endif
+
+/* Set to 1 to provide uxTaskGetSystemState() and vTaskGetInfo(), which take a
+ * snapshot of every thread in the system. */
+#ifndef configUSE_TRACE_FACILITY
+    #ifdef PKG_FREERTOS_USING_TRACE_FACILITY
+        #define configUSE_TRACE_FACILITY    1
+    #else
+        #define configUSE_TRACE_FACILITY    0
+    #endif
+#endif
+
+/* Set to 1 to charge the time between task switches to the task switched out,
+ * as read from portGET_RUN_TIME_COUNTER_VALUE().  Needs RT_USING_HOOK, and
+ * takes the scheduler hook and the object attach and detach hooks.  The
+ * counters are kept in the thread table; threads created while it is full are
+ * not measured. */
+#ifndef configGENERATE_RUN_TIME_STATS
+    #ifdef PKG_FREERTOS_USING_RUN_TIME_STATS
+        #define configGENERATE_RUN_TIME_STATS    1
+    #else
+        #define configGENERATE_RUN_TIME_STATS    0
+    #endif
+#endif
+
+/* Entries in the table of live threads that the object hooks keep for the run
+ * time stats, and for uxTaskGetSystemState() and the stack monitor to check in
+ * constant time that a thread has not been freed.  Must be a power of two; one entry is always left
+ * free. */
+#ifndef configTHREAD_TABLE_SIZE
+    #define configTHREAD_TABLE_SIZE    64
+#endif
+
+/* Set to 1 to keep a count of threads up to date from the object hooks, so
+ * that uxTaskGetNumberOfTasks() is a single load instead of a walk of the
+ * thread list with interrupts disabled.  Needs RT_USING_HOOK, and takes the
+ * object attach and detach hooks. */
+#ifndef configUSE_LIVE_TASK_COUNT
+    #ifdef PKG_FREERTOS_USING_LIVE_TASK_COUNT
+        #define configUSE_LIVE_TASK_COUNT    1
+    #else
+        #define configUSE_LIVE_TASK_COUNT    0
+    #endif
+#endif
+
+/* Set to 1 to keep a hash index of names, so that xTaskGetHandle(),
+ * xTimerGetHandle() and xQueueGetHandle() do not have to compare the name of
+ * every object.  Tasks are added from the object hooks, which needs
+ * RT_USING_HOOK; timers when they are created and queues when they are added
+ * to the registry.  configNAME_INDEX_SIZE must be a power of two; once it is
+ * full, lookups of the kind that did not fit fall back to a search. */
+#ifndef configUSE_NAME_INDEX
+    #ifdef PKG_FREERTOS_USING_NAME_INDEX
+        #define configUSE_NAME_INDEX    1
+    #else
+        #define configUSE_NAME_INDEX    0
+    #endif
+#endif
+
+#ifndef configNAME_INDEX_SIZE
+    #define configNAME_INDEX_SIZE    64
+#endif
+
+/* Set to 1 to run a low priority task that measures the stack use of every
+ * thread each configSTACK_MONITOR_PERIOD_MS milliseconds and keeps the peak
+ * for up to configSTACK_MONITOR_MAX_TASKS thread names.  The stack_monitor
+ * command lists them with a suggested stack depth, which is the peak plus
+ * configSTACK_MONITOR_MARGIN percent. */
+#ifndef configUSE_STACK_MONITOR
+    #ifdef PKG_FREERTOS_USING_STACK_MONITOR
+        #define configUSE_STACK_MONITOR    1
+    #else
+        #define configUSE_STACK_MONITOR    0
+    #endif
+#endif
+
+#ifndef configSTACK_MONITOR_PERIOD_MS
+    #define configSTACK_MONITOR_PERIOD_MS    1000
+#endif
+
+#ifndef configSTACK_MONITOR_MAX_TASKS
+    #define configSTACK_MONITOR_MAX_TASKS    32
+#endif
+
+#ifndef configSTACK_MONITOR_MARGIN
+    #define configSTACK_MONITOR_MARGIN       25
+#endif
+
+/* In words, as the stack depth given to xTaskCreate() */
+#ifndef configSTACK_MONITOR_STACK_SIZE
+    #define configSTACK_MONITOR_STACK_SIZE   configMINIMAL_STACK_SIZE
+#endif
+
+/* Set to 1, together with configUSE_TRACE_FACILITY, to provide the vTaskList()
+ * and vTaskGetRunTimeStats() text formatters. */
+#ifndef configUSE_STATS_FORMATTING_FUNCTIONS
+    #ifdef PKG_FREERTOS_USING_STATS_FORMATTING_FUNCTIONS
+        #define configUSE_STATS_FORMATTING_FUNCTIONS    1
+    #else
+        #define configUSE_STATS_FORMATTING_FUNCTIONS    0
+    #endif
+#endif
+
+/* Set configQUEUE_POOL_BLOCK_COUNT above 0 to create dynamic queues,
+ * semaphores and mutexes from a fixed pool of blocks of
+ * configQUEUE_POOL_BLOCK_SIZE bytes.  An object whose handle and storage do not
+ * fit in a block, or that is created when the pool is empty, comes from the
+ * heap instead. */
+#ifndef configQUEUE_POOL_BLOCK_COUNT
+    #ifdef PKG_FREERTOS_QUEUE_POOL_BLOCK_COUNT
+        #define configQUEUE_POOL_BLOCK_COUNT    PKG_FREERTOS_QUEUE_POOL_BLOCK_COUNT
+    #else
+        #define configQUEUE_POOL_BLOCK_COUNT    0
+    #endif
+#endif
+
+#ifndef configQUEUE_POOL_BLOCK_SIZE
+    #ifdef PKG_FREERTOS_QUEUE_POOL_BLOCK_SIZE
+        #define configQUEUE_POOL_BLOCK_SIZE    PKG_FREERTOS_QUEUE_POOL_BLOCK_SIZE
+    #else
+        #define configQUEUE_POOL_BLOCK_SIZE    128
+    #endif
+#endif
+
+#if ( configQUEUE_POOL_BLOCK_COUNT > 0 ) && !defined( RT_USING_MEMPOOL )
+    #error configQUEUE_POOL_BLOCK_COUNT requires RT_USING_MEMPOOL
 #endif
 
 #if ( configQUEUE_REGISTRY_SIZE < 1 )
@@ -1180,20 +1401,134 @@ typedef struct xSTATIC_TCB
     #endif
 } StaticTask_t;
 
+#if ( configUSE_QUEUE_STATISTICS == 1 )
+
+/*
+ * Counters kept for each queue, semaphore and mutex when
+ * configUSE_QUEUE_STATISTICS is 1.  A send or receive that could not complete
+ * at once and had to wait is counted as blocked.  Multiple item calls count
+ * every item moved.
+ */
+    typedef struct xQUEUE_STATISTICS
+    {
+        uint32_t ulSends;               /* Items sent, or semaphores given. */
+        uint32_t ulReceives;            /* Items received, or semaphores taken. */
+        uint32_t ulSendsBlocked;        /* Sends that had to wait for space. */
+        uint32_t ulReceivesBlocked;     /* Receives that had to wait for an item. */
+        TickType_t xBlockedTicks;       /* Ticks spent waiting, by senders and receivers. */
+        UBaseType_t uxPeakMessages;     /* Most items ever held at once. */
+    } QueueStatistics_t;
+
+#endif
+
+#if ( configUSE_QUEUE_WATERMARKS == 1 )
+
+/*
+ * Watermarks of a queue, set with xQueueSetWatermarks().  xAboveHighMark is
+ * pdTRUE from the time the queue reaches uxHighMark items until it is back
+ * down to uxLowMark.
+ */
+    struct QueueDefinition;
+
+    typedef struct xQUEUE_WATERMARKS
+    {
+        void ( * pxCallback )( struct QueueDefinition * xQueue,
+                               BaseType_t xAboveHighMark,
+                               void * pvContext );
+        void * pvContext;
+        UBaseType_t uxHighMark;
+        UBaseType_t uxLowMark;
+        BaseType_t xAboveHighMark;
+    } QueueWatermarks_t;
+
+#endif
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+/*
+ * Profile of a mutex when configUSE_MUTEX_PROFILING is 1, read with
+ * vQueueGetMutexProfile().  Times are in configMUTEX_PROFILING_CLOCK() units.
+ * An acquisition is a take that leaves the mutex held once by the caller, so
+ * the takes and gives nested inside it by a recursive mutex are not counted.
+ */
+    typedef struct xMUTEX_PROFILE
+    {
+        uint32_t ulAcquisitions;        /* Takes that acquired the mutex. */
+        uint32_t ulContended;           /* Acquisitions that had to wait for the holder. */
+        uint32_t ulTimeouts;            /* Takes that waited and gave up. */
+        uint64_t ullTotalWait;          /* Time spent waiting, by contended acquisitions. */
+        uint32_t ulMaxWait;             /* Longest wait of a contended acquisition. */
+        uint32_t ulMaxHold;             /* Longest time the mutex was held. */
+        struct tskTaskControlBlock * xMaxHoldTask;  /* Task that held the mutex for ulMaxHold. */
+        char pcMaxHoldTaskName[ configMAX_TASK_NAME_LEN ];
+        uint32_t ulWaitHistogram[ configMUTEX_PROFILING_BUCKETS ];  /* Waits of contended acquisitions. */
+        uint32_t ulHoldHistogram[ configMUTEX_PROFILING_BUCKETS ];  /* Hold times. */
+    } MutexProfile_t;
+
+#endif
+
 typedef struct
 {
     struct rt_ipc_object *rt_ipc;
-    struct rt_messagequeue ipc_obj;
+    uint8_t ucQueueKind;
+    uint8_t ucAllocation;
+    uint16_t usSlotsHeld;
+#if ( configUSE_QUEUE_SETS == 1 )
+    struct QueueDefinition *pxQueueSetContainer;
+#endif
+#if ( configUSE_QUEUE_STATISTICS == 1 )
+    QueueStatistics_t xStatistics;
+#endif
+#if ( configUSE_QUEUE_WATERMARKS == 1 )
+    QueueWatermarks_t xWatermarks;
+#endif
+    union
+    {
+    #if ( configUSE_QUEUE_RING_BUFFER == 1 )
+        struct rt_ring_queue mq;
+    #else
+        struct rt_messagequeue mq;
+    #endif
+        struct rt_spsc_queue spsc;
+        struct rt_mailbox_queue mailbox;
+        struct rt_priority_queue priority;
+        struct rt_broadcast_queue broadcast;
+        struct rt_broadcast_subscriber subscriber;
+    } ipc_obj;
 } StaticQueue_t;
 
 typedef struct
 {
     struct rt_ipc_object *rt_ipc;
+    uint8_t ucQueueKind;
+    uint8_t ucAllocation;
+    uint16_t usSlotsHeld;
+#if ( configUSE_QUEUE_SETS == 1 )
+    struct QueueDefinition *pxQueueSetContainer;
+#endif
+#if ( configUSE_QUEUE_STATISTICS == 1 )
+    QueueStatistics_t xStatistics;
+#endif
+#if ( configUSE_QUEUE_WATERMARKS == 1 )
+    QueueWatermarks_t xWatermarks;
+#endif
     union
     {
+    #if ( configUSE_NATIVE_SEMAPHORES == 1 )
+        struct rt_native_semaphore semaphore;
+    #else
         struct rt_semaphore_wrapper semaphore;
+    #endif
         struct rt_mutex mutex;
+        struct rt_lean_mutex lean_mutex;
+        struct rt_rwlock rwlock;
     } ipc_obj;
+#if ( configUSE_MUTEX_PROFILING == 1 )
+    /* After the kernel object, so queues do not carry it */
+    MutexProfile_t xMutexProfile;
+    uint32_t ulHoldStart;
+    struct QueueDefinition *pxNextProfiledMutex;
+#endif
 } StaticSemaphore_t;
 
 typedef struct xSTATIC_EVENT_GROUP
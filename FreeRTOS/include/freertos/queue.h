@@ -46,10 +46,25 @@
 struct QueueDefinition; /* Using old naming convention so as not to break kernel aware debuggers. */
 typedef struct QueueDefinition   * QueueHandle_t;
 
+/**
+ * Type by which queue sets are referenced.  For example, a call to
+ * xQueueCreateSet() returns an xQueueSet variable that can then be used as a
+ * parameter to xQueueSelectFromSet(), xQueueAddToSet(), etc.
+ */
+typedef struct QueueDefinition   * QueueSetHandle_t;
+
+/**
+ * Queue sets can contain both queues and semaphores, so the
+ * QueueSetMemberHandle_t is defined as a type to be used where a parameter or
+ * return value can be either an QueueHandle_t or an SemaphoreHandle_t.
+ */
+typedef struct QueueDefinition   * QueueSetMemberHandle_t;
+
 /* For internal use only. */
 #define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
 #define queueOVERWRITE                        ( ( BaseType_t ) 2 )
+#define queueSEND_WITH_PRIORITY( uxPriority ) ( ( BaseType_t ) 3 + ( BaseType_t ) ( uxPriority ) )
 
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE                  ( ( uint8_t ) 0U )
@@ -58,6 +73,12 @@ typedef struct QueueDefinition   * QueueHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE    ( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE      ( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX       ( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_RWLOCK                ( ( uint8_t ) 5U )
+
+/* What a send to a full broadcast queue does.  See xQueueCreateBroadcast(). */
+#define queueBROADCAST_BLOCK                  ( ( uint8_t ) 0U )
+#define queueBROADCAST_DROP_NEWEST            ( ( uint8_t ) 1U )
+#define queueBROADCAST_DROP_OLDEST            ( ( uint8_t ) 2U )
 
 /**
  * queue. h
@@ -217,6 +238,470 @@ typedef struct QueueDefinition   * QueueHandle_t;
     #define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateSPSC(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize
+ *                        );
+ * @endcode
+ *
+ * Creates a queue for exactly one producer and one consumer, for example an
+ * ISR streaming samples to a single task.  Items are moved without a lock:
+ * the producer only writes the tail index and the consumer only writes the
+ * head index, each published with release ordering.  Interrupts are only
+ * masked to block a task or to wake one, and the consumer is only woken when
+ * the queue goes from empty to not empty.
+ *
+ * The queue is used through the normal API: xQueueSend(), xQueueSendToBack(),
+ * xQueueSendFromISR(), xQueueSendToBackFromISR(), xQueueReceive(),
+ * xQueueReceiveFromISR(), uxQueueMessagesWaiting(), uxQueueSpacesAvailable(),
+ * xQueueReset() and vQueueDelete().  Sending to the front is not supported,
+ * and using the queue from more than one producer or more than one consumer
+ * corrupts it.  xQueueReset() and vQueueDelete() must not run while either
+ * side is using the queue.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ * At most 65535.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * At most 65535.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+ * @code{c}
+ * QueueHandle_t xAdcQueue;
+ *
+ * void vADC_ISR( void )
+ * {
+ * uint16_t usSample = ADC_READ();
+ *
+ *  xQueueSendToBackFromISR( xAdcQueue, &usSample, NULL );
+ * }
+ *
+ * void vConsumerTask( void *pvParameters )
+ * {
+ * uint16_t usSample;
+ *
+ *  for( ;; )
+ *  {
+ *      xQueueReceive( xAdcQueue, &usSample, portMAX_DELAY );
+ *      vProcessSample( usSample );
+ *  }
+ * }
+ *
+ * void vSetup( void )
+ * {
+ *  xAdcQueue = xQueueCreateSPSC( 64, sizeof( uint16_t ) );
+ * }
+ * @endcode
+ * \defgroup xQueueCreateSPSC xQueueCreateSPSC
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueCreateSPSC( const UBaseType_t uxQueueLength,
+                                    const UBaseType_t uxItemSize );
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateSPSCStatic(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            uint8_t *pucQueueStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Creates a single producer, single consumer queue using memory supplied by
+ * the application.  See xQueueCreateSPSC() for how the queue behaves.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ * At most 65535.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * At most 65535.
+ *
+ * @param pucQueueStorage Must point to a uint8_t array of at least
+ * ( uxQueueLength * uxItemSize ) bytes.  QUEUE_BUFFER_SIZE() is not needed.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  If pucQueueStorage or pxQueueBuffer is NULL then NULL is
+ * returned.
+ * \defgroup xQueueCreateSPSCStatic xQueueCreateSPSCStatic
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueCreateSPSCStatic( const UBaseType_t uxQueueLength,
+                                          const UBaseType_t uxItemSize,
+                                          uint8_t * pucQueueStorage,
+                                          StaticQueue_t * pxQueueBuffer );
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateMailbox(
+ *                            UBaseType_t uxItemSize
+ *                        );
+ * @endcode
+ *
+ * Creates a mailbox: a queue of length one that holds the latest value
+ * written with xQueueOverwrite() or xQueueOverwriteFromISR().  It is meant
+ * for state that is published at a high rate and read by many tasks, such as
+ * attitude or battery level.
+ *
+ * Writers never block.  Readers that use xQueuePeek() or xQueuePeekFromISR()
+ * copy the value without masking interrupts: a sequence counter that is odd
+ * while a write is in progress tells them to retry if a writer got in the
+ * way.  xQueueReceive() empties the mailbox.  xQueueSend() and friends wait
+ * while the mailbox is full, as they would for any queue of length one.
+ * Tasks blocked reading an empty mailbox are all woken by the next write.
+ *
+ * The zero-copy functions cannot be used with a mailbox.
+ *
+ * @param uxItemSize The number of bytes in the value.  At most 65535.
+ *
+ * @return If the mailbox is successfully created then a handle to it is
+ * returned.  If it cannot be created then 0 is returned.
+ * \defgroup xQueueCreateMailbox xQueueCreateMailbox
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueCreateMailbox( const UBaseType_t uxItemSize );
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateMailboxStatic(
+ *                            UBaseType_t uxItemSize,
+ *                            uint8_t *pucMailboxStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Creates a mailbox using memory supplied by the application.  See
+ * xQueueCreateMailbox() for how the mailbox behaves.
+ *
+ * @param uxItemSize The number of bytes in the value.  At most 65535.
+ *
+ * @param pucMailboxStorage Must point to a uint8_t array of at least
+ * uxItemSize bytes.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the mailbox's data structure.
+ *
+ * @return If the mailbox is created then a handle to it is returned.  If
+ * pucMailboxStorage or pxQueueBuffer is NULL then NULL is returned.
+ * \defgroup xQueueCreateMailboxStatic xQueueCreateMailboxStatic
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueCreateMailboxStatic( const UBaseType_t uxItemSize,
+                                             uint8_t * pucMailboxStorage,
+                                             StaticQueue_t * pxQueueBuffer );
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriority(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            UBaseType_t uxPriorityLevels
+ *                        );
+ * @endcode
+ *
+ * Creates a queue whose items are received in priority order.  Each item is
+ * sent with a priority from 0 to ( uxPriorityLevels - 1 ) using
+ * xQueueSendWithPriority() or xQueueSendWithPriorityFromISR(), and
+ * xQueueReceive(), xQueuePeek() and their FromISR versions always return the
+ * oldest item of the highest priority held.  This lets urgent messages, such
+ * as control commands, overtake bulk data queued to the same task.
+ *
+ * Send and receive take constant time whatever the number of levels: the
+ * items of each level are kept in their own FIFO, and a bitmap of non-empty
+ * levels gives the highest one in a single find-first-set.  All levels share
+ * the uxQueueLength slots of the queue.
+ *
+ * xQueueSend() and xQueueSendToBack() send with priority 0, and
+ * xQueueSendToFront() places the item ahead of everything else, at the front
+ * of the highest level.  xQueueSendMultiple() sends with priority 0.
+ * xQueueOverwrite() and the zero-copy functions cannot be used with a
+ * priority queue.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain,
+ * across all levels.  At most 65534.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * At most 65535.
+ *
+ * @param uxPriorityLevels The number of priorities.  From 1 to 32.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+ * @code{c}
+ * #define PRIORITY_BULK       0
+ * #define PRIORITY_CONTROL    1
+ *
+ * QueueHandle_t xLinkQueue;
+ *
+ * void vSetup( void )
+ * {
+ *  xLinkQueue = xQueueCreatePriority( 16, sizeof( struct xMessage ), 2 );
+ * }
+ *
+ * void vSendAbort( void )
+ * {
+ * struct xMessage xAbort = { MSG_ABORT };
+ *
+ *  // Received before any bulk message already queued.
+ *  xQueueSendWithPriority( xLinkQueue, &xAbort, PRIORITY_CONTROL, portMAX_DELAY );
+ * }
+ * @endcode
+ * \defgroup xQueueCreatePriority xQueueCreatePriority
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueCreatePriority( const UBaseType_t uxQueueLength,
+                                        const UBaseType_t uxItemSize,
+                                        const UBaseType_t uxPriorityLevels );
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriorityStatic(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            UBaseType_t uxPriorityLevels,
+ *                            uint8_t *pucQueueStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Creates a priority queue using memory supplied by the application.  See
+ * xQueueCreatePriority() for how the queue behaves.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain,
+ * across all levels.  At most 65534.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * At most 65535.
+ *
+ * @param uxPriorityLevels The number of priorities.  From 1 to 32.
+ *
+ * @param pucQueueStorage Must point to an array of at least
+ * PRIORITY_QUEUE_BUFFER_SIZE( uxQueueLength, uxItemSize, uxPriorityLevels )
+ * bytes, aligned to at least 2 bytes.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  If pucQueueStorage or pxQueueBuffer is NULL then NULL is
+ * returned.
+ * \defgroup xQueueCreatePriorityStatic xQueueCreatePriorityStatic
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueCreatePriorityStatic( const UBaseType_t uxQueueLength,
+                                              const UBaseType_t uxItemSize,
+                                              const UBaseType_t uxPriorityLevels,
+                                              uint8_t * pucQueueStorage,
+                                              StaticQueue_t * pxQueueBuffer );
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateBroadcast(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            uint8_t ucPolicy
+ *                        );
+ * @endcode
+ *
+ * Creates a broadcast queue, which delivers every item sent to it to every
+ * subscriber.  Tasks subscribe with xQueueSubscribe() and receive from the
+ * handle it returns with xQueueReceive(), xQueuePeek() and their FromISR
+ * versions, each at its own pace.  The items are held once, in a ring shared
+ * by all subscribers, and each subscriber only keeps a read position, so
+ * fanning one stream out to many consumers costs one copy per send instead
+ * of one queue and one copy per consumer.
+ *
+ * A subscriber only receives the items sent after it subscribed.  Items sent
+ * while there are no subscribers are discarded.  The queue is full when the
+ * slowest subscriber has uxQueueLength items left to read; ucPolicy then
+ * decides what a send does:
+ *
+ * queueBROADCAST_BLOCK - the sender waits, up to its block time, until the
+ * slowest subscriber has read an item.
+ *
+ * queueBROADCAST_DROP_NEWEST - the send fails at once and the item is lost,
+ * so a stalled subscriber never holds the producer up.
+ *
+ * queueBROADCAST_DROP_OLDEST - the send succeeds and the subscribers that are
+ * that far behind lose their oldest item.
+ *
+ * Send with xQueueSend(), xQueueSendToBack(), xQueueSendMultiple() or their
+ * FromISR versions.  xQueueSendToFront() sends to the back.  The broadcast
+ * queue itself cannot be received from, and neither it nor its subscribers
+ * can be added to a queue set.  uxQueueMessagesWaiting() on the broadcast
+ * queue returns the number of items the slowest subscriber has left to read.
+ *
+ * Deleting the broadcast queue unblocks the subscribers' readers with an
+ * error, and later receives fail.  The subscriber handles must still be
+ * deleted with vQueueDelete().
+ *
+ * @param uxQueueLength The number of items the shared ring can hold.  At most
+ * 65535.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * At most 65535.
+ *
+ * @param ucPolicy What a send does when the queue is full, one of
+ * queueBROADCAST_BLOCK, queueBROADCAST_DROP_NEWEST and
+ * queueBROADCAST_DROP_OLDEST.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+ * @code{c}
+ * QueueHandle_t xSensorFeed;
+ *
+ * void vSetup( void )
+ * {
+ *  xSensorFeed = xQueueCreateBroadcast( 8, sizeof( struct xSample ), queueBROADCAST_DROP_OLDEST );
+ * }
+ *
+ * void vLoggerTask( void *pvParameters )
+ * {
+ * QueueHandle_t xFeed = xQueueSubscribe( xSensorFeed );
+ * struct xSample xSample;
+ *
+ *  for( ;; )
+ *  {
+ *      // Receives every sample, independently of the other subscribers.
+ *      xQueueReceive( xFeed, &xSample, portMAX_DELAY );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueCreateBroadcast xQueueCreateBroadcast
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueCreateBroadcast( const UBaseType_t uxQueueLength,
+                                         const UBaseType_t uxItemSize,
+                                         const uint8_t ucPolicy );
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateBroadcastStatic(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            uint8_t ucPolicy,
+ *                            uint8_t *pucQueueStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Creates a broadcast queue using memory supplied by the application.  See
+ * xQueueCreateBroadcast() for how the queue behaves.
+ *
+ * @param uxQueueLength The number of items the shared ring can hold.  At most
+ * 65535.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * At most 65535.
+ *
+ * @param ucPolicy What a send does when the queue is full.
+ *
+ * @param pucQueueStorage Must point to an array of at least
+ * ( uxQueueLength * uxItemSize ) bytes.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  If pucQueueStorage or pxQueueBuffer is NULL then NULL is
+ * returned.
+ * \defgroup xQueueCreateBroadcastStatic xQueueCreateBroadcastStatic
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueCreateBroadcastStatic( const UBaseType_t uxQueueLength,
+                                               const UBaseType_t uxItemSize,
+                                               const uint8_t ucPolicy,
+                                               uint8_t * pucQueueStorage,
+                                               StaticQueue_t * pxQueueBuffer );
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueSubscribe( QueueHandle_t xBroadcastQueue );
+ * @endcode
+ *
+ * Subscribes to a queue created by xQueueCreateBroadcast() or
+ * xQueueCreateBroadcastStatic().  The returned handle receives every item
+ * sent to xBroadcastQueue from now on, and blocks independently of the other
+ * subscribers.  It cannot be sent to.  xQueueReset() on it skips the items
+ * not read yet.  Delete it with vQueueDelete() to unsubscribe, which may let
+ * a blocked sender continue.
+ *
+ * @param xBroadcastQueue The broadcast queue to subscribe to.
+ *
+ * @return A handle to the subscriber, or 0 if it could not be allocated.
+ * \defgroup xQueueSubscribe xQueueSubscribe
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueSubscribe( QueueHandle_t xBroadcastQueue );
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueSubscribeStatic(
+ *                            QueueHandle_t xBroadcastQueue,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Subscribes to a broadcast queue using memory supplied by the application.
+ * See xQueueSubscribe().
+ *
+ * @param xBroadcastQueue The broadcast queue to subscribe to.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the subscriber's data structure.
+ *
+ * @return A handle to the subscriber, or NULL if pxQueueBuffer is NULL.
+ * \defgroup xQueueSubscribeStatic xQueueSubscribeStatic
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueSubscribeStatic( QueueHandle_t xBroadcastQueue,
+                                         StaticQueue_t * pxQueueBuffer );
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -466,6 +951,131 @@ typedef struct QueueDefinition   * QueueHandle_t;
 #define xQueueSend( xQueue, pvItemToQueue, xTicksToWait ) \
     xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), queueSEND_TO_BACK )
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueOverwrite(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue
+ *                       );
+ * @endcode
+ *
+ * Only for use with queues that have a length of one - so the queue is either
+ * empty or full.
+ *
+ * Post an item on a queue.  If the queue is already full then overwrite the
+ * value held in the queue.  The item is queued by copy, not by reference.
+ *
+ * Works with mailboxes created by xQueueCreateMailbox() and with any queue
+ * created by xQueueCreate() or xQueueCreateStatic() with a length of one.
+ * Mailboxes are the faster choice for publishing a latest value to many
+ * readers, as xQueuePeek() on a mailbox never masks interrupts.
+ *
+ * This function must not be called from an interrupt service routine.
+ * See xQueueOverwriteFromISR () for an alternative which may be used
+ * in an ISR.
+ *
+ * @param xQueue The handle of the queue to which the data is being sent.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.  The size of the items the queue will hold was defined when the
+ * queue was created, so this many bytes will be copied from pvItemToQueue
+ * into the queue storage area.
+ *
+ * @return xQueueOverwrite() is a macro that calls xQueueGenericSend(), and
+ * therefore has the same return values as xQueueSendToFront().  However, pdPASS
+ * is the only value that can be returned because xQueueOverwrite() will write
+ * to the queue even when the queue is already full.
+ *
+ * Example usage:
+ * @code{c}
+ *
+ * void vFunction( void *pvParameters )
+ * {
+ * QueueHandle_t xQueue;
+ * uint32_t ulVarToSend, ulValReceived;
+ *
+ *  // Create a mailbox to hold one uint32_t value.
+ *  xQueue = xQueueCreateMailbox( sizeof( uint32_t ) );
+ *
+ *  // Write the value 10 to the mailbox using xQueueOverwrite().
+ *  ulVarToSend = 10;
+ *  xQueueOverwrite( xQueue, &ulVarToSend );
+ *
+ *  // Peeking the mailbox should now return 10, but leave the value 10 in
+ *  // the mailbox.  A block time of zero is used as it is known that the
+ *  // mailbox holds a value.
+ *  ulValReceived = 0;
+ *  xQueuePeek( xQueue, &ulValReceived, 0 );
+ *
+ *  if( ulValReceived != 10 )
+ *  {
+ *      // Error unless the item was removed by a different task.
+ *  }
+ *
+ *  // The mailbox is still full.  Use xQueueOverwrite() to overwrite the
+ *  // value held in the mailbox with 100.
+ *  ulVarToSend = 100;
+ *  xQueueOverwrite( xQueue, &ulVarToSend );
+ *
+ *  // This time read from the mailbox, leaving it empty once more.
+ *  // A block time of 0 is used again.
+ *  xQueueReceive( xQueue, &ulValReceived, 0 );
+ *
+ *  // The value read should be the last value written, even though the
+ *  // mailbox was already full when the value was written.
+ *  if( ulValReceived != 100 )
+ *  {
+ *      // Error!
+ *  }
+ *
+ *  // ...
+ * }
+ * @endcode
+ * \defgroup xQueueOverwrite xQueueOverwrite
+ * \ingroup QueueManagement
+ */
+#define xQueueOverwrite( xQueue, pvItemToQueue ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendWithPriority(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue,
+ *                            UBaseType_t uxPriority,
+ *                            TickType_t xTicksToWait
+ *                        );
+ * @endcode
+ *
+ * This is a macro that calls xQueueGenericSend().
+ *
+ * Post an item with a priority on a queue created by xQueueCreatePriority().
+ * The item is received after the items already queued with the same or a
+ * higher priority, and before all items with a lower one.  Other kinds of
+ * queue ignore the priority and post the item to the back.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param uxPriority The priority of the item, from 0 to one less than the
+ * number of levels the queue was created with.  Higher values are received
+ * first.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.
+ *
+ * @return pdTRUE if the item was successfully posted, otherwise errQUEUE_FULL.
+ * \defgroup xQueueSendWithPriority xQueueSendWithPriority
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithPriority( xQueue, pvItemToQueue, uxPriority, xTicksToWait ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), queueSEND_WITH_PRIORITY( uxPriority ) )
+
 /**
  * queue. h
  * @code{c}
@@ -556,6 +1166,145 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                               TickType_t xTicksToWait,
                               const BaseType_t xCopyPosition );
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueuePeek(
+ *                           QueueHandle_t xQueue,
+ *                           void * const pvBuffer,
+ *                           TickType_t xTicksToWait
+ *                       );
+ * @endcode
+ *
+ * Receive an item from a queue without removing the item from the queue.
+ * The item is received by copy so a buffer of adequate size must be
+ * provided.  The number of bytes copied into the buffer was defined when
+ * the queue was created.
+ *
+ * Successfully received items remain on the queue so will be returned again
+ * by the next call, or a call to xQueueReceive().  The item is copied once,
+ * straight out of the queue storage, and the order of the queue is never
+ * changed.
+ *
+ * Any number of tasks can block in xQueuePeek().  When an item arrives they
+ * are unblocked one after another in priority order, each one passing the
+ * wake up on before returning, so a task blocked in xQueueReceive() behind
+ * them still gets the item.
+ *
+ * This macro must not be used in an interrupt service routine.  See
+ * xQueuePeekFromISR() for an alternative that can be called from an interrupt
+ * service routine.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received item will
+ * be copied.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time
+ * of the call.  The time is defined in tick periods so the constant
+ * portTICK_PERIOD_MS should be used to convert to real time if this is required.
+ * xQueuePeek() will return immediately if xTicksToWait is 0 and the queue
+ * is empty.
+ *
+ * @return pdTRUE if an item was successfully received from the queue,
+ * otherwise pdFALSE.
+ *
+ * Example usage:
+ * @code{c}
+ * struct AMessage
+ * {
+ *  char ucMessageID;
+ *  char ucData[ 20 ];
+ * } xMessage;
+ *
+ * QueueHandle_t xQueue;
+ *
+ * // Task to create a queue and post a value.
+ * void vATask( void *pvParameters )
+ * {
+ * struct AMessage *pxMessage;
+ *
+ *  // Create a queue capable of containing 10 pointers to AMessage structures.
+ *  // These should be passed by pointer as they contain a lot of data.
+ *  xQueue = xQueueCreate( 10, sizeof( struct AMessage * ) );
+ *  if( xQueue == 0 )
+ *  {
+ *      // Failed to create the queue.
+ *  }
+ *
+ *  // ...
+ *
+ *  // Send a pointer to a struct AMessage object.  Don't block if the
+ *  // queue is already full.
+ *  pxMessage = & xMessage;
+ *  xQueueSend( xQueue, ( void * ) &pxMessage, ( TickType_t ) 0 );
+ *
+ *  // ... Rest of task code.
+ * }
+ *
+ * // Task to peek the data from the queue.
+ * void vADifferentTask( void *pvParameters )
+ * {
+ * struct AMessage *pxRxedMessage;
+ *
+ *  if( xQueue != 0 )
+ *  {
+ *      // Peek a message on the created queue.  Block for 10 ticks if a
+ *      // message is not immediately available.
+ *      if( xQueuePeek( xQueue, &( pxRxedMessage ), ( TickType_t ) 10 ) )
+ *      {
+ *          // pcRxedMessage now points to the struct AMessage variable posted
+ *          // by vATask, but the item still remains on the queue.
+ *      }
+ *  }
+ *
+ *  // ... Rest of task code.
+ * }
+ * @endcode
+ * \defgroup xQueuePeek xQueuePeek
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueuePeek( QueueHandle_t xQueue,
+                       void * const pvBuffer,
+                       TickType_t xTicksToWait );
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueuePeekFromISR(
+ *                                  QueueHandle_t xQueue,
+ *                                  void *pvBuffer,
+ *                              );
+ * @endcode
+ *
+ * A version of xQueuePeek() that can be called from an interrupt service
+ * routine (ISR).
+ *
+ * Receive an item from a queue without removing the item from the queue.
+ * The item is received by copy so a buffer of adequate size must be
+ * provided.  The number of bytes copied into the buffer was defined when
+ * the queue was created.
+ *
+ * Successfully received items remain on the queue so will be returned again
+ * by the next call, or a call to xQueueReceive().
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received item will
+ * be copied.
+ *
+ * @return pdTRUE if an item was successfully received from the queue,
+ * otherwise pdFALSE.
+ *
+ * \defgroup xQueuePeekFromISR xQueuePeekFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
+                              void * const pvBuffer );
+
 /**
  * queue. h
  * @code{c}
@@ -914,11 +1663,113 @@ void vQueueDelete( QueueHandle_t xQueue );
  * }
  * @endcode
  *
- * \defgroup xQueueSendFromISR xQueueSendFromISR
+ * \defgroup xQueueSendFromISR xQueueSendFromISR
+ * \ingroup QueueManagement
+ */
+#define xQueueSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_TO_BACK )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueOverwriteFromISR(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue,
+ *                            BaseType_t *pxHigherPriorityTaskWoken
+ *                       );
+ * @endcode
+ *
+ * A version of xQueueOverwrite() that can be used in an interrupt service
+ * routine (ISR).
+ *
+ * Only for use with queues that can hold a single item - so the queue is either
+ * empty or full.
+ *
+ * Post an item on a queue.  If the queue is already full then overwrite the
+ * value held in the queue.  The item is queued by copy, not by reference.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.  The size of the items the queue will hold was defined when the
+ * queue was created, so this many bytes will be copied from pvItemToQueue
+ * into the queue storage area.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueOverwriteFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending to the queue caused a task
+ * to unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If xQueueOverwriteFromISR() sets this value to pdTRUE then
+ * a context switch should be requested before the interrupt is exited.
+ *
+ * @return xQueueOverwriteFromISR() is a macro that calls
+ * xQueueGenericSendFromISR(), and therefore has the same return values as
+ * xQueueSendToFrontFromISR().  However, pdPASS is the only value that can be
+ * returned because xQueueOverwriteFromISR() will write to the queue even when
+ * the queue is already full.
+ *
+ * Example usage:
+ * @code{c}
+ *
+ * QueueHandle_t xQueue;
+ *
+ * void vFunction( void *pvParameters )
+ * {
+ *  // Create a mailbox to hold one uint32_t value.
+ *  xQueue = xQueueCreateMailbox( sizeof( uint32_t ) );
+ * }
+ *
+ * void vAnInterruptHandler( void )
+ * {
+ * uint32_t ulVarToSend;
+ *
+ *  // Write the latest reading to the mailbox.  Readers that peek it never
+ *  // mask interrupts, so this ISR is never delayed by them.
+ *  ulVarToSend = ulReadBatteryLevel();
+ *  xQueueOverwriteFromISR( xQueue, &ulVarToSend, NULL );
+ * }
+ * @endcode
+ * \defgroup xQueueOverwriteFromISR xQueueOverwriteFromISR
+ * \ingroup QueueManagement
+ */
+#define xQueueOverwriteFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueOVERWRITE )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendWithPriorityFromISR(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue,
+ *                            UBaseType_t uxPriority,
+ *                            BaseType_t *pxHigherPriorityTaskWoken
+ *                        );
+ * @endcode
+ *
+ * This is a macro that calls xQueueGenericSendFromISR().
+ *
+ * A version of xQueueSendWithPriority() that can be used in an interrupt
+ * service routine.  It never blocks.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param uxPriority The priority of the item, from 0 to one less than the
+ * number of levels the queue was created with.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueSendWithPriorityFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending to the queue caused a task
+ * to unblock, and the unblocked task has a priority higher than the currently
+ * running task.
+ *
+ * @return pdTRUE if the data was successfully sent to the queue, otherwise
+ * errQUEUE_FULL.
+ * \defgroup xQueueSendWithPriorityFromISR xQueueSendWithPriorityFromISR
  * \ingroup QueueManagement
  */
-#define xQueueSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
-    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_TO_BACK )
+#define xQueueSendWithPriorityFromISR( xQueue, pvItemToQueue, uxPriority, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_WITH_PRIORITY( uxPriority ) )
 
 /**
  * queue. h
@@ -1095,6 +1946,316 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendMultiple(
+ *                                 QueueHandle_t xQueue,
+ *                                 const void * pvItems,
+ *                                 UBaseType_t uxItemCount,
+ *                                 TickType_t xTicksToWait
+ *                               );
+ * @endcode
+ *
+ * Post up to uxItemCount items to the back of a queue in one call.  The items
+ * are read from an array of uxItemCount items, each the size defined when the
+ * queue was created.
+ *
+ * The call blocks until the first item can be queued, then queues as many of
+ * the remaining items as fit without blocking again.  All items are moved in a
+ * single critical section, and tasks waiting to receive are woken with a
+ * single reschedule for the whole batch.  Items are never reordered: if only
+ * some of them fit, the first ones are queued.
+ *
+ * A mailbox holds a single item, so at most one item is posted to it.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to the array of items to be placed on the queue.
+ *
+ * @param uxItemCount The number of items in the array.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space on the queue, should it already be full.  The call will
+ * return immediately if this is set to 0 and the queue is full.
+ *
+ * @return The number of items posted, from 0 (the queue stayed full for
+ * xTicksToWait) to uxItemCount.
+ *
+ * Example usage:
+ * @code{c}
+ * uint16_t usSamples[ 32 ];
+ * UBaseType_t uxSent = 0;
+ *
+ * // Keep posting until the whole block has been queued.
+ * while( uxSent < 32 )
+ * {
+ *  uxSent += xQueueSendMultiple( xQueue, &( usSamples[ uxSent ] ), 32 - uxSent, portMAX_DELAY );
+ * }
+ * @endcode
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                const void * pvItems,
+                                UBaseType_t uxItemCount,
+                                TickType_t xTicksToWait );
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueSendMultipleFromISR(
+ *                                        QueueHandle_t xQueue,
+ *                                        const void * pvItems,
+ *                                        UBaseType_t uxItemCount,
+ *                                        BaseType_t *pxHigherPriorityTaskWoken
+ *                                      );
+ * @endcode
+ *
+ * A version of xQueueSendMultiple() that can be called from an interrupt
+ * service routine.  It never blocks: it posts as many items as currently fit
+ * and returns how many that was.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                       const void * pvItems,
+                                       UBaseType_t uxItemCount,
+                                       BaseType_t * const pxHigherPriorityTaskWoken );
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveMultiple(
+ *                                    QueueHandle_t xQueue,
+ *                                    void * pvBuffer,
+ *                                    UBaseType_t uxMaxItems,
+ *                                    TickType_t xTicksToWait
+ *                                  );
+ * @endcode
+ *
+ * Receive up to uxMaxItems items from a queue in one call.  The items are
+ * copied, in queue order, into an array that must have room for uxMaxItems
+ * items.
+ *
+ * The call blocks until the first item is available, then takes as many of
+ * the queued items as the buffer holds without blocking again.  All items are
+ * moved in a single critical section, and tasks waiting for space are woken
+ * with a single reschedule for the whole batch.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the array into which the received items will be
+ * copied.
+ *
+ * @param uxMaxItems The number of items the array can hold.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.  The call will return immediately if this is set to 0 and the queue is
+ * empty.
+ *
+ * @return The number of items received, from 0 (the queue stayed empty for
+ * xTicksToWait) to uxMaxItems.
+ *
+ * Example usage:
+ * @code{c}
+ * struct LogRecord xRecords[ 16 ];
+ * UBaseType_t uxCount, ux;
+ *
+ * for( ;; )
+ * {
+ *  // Wait for at least one record, then drain up to 16 at once.
+ *  uxCount = xQueueReceiveMultiple( xLogQueue, xRecords, 16, portMAX_DELAY );
+ *  for( ux = 0; ux < uxCount; ux++ )
+ *  {
+ *      vWriteRecord( &( xRecords[ ux ] ) );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                   void * pvBuffer,
+                                   UBaseType_t uxMaxItems,
+                                   TickType_t xTicksToWait );
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t xQueueReceiveMultipleFromISR(
+ *                                           QueueHandle_t xQueue,
+ *                                           void * pvBuffer,
+ *                                           UBaseType_t uxMaxItems,
+ *                                           BaseType_t *pxHigherPriorityTaskWoken
+ *                                         );
+ * @endcode
+ *
+ * A version of xQueueReceiveMultiple() that can be called from an interrupt
+ * service routine.  It never blocks: it takes as many items as are queued, up
+ * to uxMaxItems, and returns how many that was.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                          void * pvBuffer,
+                                          UBaseType_t uxMaxItems,
+                                          BaseType_t * const pxHigherPriorityTaskWoken );
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueAcquireSendSlot(
+ *                                   QueueHandle_t xQueue,
+ *                                   void **ppvSlot,
+ *                                   TickType_t xTicksToWait
+ *                                 );
+ * @endcode
+ *
+ * Reserve a free slot in a queue so the item can be written in place rather
+ * than copied in by xQueueSend().  The slot holds exactly the item size given
+ * when the queue was created.  Once filled it must be handed to the queue with
+ * xQueueCommitSend(), which makes it visible to receivers in FIFO order.
+ *
+ * Works with queues created by xQueueCreate() and xQueueCreateStatic().  A
+ * held slot, sent or received, is not counted by uxQueueSpacesAvailable(),
+ * and the queue must not be reset with xQueueReset() until it is returned.
+ *
+ * @param xQueue The handle to the queue to reserve a slot in.
+ *
+ * @param ppvSlot Set to the address of the reserved slot on success.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot to become free should the queue be full.
+ *
+ * @return pdPASS if a slot was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * void vProducer( QueueHandle_t xQueue )
+ * {
+ * struct Frame *pxFrame;
+ *
+ *  if( xQueueAcquireSendSlot( xQueue, ( void ** ) &pxFrame, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      vFillFrame( pxFrame );
+ *      xQueueCommitSend( xQueue, pxFrame );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueAcquireSendSlot xQueueAcquireSendSlot
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueAcquireSendSlot( QueueHandle_t xQueue,
+                                  void ** ppvSlot,
+                                  TickType_t xTicksToWait );
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommitSend( QueueHandle_t xQueue, void *pvSlot );
+ * @endcode
+ *
+ * Post a slot obtained from xQueueAcquireSendSlot() to the back of the queue,
+ * waking a task that is blocked waiting to receive.
+ *
+ * @param xQueue The handle of the queue the slot was acquired from.
+ *
+ * @param pvSlot The slot returned by xQueueAcquireSendSlot().
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueCommitSend xQueueCommitSend
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueCommitSend( QueueHandle_t xQueue,
+                             void * pvSlot );
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueAcquireReceiveSlot(
+ *                                      QueueHandle_t xQueue,
+ *                                      void **ppvSlot,
+ *                                      TickType_t xTicksToWait
+ *                                    );
+ * @endcode
+ *
+ * Remove the item at the front of a queue without copying it out.  On success
+ * *ppvSlot points at the item inside the queue storage.  The item stays valid
+ * until the slot is returned to the queue with xQueueReleaseReceiveSlot(),
+ * which must be done before the slot can be reused by a sender.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * received.
+ *
+ * @param ppvSlot Set to the address of the received item on success.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item should the queue be empty.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * Example usage:
+ * @code{c}
+ * void vConsumer( QueueHandle_t xQueue )
+ * {
+ * struct Frame *pxFrame;
+ *
+ *  if( xQueueAcquireReceiveSlot( xQueue, ( void ** ) &pxFrame, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      vProcessFrame( pxFrame );
+ *      xQueueReleaseReceiveSlot( xQueue, pxFrame );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueAcquireReceiveSlot xQueueAcquireReceiveSlot
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueAcquireReceiveSlot( QueueHandle_t xQueue,
+                                     void ** ppvSlot,
+                                     TickType_t xTicksToWait );
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReleaseReceiveSlot( QueueHandle_t xQueue, void *pvSlot );
+ * @endcode
+ *
+ * Return a slot obtained from xQueueAcquireReceiveSlot() to the queue's free
+ * space, waking a task that is blocked waiting to send.
+ *
+ * @param xQueue The handle of the queue the slot was acquired from.
+ *
+ * @param pvSlot The slot returned by xQueueAcquireReceiveSlot().
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueReleaseReceiveSlot xQueueReleaseReceiveSlot
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReleaseReceiveSlot( QueueHandle_t xQueue,
+                                     void * pvSlot );
+
+/*
+ * Versions of the zero-copy functions that can be used from an interrupt
+ * service routine.  The acquire functions never block.
+ */
+BaseType_t xQueueAcquireSendSlotFromISR( QueueHandle_t xQueue,
+                                         void ** ppvSlot );
+BaseType_t xQueueCommitSendFromISR( QueueHandle_t xQueue,
+                                    void * pvSlot,
+                                    BaseType_t * const pxHigherPriorityTaskWoken );
+BaseType_t xQueueAcquireReceiveSlotFromISR( QueueHandle_t xQueue,
+                                            void ** ppvSlot );
+BaseType_t xQueueReleaseReceiveSlotFromISR( QueueHandle_t xQueue,
+                                            void * pvSlot,
+                                            BaseType_t * const pxHigherPriorityTaskWoken );
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -1105,8 +2266,8 @@ UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue );
 
 /*
  * For internal use only.  Use xSemaphoreCreateMutex(),
- * xSemaphoreCreateCounting() or xSemaphoreGetMutexHolder() instead of calling
- * these functions directly.
+ * xSemaphoreCreateCounting(), xSemaphoreGetMutexHolder(), xSemaphoreTakeRead()
+ * or xSemaphoreTakeWrite() instead of calling these functions directly.
  */
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType );
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
@@ -1118,6 +2279,9 @@ QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
                                                    StaticQueue_t * pxStaticQueue );
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                                 TickType_t xTicksToWait );
+BaseType_t xQueueTakeRWLock( QueueHandle_t xRWLock,
+                             TickType_t xTicksToWait,
+                             BaseType_t xWrite );
 TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore );
 TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore );
 
@@ -1129,6 +2293,305 @@ BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex,
                                      TickType_t xTicksToWait );
 BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex );
 
+/*
+ * The registry is provided as a means for kernel aware debuggers to
+ * locate queues, semaphores and mutexes.  Call vQueueAddToRegistry() add
+ * a queue, semaphore or mutex handle to the registry if you want the handle
+ * to be available to a kernel aware debugger.  If you are not using a kernel
+ * aware debugger then this function can be ignored.
+ *
+ * configQUEUE_REGISTRY_SIZE defines the maximum number of handles the
+ * registry can hold.  configQUEUE_REGISTRY_SIZE must be greater than 0
+ * within FreeRTOSConfig.h for the registry to be available.  Its value
+ * does not effect the number of queues, semaphores and mutexes that can be
+ * created - just the number that the registry can hold.
+ *
+ * If vQueueAddToRegistry is called more than once with the same xQueue
+ * parameter, the registry will store the pcQueueName parameter from the
+ * most recent call to vQueueAddToRegistry.
+ *
+ * @param xQueue The handle of the queue being added to the registry.  This
+ * is the handle returned by a call to xQueueCreate().  Semaphore and mutex
+ * handles can also be passed in here.
+ *
+ * @param pcQueueName The name to be associated with the handle.  This is the
+ * name that the kernel aware debugger will display.  The queue registry only
+ * stores a pointer to the string - so the string must be persistent (global or
+ * preferably in ROM/Flash), not on the stack.
+ */
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+    void vQueueAddToRegistry( QueueHandle_t xQueue,
+                              const char * pcQueueName );
+#endif
+
+/*
+ * The registry is provided as a means for kernel aware debuggers to
+ * locate queues, semaphores and mutexes.  Call vQueueAddToRegistry() add
+ * a queue, semaphore or mutex handle to the registry if you want the handle
+ * to be available to a kernel aware debugger, and vQueueUnregisterQueue() to
+ * remove the queue, semaphore or mutex from the register.  If you are not using
+ * a kernel aware debugger then this function can be ignored.
+ *
+ * vQueueDelete() removes a queue from the registry itself.
+ *
+ * @param xQueue The handle of the queue being removed from the registry.
+ */
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+    void vQueueUnregisterQueue( QueueHandle_t xQueue );
+#endif
+
+/*
+ * The queue registry is provided as a means for kernel aware debuggers to
+ * locate queues, semaphores and mutexes.  Call pcQueueGetName() to look
+ * up and return the name of a queue in the queue registry from the queue's
+ * handle.
+ *
+ * @param xQueue The handle of the queue the name of which will be returned.
+ * @return If the queue is in the registry then a pointer to the name of the
+ * queue is returned.  If the queue is not in the registry then NULL is
+ * returned.
+ */
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+    const char * pcQueueGetName( QueueHandle_t xQueue );
+#endif
+
+/*
+ * Look up the handle of a queue, semaphore or mutex in the queue registry
+ * from the name it was registered with.  The name is looked up in a hash
+ * index if configUSE_NAME_INDEX is 1, else the registry is searched.
+ *
+ * @param pcQueueName The name the queue was registered with.
+ * @return The handle of the queue, or NULL if no queue in the registry has
+ * the name.  If several queues share the name, any of them may be returned.
+ */
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+    QueueHandle_t xQueueGetHandle( const char * pcQueueName );
+#endif
+
+/*
+ * Copy the counters kept for a queue, semaphore or mutex when
+ * configUSE_QUEUE_STATISTICS is 1.  See QueueStatistics_t in FreeRTOS.h.
+ *
+ * When the registry is also enabled, the queue_stats msh command lists the
+ * counters of every registered queue, most contended first.
+ *
+ * @param xQueue The handle of the queue, semaphore or mutex.
+ *
+ * @param pxStatistics The structure the counters are copied to.
+ */
+#if ( configUSE_QUEUE_STATISTICS == 1 )
+    void vQueueGetStatistics( QueueHandle_t xQueue,
+                              QueueStatistics_t * pxStatistics );
+#endif
+
+#if ( configUSE_QUEUE_WATERMARKS == 1 )
+
+/*
+ * Type of the function called when a queue crosses one of its watermarks.
+ * xAboveHighMark is pdTRUE when the queue has just reached its high mark and
+ * pdFALSE when it has just drained back to its low mark.
+ */
+    typedef void ( * QueueWatermarkCallback_t )( QueueHandle_t xQueue,
+                                                 BaseType_t xAboveHighMark,
+                                                 void * pvContext );
+
+/* Notification bits set by xQueueSetWatermarkNotify(). */
+    #define queueWATERMARK_HIGH_BIT    ( ( uint32_t ) 0x80000000UL )
+    #define queueWATERMARK_LOW_BIT     ( ( uint32_t ) 0x40000000UL )
+
+#endif
+
+/*
+ * Report when a queue is filling up, before sends start to fail or block, so
+ * that producers can throttle or shed load early.  pxCallback is called once
+ * when the queue reaches uxHighMark items, and again when it has drained back
+ * to uxLowMark items, and so on.  Keeping the low mark well below the high
+ * mark stops a queue that hovers around one mark from reporting every item.
+ *
+ * The marks are checked after every send, receive and reset of the queue,
+ * and when they are set, so a queue that is already full enough is reported
+ * at once.  The callback runs in the context of the call that crossed the
+ * mark, which may be an interrupt, so it must not block.  It is called
+ * without interrupts disabled.
+ *
+ * Watermarks cannot be set on a mutex, on a broadcast queue or on a
+ * subscriber.  configUSE_QUEUE_WATERMARKS must be set to 1.
+ *
+ * @param xQueue The handle of the queue or semaphore.
+ *
+ * @param uxHighMark The number of items at which the queue is reported as
+ * congested.
+ *
+ * @param uxLowMark The number of items at which the queue is reported as
+ * drained.  Must be below uxHighMark.
+ *
+ * @param pxCallback The function to call, or NULL to stop reporting.
+ *
+ * @param pvContext Passed to pxCallback.
+ *
+ * @return pdPASS if the watermarks were set, or pdFAIL if uxLowMark is not
+ * below uxHighMark.
+ */
+#if ( configUSE_QUEUE_WATERMARKS == 1 )
+    BaseType_t xQueueSetWatermarks( QueueHandle_t xQueue,
+                                    UBaseType_t uxHighMark,
+                                    UBaseType_t uxLowMark,
+                                    QueueWatermarkCallback_t pxCallback,
+                                    void * pvContext );
+#endif
+
+/*
+ * As xQueueSetWatermarks(), but notifies a task instead of calling a function.
+ * The task's notification value gets queueWATERMARK_HIGH_BIT set when the
+ * queue reaches uxHighMark items, and queueWATERMARK_LOW_BIT when it has
+ * drained back to uxLowMark, as with xTaskNotify( xTaskToNotify, ulBit,
+ * eSetBits ).  Clear the bits with xTaskNotifyWait() to see each crossing.
+ *
+ * @param xQueue The handle of the queue or semaphore.
+ *
+ * @param uxHighMark The number of items at which the queue is reported as
+ * congested.
+ *
+ * @param uxLowMark The number of items at which the queue is reported as
+ * drained.  Must be below uxHighMark.
+ *
+ * @param xTaskToNotify The task to notify.
+ *
+ * @return pdPASS if the watermarks were set, or pdFAIL if uxLowMark is not
+ * below uxHighMark.
+ */
+#if ( configUSE_QUEUE_WATERMARKS == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 1 )
+    BaseType_t xQueueSetWatermarkNotify( QueueHandle_t xQueue,
+                                         UBaseType_t uxHighMark,
+                                         UBaseType_t uxLowMark,
+                                         TaskHandle_t xTaskToNotify );
+#endif
+
+/*
+ * Copy the profile kept for a mutex when configUSE_MUTEX_PROFILING is 1.  See
+ * MutexProfile_t in FreeRTOS.h.  Every take and give of a mutex through
+ * xSemaphoreTake(), xSemaphoreGive() and their recursive forms is timed with
+ * configMUTEX_PROFILING_CLOCK().  The mutex_stats msh command lists the
+ * mutexes waited for longest, and shows the histograms of one mutex given its
+ * name.  Use vSemaphoreGetMutexProfile() rather than calling this directly.
+ *
+ * @param xMutex The handle of the mutex.
+ *
+ * @param pxProfile The structure the profile is copied to.
+ */
+#if ( configUSE_MUTEX_PROFILING == 1 )
+    void vQueueGetMutexProfile( QueueHandle_t xMutex,
+                                MutexProfile_t * pxProfile );
+#endif
+
+/*
+ * Clear the profile of a mutex, for example at the start of a measurement.
+ * Use vSemaphoreResetMutexProfile() rather than calling this directly.
+ */
+#if ( configUSE_MUTEX_PROFILING == 1 )
+    void vQueueResetMutexProfile( QueueHandle_t xMutex );
+#endif
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+/*
+ * Queue sets provide a mechanism to allow a task to block (pend) on a read
+ * operation from multiple queues or semaphores simultaneously.
+ *
+ * A queue set is itself a queue of member handles.  Each successful send to a
+ * member, or give of a member semaphore, posts that member's handle to the set
+ * it belongs to, so a task blocked in xQueueSelectFromSet() waits on a single
+ * object however many members the set has.
+ *
+ * Note 1:  Call xQueueSelectFromSet() to get the handle of a member that
+ * contains data, then read the member with xQueueReceive() or take it with
+ * xSemaphoreTake() with a block time of 0.  Every handle returned must be read
+ * exactly once, otherwise the set and its members get out of step.
+ *
+ * Note 2:  A queue set must be long enough to hold an event for every item its
+ * members can hold at once.  A queue of length 5 and a binary semaphore need a
+ * set of length 6.  Mailboxes count as one, and overwriting a full mailbox does
+ * not post a new event.
+ *
+ * Note 3:  A mutex can be added to a set while it is held.  Its handle is
+ * posted to the set once it is given back and left without an owner.
+ *
+ * @param uxEventQueueLength The maximum number of events that can be queued
+ * at once, as described in Note 2.
+ *
+ * @return If the queue set is created successfully then a handle to the created
+ * queue set is returned.  Otherwise NULL is returned.
+ */
+    QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength );
+
+/*
+ * Adds a queue or semaphore to a queue set that was previously created by a
+ * call to xQueueCreateSet().
+ *
+ * A queue or semaphore can only be added to a set if it is empty, and can only
+ * belong to one set at a time.
+ *
+ * @param xQueueOrSemaphore The handle of the queue or semaphore being added to
+ * the queue set (cast to an QueueSetMemberHandle_t type).
+ *
+ * @param xQueueSet The handle of the queue set to which the queue or semaphore
+ * is being added.
+ *
+ * @return If the queue or semaphore was successfully added to the queue set
+ * then pdPASS is returned.  If the queue could not be successfully added to the
+ * queue set because it is already a member of a different queue set, or because
+ * it is not empty, then pdFAIL is returned.
+ */
+    BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                               QueueSetHandle_t xQueueSet );
+
+/*
+ * Removes a queue or semaphore from a queue set.  A queue or semaphore can only
+ * be removed from a set if the queue or semaphore is empty.
+ *
+ * @param xQueueOrSemaphore The handle of the queue or semaphore being removed
+ * from the queue set (cast to an QueueSetMemberHandle_t type).
+ *
+ * @param xQueueSet The handle of the queue set in which the queue or semaphore
+ * is included.
+ *
+ * @return If the queue or semaphore was successfully removed from the queue set
+ * then pdPASS is returned.  If the queue was not in the queue set, or the
+ * queue (or semaphore) was not empty, then pdFAIL is returned.
+ */
+    BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                                    QueueSetHandle_t xQueueSet );
+
+/*
+ * xQueueSelectFromSet() selects from the members of a queue set a queue or
+ * semaphore that either contains data (in the case of a queue) or is available
+ * to take (in the case of a semaphore).  xQueueSelectFromSet() effectively
+ * allows a task to block (pend) on a read operation on all the queues and
+ * semaphores in a queue set simultaneously.
+ *
+ * @param xQueueSet The queue set on which the task will (potentially) block.
+ *
+ * @param xTicksToWait The maximum time, in ticks, that the calling task will
+ * remain in the Blocked state (with other tasks executing) to wait for a member
+ * of the queue set to be ready for a successful queue read or semaphore take
+ * operation.
+ *
+ * @return xQueueSelectFromSet() will return the handle of a queue (cast to
+ * a QueueSetMemberHandle_t type) contained in the queue set that contains data,
+ * or the handle of a semaphore (cast to a QueueSetMemberHandle_t type) contained
+ * in the queue set that is available, or NULL if no such queue or semaphore
+ * exists before the specified block time expires.
+ */
+    QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
+                                                const TickType_t xTicksToWait );
+
+/*
+ * A version of xQueueSelectFromSet() that can be used from an ISR.
+ */
+    QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet );
+
+#endif /* configUSE_QUEUE_SETS */
+
 /*
  * Reset a queue back to its original empty state.  The return value is now
  * obsolete and is always set to pdPASS.
@@ -1163,10 +2626,8 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex );
 BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                                BaseType_t xNewQueue );
 
-#ifdef ESP_PLATFORM
+#if defined( ESP_PLATFORM ) && ( configUSE_QUEUE_SETS == 0 )
 /* Unimplemented */
-typedef struct QueueDefinition   * QueueSetHandle_t;
-typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength );
 BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
                            QueueSetHandle_t xQueueSet );
@@ -1175,11 +2636,6 @@ BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
 QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
                                             const TickType_t xTicksToWait );
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet );
-BaseType_t xQueuePeek( QueueHandle_t xQueue,
-                       void * const pvBuffer,
-                       TickType_t xTicksToWait );
-BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void * pvItemToQueue);
-BaseType_t xQueueOverwriteFromISR(QueueHandle_t xQueue, const void * pvItemToQueue, BaseType_t *pxHigherPriorityTaskWoken);
 #endif
 
 /* *INDENT-OFF* */
@@ -702,6 +702,10 @@ typedef QueueHandle_t SemaphoreHandle_t;
  *
  * Mutex type semaphores cannot be used from within interrupt service routines.
  *
+ * With configUSE_LEAN_MUTEXES set to 1 an uncontended take or give is a single
+ * compare-and-swap, and the kernel is only entered, with priority inheritance,
+ * when a task has to wait.
+ *
  * See xSemaphoreCreateBinary() for an alternative implementation that can be
  * used for pure synchronisation (where one task or interrupt always 'gives' the
  * semaphore and another always 'takes' the semaphore) and from within interrupt
@@ -942,6 +946,145 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateRecursiveMutexStatic( pxStaticSemaphore )    xQueueCreateMutexStatic( queueQUEUE_TYPE_RECURSIVE_MUTEX, ( StaticQueue_t * ) pxStaticSemaphore )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateRWLock( void );
+ * @endcode
+ *
+ * Creates a reader-writer lock, and returns a handle by which the lock can be
+ * referenced.  Any number of tasks can hold the lock for reading at the same
+ * time, with xSemaphoreTakeRead(), while a task that holds it for writing,
+ * with xSemaphoreTakeWrite(), holds it alone.  Use it instead of a mutex for
+ * data that many tasks read and few tasks change.
+ *
+ * Writers are preferred: once a writer is waiting, tasks that try to read
+ * wait behind it, so a steady stream of readers cannot starve writers.  A
+ * task waiting for a lock held for writing raises the writer to its own
+ * priority until the writer gives the lock, as with a mutex.  Readers do not
+ * inherit priority.
+ *
+ * The lock is not recursive: a task must not take it again, for reading or
+ * writing, while it holds it.  Reader-writer locks cannot be used from
+ * interrupts, and cannot be added to a queue set.
+ *
+ * @return If the lock was successfully created then a handle to the created
+ * lock is returned.  If there was not enough heap to allocate the lock data
+ * structure then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xRouteLock;
+ *
+ * void vReader( void * pvParameters )
+ * {
+ *  if( xSemaphoreTakeRead( xRouteLock, portMAX_DELAY ) == pdTRUE )
+ *  {
+ *      // Look up the route table.  Other readers may do so at the same time.
+ *      xSemaphoreGiveRWLock( xRouteLock );
+ *  }
+ * }
+ *
+ * void vWriter( void * pvParameters )
+ * {
+ *  if( xSemaphoreTakeWrite( xRouteLock, portMAX_DELAY ) == pdTRUE )
+ *  {
+ *      // Update the route table.  No reader or other writer holds the lock.
+ *      xSemaphoreGiveRWLock( xRouteLock );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateRWLock xSemaphoreCreateRWLock
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MUTEXES == 1 ) )
+    #define xSemaphoreCreateRWLock()    xQueueCreateMutex( queueQUEUE_TYPE_RWLOCK )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateRWLockStatic( StaticSemaphore_t *pxRWLockBuffer );
+ * @endcode
+ *
+ * As xSemaphoreCreateRWLock(), but the memory of the lock is provided by the
+ * application instead of being allocated dynamically.
+ *
+ * @param pxRWLockBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the lock's data structure.
+ *
+ * @return If the lock was successfully created then a handle to the created
+ * lock is returned.  If pxRWLockBuffer was NULL then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateRWLockStatic xSemaphoreCreateRWLockStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MUTEXES == 1 ) )
+    #define xSemaphoreCreateRWLockStatic( pxRWLockBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_RWLOCK, ( StaticQueue_t * ) ( pxRWLockBuffer ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreTakeRead( SemaphoreHandle_t xRWLock, TickType_t xBlockTime );
+ * @endcode
+ *
+ * Take a reader-writer lock for reading.  The lock is taken at once unless a
+ * task holds it for writing or is waiting to.
+ *
+ * @param xRWLock A handle to the lock, returned by xSemaphoreCreateRWLock().
+ *
+ * @param xBlockTime The time in ticks to wait for the lock.
+ *
+ * @return pdTRUE if the lock was taken, pdFALSE if xBlockTime expired first.
+ *
+ * \defgroup xSemaphoreTakeRead xSemaphoreTakeRead
+ * \ingroup Semaphores
+ */
+#define xSemaphoreTakeRead( xRWLock, xBlockTime )     xQueueTakeRWLock( ( xRWLock ), ( xBlockTime ), pdFALSE )
+
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreTakeWrite( SemaphoreHandle_t xRWLock, TickType_t xBlockTime );
+ * @endcode
+ *
+ * Take a reader-writer lock for writing.  The task waits until no other task
+ * holds the lock, for reading or writing, and readers that arrive meanwhile
+ * wait behind it.
+ *
+ * @param xRWLock A handle to the lock, returned by xSemaphoreCreateRWLock().
+ *
+ * @param xBlockTime The time in ticks to wait for the lock.
+ *
+ * @return pdTRUE if the lock was taken, pdFALSE if xBlockTime expired first.
+ *
+ * \defgroup xSemaphoreTakeWrite xSemaphoreTakeWrite
+ * \ingroup Semaphores
+ */
+#define xSemaphoreTakeWrite( xRWLock, xBlockTime )    xQueueTakeRWLock( ( xRWLock ), ( xBlockTime ), pdTRUE )
+
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreGiveRWLock( SemaphoreHandle_t xRWLock );
+ * @endcode
+ *
+ * Give back a reader-writer lock taken by xSemaphoreTakeRead() or
+ * xSemaphoreTakeWrite(), whichever it was.  When the last reader or the writer
+ * gives it, the lock goes to the waiting writer with the highest priority, or
+ * failing that to all the waiting readers.  xSemaphoreGive() does the same.
+ *
+ * @param xRWLock A handle to the lock.
+ *
+ * @return pdTRUE if the lock was given, pdFALSE if the calling task did not
+ * hold it.
+ *
+ * \defgroup xSemaphoreGiveRWLock xSemaphoreGiveRWLock
+ * \ingroup Semaphores
+ */
+#define xSemaphoreGiveRWLock( xRWLock )    xSemaphoreGive( ( xRWLock ) )
+
 /**
  * semphr. h
  * @code{c}
@@ -1157,6 +1300,51 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreGetMutexHolderFromISR( xSemaphore )    xQueueGetMutexHolderFromISR( ( xSemaphore ) )
 
+/**
+ * semphr.h
+ * @code{c}
+ * void vSemaphoreGetMutexProfile( SemaphoreHandle_t xMutex, MutexProfile_t *pxProfile );
+ * @endcode
+ *
+ * Copy the profile of a mutex: how often it was acquired, how often a task
+ * had to wait for it and for how long, and the longest time a task held it
+ * along with that task.  Use it to find the mutexes behind priority inversion
+ * stalls.  Times are in configMUTEX_PROFILING_CLOCK() units, ticks unless a
+ * finer clock is configured.
+ *
+ * configUSE_MUTEX_PROFILING must be set to 1 in FreeRTOSConfig.h for this
+ * macro to be available.
+ *
+ * @param xMutex A handle to the mutex, created with xSemaphoreCreateMutex()
+ * or xSemaphoreCreateRecursiveMutex().
+ *
+ * @param pxProfile The structure the profile is copied to.
+ *
+ * \defgroup vSemaphoreGetMutexProfile vSemaphoreGetMutexProfile
+ * \ingroup Semaphores
+ */
+#if ( configUSE_MUTEX_PROFILING == 1 )
+    #define vSemaphoreGetMutexProfile( xMutex, pxProfile )    vQueueGetMutexProfile( ( QueueHandle_t ) ( xMutex ), ( pxProfile ) )
+#endif
+
+/**
+ * semphr.h
+ * @code{c}
+ * void vSemaphoreResetMutexProfile( SemaphoreHandle_t xMutex );
+ * @endcode
+ *
+ * Clear the profile of a mutex.  A task holding the mutex at the time is
+ * still timed from when it took it.
+ *
+ * @param xMutex A handle to the mutex.
+ *
+ * \defgroup vSemaphoreResetMutexProfile vSemaphoreResetMutexProfile
+ * \ingroup Semaphores
+ */
+#if ( configUSE_MUTEX_PROFILING == 1 )
+    #define vSemaphoreResetMutexProfile( xMutex )    vQueueResetMutexProfile( ( QueueHandle_t ) ( xMutex ) )
+#endif
+
 /**
  * semphr.h
  * @code{c}
@@ -116,6 +116,21 @@ typedef struct xTIME_OUT
     TickType_t xTimeOnEntering;
 } TimeOut_t;
 
+/* Used with the uxTaskGetSystemState() function to return the state of each task
+ * in the system. */
+typedef struct xTASK_STATUS
+{
+    TaskHandle_t xHandle;                            /* The handle of the task to which the rest of the information in the structure relates. */
+    const char * pcTaskName;                         /* A pointer to the task's name.  This value will be invalid if the task was deleted since the structure was populated! */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    UBaseType_t xTaskNumber;                         /* The position of the task in the snapshot of uxTaskGetSystemState(), counting from the oldest thread.  0 when filled by vTaskGetInfo(). */
+    eTaskState eCurrentState;                        /* The state in which the task existed when the structure was populated. */
+    UBaseType_t uxCurrentPriority;                   /* The priority at which the task was running (may be inherited) when the structure was populated. */
+    UBaseType_t uxBasePriority;                      /* RT-Thread keeps no separate base priority, so this is the same as uxCurrentPriority. */
+    configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;    /* The total run time allocated to the task so far.  Always 0 while configGENERATE_RUN_TIME_STATS is 0. */
+    StackType_t * pxStackBase;                       /* Points to the lowest address of the task's stack area. */
+    configSTACK_DEPTH_TYPE usStackHighWaterMark;     /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+} TaskStatus_t;
+
 /**
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -1142,7 +1157,11 @@ TickType_t xTaskGetTickCountFromISR( void );
  * @return The number of tasks that the real time kernel is currently managing.
  * This includes all ready, blocked and suspended tasks.  A task that
  * has been deleted but not yet freed by the idle task will also be
- * included in the count.
+ * included in the count.  Native RT-Thread threads are counted as well.
+ *
+ * The count is found by walking the thread list with interrupts disabled,
+ * unless configUSE_LIVE_TASK_COUNT is 1, in which case it is kept up to date
+ * as threads are created and freed and read with a single load.
  *
  * \defgroup uxTaskGetNumberOfTasks uxTaskGetNumberOfTasks
  * \ingroup TaskUtils
@@ -1171,7 +1190,9 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ); /*lint !e971 Unqualified char
  * @endcode
  *
  * NOTE:  This function takes a relatively long time to complete and should be
- * used sparingly.
+ * used sparingly, unless configUSE_NAME_INDEX is 1, in which case the name is
+ * looked up in a hash index.  If several tasks share the name, any of them may
+ * be returned.
  *
  * @return The handle of the task that has the human readable name pcNameToQuery.
  * NULL is returned if no matching name is found.  INCLUDE_xTaskGetHandle
@@ -1312,6 +1333,202 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void );
 
+/**
+ * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
+ * uxTaskGetSystemState() to be available.
+ *
+ * uxTaskGetSystemState() populates an TaskStatus_t structure for each task in
+ * the system.  TaskStatus_t structures contain, among other things, members
+ * for the task handle, task name, task priority, task state, and total amount
+ * of run time consumed by the task.  See the TaskStatus_t structure
+ * definition in this file for the full member list.
+ *
+ * Every RT-Thread thread is reported, including threads that were not created
+ * through this wrapper.  The thread list is walked once with interrupts
+ * disabled to copy the raw fields of each thread.  The stack high water marks
+ * are then measured one thread at a time, with interrupts disabled only while
+ * that thread's stack is scanned.  Each thread is looked up again first, and
+ * threads deleted since the walk are left out of the result.
+ *
+ * @param pxTaskStatusArray A pointer to an array of TaskStatus_t structures.
+ * The array must contain at least one TaskStatus_t structure for each task
+ * that is under the control of the RTOS.  The number of tasks under the control
+ * of the RTOS can be determined using the uxTaskGetNumberOfTasks() API function.
+ *
+ * @param uxArraySize The size of the array pointed to by the pxTaskStatusArray
+ * parameter.  The size is specified as the number of indexes in the array, or
+ * the number of TaskStatus_t structures contained in the array, not by the
+ * number of bytes in the array.
+ *
+ * @param pulTotalRunTime If configGENERATE_RUN_TIME_STATS is set to 1 in
+ * FreeRTOSConfig.h then *pulTotalRunTime is set by uxTaskGetSystemState() to the
+ * total run time since the target booted.  pulTotalRunTime can be set to NULL to
+ * omit the total run time information.
+ *
+ * @return The number of TaskStatus_t structures that were populated by
+ * uxTaskGetSystemState().  This should equal the number returned by the
+ * uxTaskGetNumberOfTasks() API function, but will be zero if the value passed
+ * in the uxArraySize parameter was too small.
+ */
+UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
+                                  const UBaseType_t uxArraySize,
+                                  configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime );
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState );
+ * @endcode
+ *
+ * configUSE_TRACE_FACILITY must be defined as 1 for this function to be
+ * available.
+ *
+ * Populates a TaskStatus_t structure with information about a task.
+ *
+ * @param xTask Handle of the task being queried.  If xTask is NULL then
+ * information will be returned about the calling task.
+ *
+ * @param pxTaskStatus A pointer to the TaskStatus_t structure that will be
+ * filled with information about the task referenced by the handle passed using
+ * the xTask parameter.
+ *
+ * @param xGetFreeStackSpace The TaskStatus_t structure contains a member to
+ * report the stack high water mark of the task being queried.  Calculating the
+ * stack high water mark takes a relatively long time, so the parameter is
+ * provided to allow the high water mark checking to be skipped.  The high
+ * watermark value will only be written to the TaskStatus_t structure if
+ * xGetFreeStackSpace is not set to pdFALSE;
+ *
+ * @param eState The TaskStatus_t structure contains a member to report the
+ * state of the task being queried.  Pass eInvalid to have the state obtained
+ * with eTaskGetState(), or pass a known state to skip that query.
+ */
+void vTaskGetInfo( TaskHandle_t xTask,
+                   TaskStatus_t * pxTaskStatus,
+                   BaseType_t xGetFreeStackSpace,
+                   eTaskState eState );
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskList( char *pcWriteBuffer );
+ * @endcode
+ *
+ * configUSE_TRACE_FACILITY and configUSE_STATS_FORMATTING_FUNCTIONS must both
+ * be defined as 1 for this function to be available, and
+ * configSUPPORT_DYNAMIC_ALLOCATION must be 1 as the snapshot is allocated from
+ * the heap.
+ *
+ * Lists all the current tasks, along with their current state and stack
+ * usage high water mark.
+ *
+ * Tasks are reported as running ('X'), blocked ('B'), ready ('R'), deleted
+ * ('D') or suspended ('S').  The columns are the name, state, priority, stack
+ * high water mark in words and task number.
+ *
+ * This is a formatting helper for demos and debugging only.  The buffer is
+ * not bounds checked; allow roughly 40 bytes per task.  Use
+ * uxTaskGetSystemState() directly to process the raw data.
+ *
+ * @param pcWriteBuffer A buffer into which the above mentioned details
+ * will be written, in ASCII form.
+ */
+void vTaskList( char * pcWriteBuffer ); /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetRunTimeStats( char *pcWriteBuffer );
+ * @endcode
+ *
+ * configUSE_TRACE_FACILITY and configUSE_STATS_FORMATTING_FUNCTIONS must both
+ * be defined as 1 for this function to be available.
+ *
+ * Writes the absolute run time of each task and its share of the total run
+ * time, one task per line.  A share below one percent is shown as "<1%".
+ * The counters stay at 0 while configGENERATE_RUN_TIME_STATS is 0.
+ *
+ * This is a formatting helper for demos and debugging only.  The buffer is
+ * not bounds checked; allow roughly 40 bytes per task.
+ *
+ * @param pcWriteBuffer A buffer into which the execution times will be
+ * written, in ASCII form.
+ */
+void vTaskGetRunTimeStats( char * pcWriteBuffer ); /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter( const TaskHandle_t xTask );
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimePercent( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for these functions to be
+ * available.
+ *
+ * Every task switch charges the time since the previous switch on the same
+ * core, as read from portGET_RUN_TIME_COUNTER_VALUE(), to the task switched
+ * out.  Any RT-Thread thread can be queried, not only tasks created through
+ * this wrapper.
+ *
+ * @param xTask Handle of the task being queried.  If xTask is NULL then
+ * the calling task is queried.
+ *
+ * @return ulTaskGetRunTimeCounter() returns the total run time of the task in
+ * counter units, including the time since the task last ran if it is running
+ * on the calling core.  ulTaskGetRunTimePercent() returns that time as a
+ * percentage of the run time of all cores since the stats started.
+ */
+configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter( const TaskHandle_t xTask );
+configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimePercent( const TaskHandle_t xTask );
+
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void );
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void );
+ * @endcode
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for these functions to be
+ * available.
+ *
+ * @return ulTaskGetIdleRunTimeCounter() returns the run time of the idle tasks
+ * of all cores together, in counter units.  ulTaskGetIdleRunTimePercent()
+ * returns it as a percentage of the run time of all cores, so the CPU load is
+ * 100 minus that value.
+ */
+configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void );
+configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void );
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetObjectHooks( void ( * pxAttachHook )( struct rt_object * object ), void ( * pxDetachHook )( struct rt_object * object ) );
+ * void vTaskSetSchedulerHook( void ( * pxHook )( struct rt_thread * from, struct rt_thread * to ) );
+ * @endcode
+ *
+ * RT_USING_HOOK must be defined for these functions to be available.
+ *
+ * RT-Thread keeps a single object attach hook, object detach hook and
+ * scheduler hook.  The task count, the name index, the task snapshots, the
+ * stack monitor and the run-time stats install their own, so applications and
+ * components such as tracers must set theirs with these functions instead of
+ * rt_object_attach_sethook(), rt_object_detach_sethook() and
+ * rt_scheduler_sethook().  The wrapper then calls them after its own work.
+ * When the wrapper does not use a hook, the function installs it directly.
+ * A hook replaced behind the wrapper's back during start-up is reported on
+ * the console and fails a configASSERT().
+ *
+ * @param pxAttachHook, pxDetachHook, pxHook The hooks to call, or NULL to
+ * remove them.
+ */
+#ifdef RT_USING_HOOK
+    void vTaskSetObjectHooks( void ( * pxAttachHook )( struct rt_object * object ),
+                              void ( * pxDetachHook )( struct rt_object * object ) );
+    void vTaskSetSchedulerHook( void ( * pxHook )( struct rt_thread * from,
+                                                   struct rt_thread * to ) );
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2243,6 +2460,38 @@ TaskHandle_t xTaskGetCurrentTaskHandle( void );
  */
 BaseType_t xTaskGetSchedulerState( void );
 
+#if ( configUSE_NAME_INDEX == 1 )
+
+/* Kinds of handle kept in the name index */
+    #define taskNAME_INDEX_TASK     ( ( uint8_t ) 0 )
+    #define taskNAME_INDEX_TIMER    ( ( uint8_t ) 1 )
+    #define taskNAME_INDEX_QUEUE    ( ( uint8_t ) 2 )
+    #define taskNAME_INDEX_KINDS    3
+
+/*
+ * Add a handle to, or remove it from, the name index.  The name is not copied
+ * and must stay valid until the handle is removed.  For use by timers.c and
+ * queue.c only.
+ */
+    void vTaskNameIndexInsert( const char * pcName,
+                               void * pvHandle,
+                               uint8_t ucKind );
+
+    void vTaskNameIndexRemove( const char * pcName,
+                               void * pvHandle,
+                               uint8_t ucKind );
+
+/*
+ * Look pcName up in the name index.  Returns pdTRUE with the handle, or NULL
+ * if there is none, in *ppvHandle.  Returns pdFALSE if the index could not
+ * hold every handle of the kind, in which case the caller has to search.
+ */
+    BaseType_t xTaskNameIndexFind( const char * pcName,
+                                   uint8_t ucKind,
+                                   void ** ppvHandle );
+
+#endif /* configUSE_NAME_INDEX */
+
 #ifdef ESP_PLATFORM
 BaseType_t xTaskGetAffinity( TaskHandle_t xTask );
 TaskHandle_t xTaskGetCurrentTaskHandleForCPU( BaseType_t cpuid );
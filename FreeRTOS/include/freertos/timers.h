@@ -1109,6 +1109,20 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void );
  */
 const char * pcTimerGetName( TimerHandle_t xTimer );
 
+/**
+ * TimerHandle_t xTimerGetHandle( const char * pcTimerName );
+ *
+ * Returns the handle of the timer that was created with the name pcTimerName.
+ * The name is looked up in a hash index if configUSE_NAME_INDEX is 1, else
+ * every timer is searched.  If several timers share the name, any of them may
+ * be returned.  Timers created with the RT-Thread API are never returned.
+ *
+ * @param pcTimerName The name of the timer being looked up.
+ *
+ * @return The handle of the timer, or NULL if no timer has the name.
+ */
+TimerHandle_t xTimerGetHandle( const char * pcTimerName );
+
 /**
  * void vTimerSetReloadMode( TimerHandle_t xTimer, const UBaseType_t uxAutoReload );
  *
@@ -1,24 +1,299 @@
 #include <FreeRTOS.h>
 
-static rt_base_t level = 0;
-static rt_base_t critical_nesting = 0;
+/* Only the simulator BSP runs as a host process.  Other targets built with a
+ * Linux toolchain, such as RT-Smart user space, use the tick count. */
+#if defined( SOC_SIMULATOR ) && ( defined( __linux__ ) || defined( __APPLE__ ) )
+    #define portRUN_TIME_FROM_HOST_CLOCK    1
+    #include <time.h>
+#else
+    #define portRUN_TIME_FROM_HOST_CLOCK    0
+#endif
+
+#ifdef RT_USING_SMP
+
+/* Taken by the outermost critical section on each core, so that a critical
+ * section excludes the other cores as well as the interrupts of its own. */
+static struct rt_spinlock critical_lock;
+
+    #define portCRITICAL_CPUS      RT_CPUS_NR
+    #define portCRITICAL_CPU()     rt_hw_cpu_id()
+
+#else
+
+    #define portCRITICAL_CPUS      1
+    #define portCRITICAL_CPU()     0
+
+#endif
+
+/* Interrupt state saved by the outermost critical section on each core, and
+ * how deeply critical sections are nested there.  Only the core itself
+ * touches its entry, with its interrupts masked. */
+static struct
+{
+    rt_base_t level;
+    rt_base_t nesting;
+} critical_nesting[ portCRITICAL_CPUS ];
 
 void vPortEnterCritical( void )
 {
-    if ( critical_nesting == 0 )
+    rt_base_t level;
+    int cpu;
+
+    /* Masked first, so the task cannot move to another core before it has
+     * found the entry of this one */
+#ifdef RT_USING_SMP
+    level = rt_hw_local_irq_disable();
+#else
+    level = rt_hw_interrupt_disable();
+#endif
+    cpu = portCRITICAL_CPU();
+    if ( critical_nesting[ cpu ].nesting == 0 )
     {
-        level = rt_hw_interrupt_disable();
+    #ifdef RT_USING_SMP
+        rt_spin_lock( &critical_lock );
+    #endif
+        critical_nesting[ cpu ].level = level;
     }
-    critical_nesting += 1;
+    critical_nesting[ cpu ].nesting += 1;
 }
 
 void vPortExitCritical( void )
 {
-    critical_nesting -= 1;
-    if ( critical_nesting == 0 )
+    rt_base_t level;
+    int cpu = portCRITICAL_CPU();
+
+    RT_ASSERT( critical_nesting[ cpu ].nesting > 0 );
+    critical_nesting[ cpu ].nesting -= 1;
+    if ( critical_nesting[ cpu ].nesting == 0 )
     {
+        level = critical_nesting[ cpu ].level;
+    #ifdef RT_USING_SMP
+        /* Unlocking may switch tasks, and another task may then use the entry */
+        rt_spin_unlock( &critical_lock );
+        rt_hw_local_irq_enable( level );
+    #else
         rt_hw_interrupt_enable( level );
+    #endif
+    }
+}
+
+#ifdef RT_USING_SMP
+
+static int prvCriticalLockInit( void )
+{
+    rt_spin_lock_init( &critical_lock );
+
+    return 0;
+}
+INIT_PREV_EXPORT( prvCriticalLockInit );
+
+#endif
+
+#if !defined( __GNUC__ ) && !defined( __clang__ )
+
+rt_uint32_t ulPortAtomicLoad( volatile rt_uint32_t * pulValue )
+{
+    rt_base_t level;
+    rt_uint32_t ulValue;
+
+    level = rt_hw_interrupt_disable();
+    ulValue = *pulValue;
+    rt_hw_interrupt_enable( level );
+
+    return ulValue;
+}
+
+void vPortAtomicStore( volatile rt_uint32_t * pulValue, rt_uint32_t ulNew )
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    *pulValue = ulNew;
+    rt_hw_interrupt_enable( level );
+}
+
+void vPortMemoryBarrier( void )
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_hw_interrupt_enable( level );
+}
+
+#endif
+
+#if !( ( defined( __GNUC__ ) || defined( __clang__ ) ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4 ) )
+
+BaseType_t xPortAtomicCompareAndSwap( volatile rt_uint32_t * pulValue, rt_uint32_t ulExpected, rt_uint32_t ulNew )
+{
+    rt_base_t level;
+    BaseType_t xSwapped = pdFALSE;
+
+    level = rt_hw_interrupt_disable();
+    if ( *pulValue == ulExpected )
+    {
+        *pulValue = ulNew;
+        xSwapped = pdTRUE;
+    }
+    rt_hw_interrupt_enable( level );
+
+    return xSwapped;
+}
+
+#endif
+
+#if !( ( defined( __GNUC__ ) || defined( __clang__ ) ) &&                                            \
+       ( ( ( __SIZEOF_POINTER__ == 4 ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4 ) ) || \
+         ( ( __SIZEOF_POINTER__ == 8 ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8 ) ) ) )
+
+BaseType_t xPortAtomicCompareAndSwapWord( volatile rt_ubase_t * puxValue, rt_ubase_t uxExpected, rt_ubase_t uxNew )
+{
+    rt_base_t level;
+    BaseType_t xSwapped = pdFALSE;
+
+    level = rt_hw_interrupt_disable();
+    if ( *puxValue == uxExpected )
+    {
+        *puxValue = uxNew;
+        xSwapped = pdTRUE;
     }
+    rt_hw_interrupt_enable( level );
+
+    return xSwapped;
+}
+
+#endif
+
+#if ( configUSE_DEFERRED_ISR_YIELD == 1 )
+
+/* Number of FromISR calls in progress on each core, and whether one of them
+ * made ready a task that outranks the interrupted one.  Only the core itself
+ * touches its entry, with its interrupts masked, as for critical_nesting. */
+static volatile struct
+{
+    UBaseType_t nesting;
+    BaseType_t pending;
+} isr_yield[ portCRITICAL_CPUS ];
+
+#ifdef RT_USING_SMP
+    #define portLOCAL_IRQ_DISABLE()            rt_hw_local_irq_disable()
+    #define portLOCAL_IRQ_ENABLE( level )      rt_hw_local_irq_enable( level )
+#else
+    #define portLOCAL_IRQ_DISABLE()            rt_hw_interrupt_disable()
+    #define portLOCAL_IRQ_ENABLE( level )      rt_hw_interrupt_enable( level )
+#endif
+
+#endif
+
+BaseType_t xPortIsrYieldBegin( void )
+{
+#if ( configUSE_DEFERRED_ISR_YIELD == 1 )
+    rt_base_t level;
+    BaseType_t xPrevious;
+    int cpu;
+
+    if ( rt_interrupt_get_nest() == 0 )
+    {
+        return pdFALSE;
+    }
+    level = portLOCAL_IRQ_DISABLE();
+    cpu = portCRITICAL_CPU();
+    xPrevious = isr_yield[ cpu ].pending;
+    isr_yield[ cpu ].pending = pdFALSE;
+    isr_yield[ cpu ].nesting++;
+    portLOCAL_IRQ_ENABLE( level );
+
+    return xPrevious;
+#else
+    return pdFALSE;
+#endif
+}
+
+void vPortIsrYieldEnd( BaseType_t xPrevious, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+#if ( configUSE_DEFERRED_ISR_YIELD == 1 )
+    rt_base_t level;
+    BaseType_t xWoken;
+    BaseType_t xScheduleNow = pdFALSE;
+    int cpu;
+
+    if ( rt_interrupt_get_nest() == 0 )
+    {
+        /* Called from a task: any wake up has already been scheduled. */
+        return;
+    }
+    level = portLOCAL_IRQ_DISABLE();
+    cpu = portCRITICAL_CPU();
+    isr_yield[ cpu ].nesting--;
+    xWoken = isr_yield[ cpu ].pending;
+    if ( pxHigherPriorityTaskWoken != NULL )
+    {
+        /* Like FreeRTOS, only ever set the flag, never clear it. */
+        if ( xWoken != pdFALSE )
+        {
+            *pxHigherPriorityTaskWoken = pdTRUE;
+        }
+        isr_yield[ cpu ].pending = xPrevious;
+    }
+    else if ( isr_yield[ cpu ].nesting != 0 )
+    {
+        /* Called on behalf of an enclosing FromISR call, which reports it. */
+        isr_yield[ cpu ].pending = xPrevious | xWoken;
+    }
+    else
+    {
+        /* Nobody will call portYIELD_FROM_ISR() for this one. */
+        isr_yield[ cpu ].pending = xPrevious;
+        xScheduleNow = xWoken;
+    }
+    portLOCAL_IRQ_ENABLE( level );
+
+    if ( xScheduleNow != pdFALSE )
+    {
+        rt_schedule();
+    }
+#else
+    if ( pxHigherPriorityTaskWoken != NULL )
+    {
+        *pxHigherPriorityTaskWoken = pdFALSE;
+    }
+#endif
+}
+
+BaseType_t xPortIsrYieldDeferred( void )
+{
+#if ( configUSE_DEFERRED_ISR_YIELD == 1 )
+    /* Inside an interrupt the core cannot change under us */
+    return ( ( rt_interrupt_get_nest() != 0 ) && ( isr_yield[ portCRITICAL_CPU() ].nesting != 0 ) ) ? pdTRUE : pdFALSE;
+#else
+    return pdFALSE;
+#endif
+}
+
+void vPortIsrYieldRequest( rt_thread_t thread )
+{
+#if ( configUSE_DEFERRED_ISR_YIELD == 1 )
+    if ( ( xPortIsrYieldDeferred() != pdFALSE ) && ( thread->current_priority < rt_thread_self()->current_priority ) )
+    {
+        isr_yield[ portCRITICAL_CPU() ].pending = pdTRUE;
+    }
+#else
+    ( void ) thread;
+#endif
+}
+
+void vPortYieldFromISR( BaseType_t xSwitchRequired )
+{
+#if ( configUSE_DEFERRED_ISR_YIELD == 1 )
+    /* From an ISR rt_schedule() only pends the switch until the ISR returns. */
+    if ( xSwitchRequired != pdFALSE )
+    {
+        rt_schedule();
+    }
+#else
+    ( void ) xSwitchRequired;
+    rt_thread_yield();
+#endif
 }
 
 void vPortEndScheduler( void )
@@ -26,6 +301,18 @@ void vPortEndScheduler( void )
     /* Not implemented in ports where there is nothing to return to. */
 }
 
+rt_uint64_t ulPortGetRunTimeCounterValue( void )
+{
+#if ( portRUN_TIME_FROM_HOST_CLOCK == 1 )
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( rt_uint64_t ) ts.tv_sec * 1000000ULL + ( rt_uint64_t ) ts.tv_nsec / 1000U;
+#else
+    return ( rt_uint64_t ) rt_tick_get();
+#endif
+}
+
 BaseType_t rt_err_to_freertos(rt_err_t rt_err)
 {
     switch(-rt_err)
@@ -65,6 +65,138 @@
         rt_uint16_t max_value;
     };
 
+/* Contiguous ring buffer used for queues when configUSE_QUEUE_RING_BUFFER is 1.
+ * The object header is initialised as a message queue so that it is handled
+ * like one, but it is not registered with the kernel object container. */
+    struct rt_ring_queue
+    {
+        struct rt_ipc_object parent;
+        rt_uint8_t *msg_pool;
+        rt_uint16_t msg_size;
+        rt_uint16_t max_msgs;
+        rt_uint16_t entry;
+        rt_uint16_t head;
+        rt_uint16_t tail;
+        rt_uint8_t send_reserved;
+        rt_uint8_t recv_reserved;
+        rt_list_t suspend_sender_thread;
+    };
+
+/* Single producer, single consumer queue created by xQueueCreateSPSC().  head
+ * is only written by the consumer and tail only by the producer, both running
+ * from 0 to 2 * max_msgs - 1 so that a full queue can be told from an empty
+ * one without a shared counter. */
+    struct rt_spsc_queue
+    {
+        struct rt_ipc_object parent;
+        rt_uint8_t *msg_pool;
+        rt_uint16_t msg_size;
+        rt_uint16_t max_msgs;
+        volatile rt_uint32_t head;
+        volatile rt_uint32_t tail;
+        rt_list_t suspend_sender_thread;
+    };
+
+/* Semaphore used when configUSE_NATIVE_SEMAPHORES is 1.  count is changed
+ * with compare-and-swap, so giving or taking a semaphore nobody is waiting
+ * for never masks interrupts.  Blocked takers wait on parent.suspend_thread. */
+    struct rt_native_semaphore
+    {
+        struct rt_ipc_object parent;
+        volatile rt_uint32_t count;
+        rt_uint32_t max_value;
+    };
+
+/* Mutex used when configUSE_LEAN_MUTEXES is 1.  owner is the lock word: 0
+ * when the mutex is free, otherwise the address of the holder, with bit 0 set
+ * once tasks may be waiting on parent.suspend_thread.  Taking a free mutex and
+ * giving one nobody waits for are a single compare-and-swap of owner; only a
+ * set bit 0 makes the holder give through the kernel.  taken_list links the
+ * mutex into the wrapper's list of contended locks while the holder may have
+ * to run at a waiter's priority. */
+    struct rt_lean_mutex
+    {
+        struct rt_ipc_object parent;
+        volatile rt_ubase_t owner;
+        rt_list_t taken_list;
+    };
+
+/* Reader-writer lock created by xSemaphoreCreateRWLock().  readers counts the
+ * tasks holding it for reading and writer is the task holding it for writing.
+ * Waiting readers are on parent.suspend_thread and waiting writers on
+ * suspend_writer_thread.  taken_list links the lock into the wrapper's list of
+ * contended locks while the writer may have to run at a waiter's priority. */
+    struct rt_rwlock
+    {
+        struct rt_ipc_object parent;
+        rt_uint32_t readers;
+        struct rt_thread *writer;
+        rt_list_t suspend_writer_thread;
+        rt_list_t taken_list;
+    };
+
+/* Overwrite queue of length one created by xQueueCreateMailbox().  sequence is
+ * odd while the value is being written, so readers can copy it without masking
+ * interrupts and retry if it changed underneath them. */
+    struct rt_mailbox_queue
+    {
+        struct rt_ipc_object parent;
+        rt_uint8_t *msg_pool;
+        rt_uint16_t msg_size;
+        volatile rt_uint8_t full;
+        volatile rt_uint32_t sequence;
+        rt_list_t suspend_sender_thread;
+    };
+
+/* Queue created by xQueueCreatePriority().  Items share the max_msgs slots of
+ * msg_pool.  Free slots and the items of each priority level form FIFOs linked
+ * through next[], with head[] and tail[] holding the ends of each level, and
+ * bit ( 31 - level ) of ready is set while a level holds items.  The three
+ * arrays live in the queue storage after the slots. */
+    struct rt_priority_queue
+    {
+        struct rt_ipc_object parent;
+        rt_uint8_t *msg_pool;
+        rt_uint16_t *next;
+        rt_uint16_t *head;
+        rt_uint16_t *tail;
+        rt_uint16_t msg_size;
+        rt_uint16_t max_msgs;
+        rt_uint16_t entry;
+        rt_uint16_t free;
+        rt_uint8_t levels;
+        rt_uint32_t ready;
+        rt_list_t suspend_sender_thread;
+    };
+
+/* Broadcast queue created by xQueueCreateBroadcast().  Every subscriber reads
+ * every item from the single ring in msg_pool.  tail is the write index and
+ * each subscriber keeps its own read index, both running from 0 to
+ * 2 * max_msgs - 1 as in struct rt_spsc_queue, so that a subscriber a whole
+ * ring behind can be told from one that is up to date.  policy tells what a
+ * send does when the slowest subscriber is a whole ring behind. */
+    struct rt_broadcast_queue
+    {
+        struct rt_ipc_object parent;
+        rt_uint8_t *msg_pool;
+        rt_uint16_t msg_size;
+        rt_uint16_t max_msgs;
+        rt_uint8_t policy;
+        rt_uint32_t tail;
+        rt_list_t subscribers;
+        rt_list_t suspend_sender_thread;
+    };
+
+/* Read side of a broadcast queue, created by xQueueSubscribe().  The task
+ * reading through it blocks on parent.suspend_thread. */
+    struct rt_broadcast_subscriber
+    {
+        struct rt_ipc_object parent;
+        struct rt_broadcast_queue *queue;
+        rt_uint32_t cursor;
+        rt_list_t node;
+    };
+
 /*-----------------------------------------------------------*/
 
 /* Architecture specifics. */
@@ -75,20 +207,94 @@
 
 /* Scheduler utilities. */
     #define portYIELD()                 rt_thread_yield()
-    #define portYIELD_FROM_ISR( x )     rt_thread_yield()
+    #define portYIELD_FROM_ISR( x )     vPortYieldFromISR( x )
+    #define portEND_SWITCHING_ISR( x )  vPortYieldFromISR( x )
+    extern void vPortYieldFromISR( BaseType_t xSwitchRequired );
+
+/* FromISR functions bracket their work with these.  With
+ * configUSE_DEFERRED_ISR_YIELD set to 1, tasks made ready inside the bracket
+ * are only recorded, *pxHigherPriorityTaskWoken is set if one of them outranks
+ * the interrupted task, and the switch happens in portYIELD_FROM_ISR().
+ * Otherwise the wrapper reschedules at once, as the RT-Thread APIs do, and
+ * *pxHigherPriorityTaskWoken is set to pdFALSE. */
+    extern BaseType_t xPortIsrYieldBegin( void );
+    extern void vPortIsrYieldEnd( BaseType_t xPrevious, BaseType_t * const pxHigherPriorityTaskWoken );
+    extern BaseType_t xPortIsrYieldDeferred( void );
+    extern void vPortIsrYieldRequest( rt_thread_t thread );
 
 /*-----------------------------------------------------------*/
 
 /* Critical section management. */
     extern void vPortEnterCritical( void );
     extern void vPortExitCritical( void );
+#ifdef RT_USING_SMP
+/* On SMP an interrupt must take the same spinlock as tasks on the other cores.
+ * The interrupt state is kept by vPortEnterCritical() for the core. */
+    #define portSET_INTERRUPT_MASK_FROM_ISR()         ( vPortEnterCritical(), ( rt_base_t ) 0 )
+    #define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    do { ( void ) ( x ); vPortExitCritical(); } while( 0 )
+#else
     #define portSET_INTERRUPT_MASK_FROM_ISR()         rt_hw_interrupt_disable()
     #define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    rt_hw_interrupt_enable( x )
+#endif
     #define portDISABLE_INTERRUPTS()                  vPortEnterCritical()
     #define portENABLE_INTERRUPTS()                   vPortExitCritical()
     #define portENTER_CRITICAL()                      vPortEnterCritical()
     #define portEXIT_CRITICAL()                       vPortExitCritical()
 
+/*-----------------------------------------------------------*/
+
+/* Atomic accesses with acquire/release ordering, used by the lock-free queue
+ * paths.  Compilers without the GNU builtins fall back to port.c, which masks
+ * interrupts around a plain access. */
+    #if defined( __GNUC__ ) || defined( __clang__ )
+        #define portATOMIC_LOAD_ACQUIRE( pulValue )              __atomic_load_n( ( pulValue ), __ATOMIC_ACQUIRE )
+        #define portATOMIC_STORE_RELEASE( pulValue, ulNew )      __atomic_store_n( ( pulValue ), ( ulNew ), __ATOMIC_RELEASE )
+        #define portMEMORY_BARRIER()                             __atomic_thread_fence( __ATOMIC_SEQ_CST )
+    #else
+        extern rt_uint32_t ulPortAtomicLoad( volatile rt_uint32_t * pulValue );
+        extern void vPortAtomicStore( volatile rt_uint32_t * pulValue, rt_uint32_t ulNew );
+        extern void vPortMemoryBarrier( void );
+        #define portATOMIC_LOAD_ACQUIRE( pulValue )              ulPortAtomicLoad( pulValue )
+        #define portATOMIC_STORE_RELEASE( pulValue, ulNew )      vPortAtomicStore( ( pulValue ), ( ulNew ) )
+        #define portMEMORY_BARRIER()                             vPortMemoryBarrier()
+    #endif
+
+/* Returns non-zero if *pulValue held ulExpected and was replaced by ulNew.
+ * Cores without a word sized compare-and-swap, such as ARMv6-M, use the
+ * port.c fallback. */
+    #if ( defined( __GNUC__ ) || defined( __clang__ ) ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4 )
+        #define portATOMIC_COMPARE_AND_SWAP( pulValue, ulExpected, ulNew )    __sync_bool_compare_and_swap( ( pulValue ), ( ulExpected ), ( ulNew ) )
+    #else
+        extern BaseType_t xPortAtomicCompareAndSwap( volatile rt_uint32_t * pulValue, rt_uint32_t ulExpected, rt_uint32_t ulNew );
+        #define portATOMIC_COMPARE_AND_SWAP( pulValue, ulExpected, ulNew )    xPortAtomicCompareAndSwap( ( pulValue ), ( ulExpected ), ( ulNew ) )
+    #endif
+
+/* The same for a pointer sized word, such as a lean mutex owner. */
+    #if ( defined( __GNUC__ ) || defined( __clang__ ) ) &&                                            \
+        ( ( ( __SIZEOF_POINTER__ == 4 ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4 ) ) || \
+          ( ( __SIZEOF_POINTER__ == 8 ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8 ) ) )
+        #define portATOMIC_COMPARE_AND_SWAP_WORD( puxValue, uxExpected, uxNew )    __sync_bool_compare_and_swap( ( puxValue ), ( uxExpected ), ( uxNew ) )
+    #else
+        extern BaseType_t xPortAtomicCompareAndSwapWord( volatile rt_ubase_t * puxValue, rt_ubase_t uxExpected, rt_ubase_t uxNew );
+        #define portATOMIC_COMPARE_AND_SWAP_WORD( puxValue, uxExpected, uxNew )    xPortAtomicCompareAndSwapWord( ( puxValue ), ( uxExpected ), ( uxNew ) )
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/* Time base of the run-time stats.  Define portGET_RUN_TIME_COUNTER_VALUE() in
+ * FreeRTOSConfig.h to read a high resolution counter such as a cycle counter,
+ * and portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() to start it.  Otherwise the
+ * simulator BSP (SOC_SIMULATOR) counts microseconds with clock_gettime() and
+ * other targets fall back to the tick count.  The value is 64 bits wide, and
+ * is cut to configRUN_TIME_COUNTER_TYPE where it is stored. */
+    #ifndef portGET_RUN_TIME_COUNTER_VALUE
+        extern rt_uint64_t ulPortGetRunTimeCounterValue( void );
+        #define portGET_RUN_TIME_COUNTER_VALUE()    ulPortGetRunTimeCounterValue()
+        #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+            #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+        #endif
+    #endif
+
 /*-----------------------------------------------------------*/
 
     #define FREERTOS_PRIORITY_TO_RTTHREAD(priority)    ( configMAX_PRIORITIES - 1 - ( priority ) )
@@ -96,7 +302,16 @@
 /* Use this macro to calculate the buffer size when allocating a queue statically
  * To ensure the buffer can fit the desired number of messages
  */
-    #define QUEUE_BUFFER_SIZE( uxQueueLength, uxItemSize )  ( ( RT_ALIGN( uxItemSize, RT_ALIGN_SIZE ) + sizeof( void * ) ) * uxQueueLength )
+    #define QUEUE_BUFFER_SIZE( uxQueueLength, uxItemSize )                        \
+    ( ( configUSE_QUEUE_RING_BUFFER == 1 ) ? ( ( uxItemSize ) * ( uxQueueLength ) ) : \
+      ( ( RT_ALIGN( uxItemSize, RT_ALIGN_SIZE ) + sizeof( void * ) ) * uxQueueLength ) )
+
+/* Use this macro to calculate the buffer size of a priority queue created with
+ * xQueueCreatePriorityStatic(): the slots, then the links of every slot and
+ * the two ends of every priority level */
+    #define PRIORITY_QUEUE_BUFFER_SIZE( uxQueueLength, uxItemSize, uxPriorityLevels )   \
+    ( RT_ALIGN( ( uxItemSize ) * ( uxQueueLength ), sizeof( rt_uint16_t ) ) +              \
+      ( ( uxQueueLength ) + 2 * ( uxPriorityLevels ) ) * sizeof( rt_uint16_t ) )
 
     BaseType_t rt_err_to_freertos(rt_err_t rt_err);
 
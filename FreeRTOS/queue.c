@@ -37,720 +37,5872 @@
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME          ( ( TickType_t ) 0U )
 
+/* What rt_ipc points to, recorded when the handle is created.  Selects the
+ * entry of xQueueOperations[] that implements the handle. */
+#define queueKIND_MESSAGE_QUEUE             ( ( uint8_t ) 0U )
+#define queueKIND_SPSC                      ( ( uint8_t ) 1U )
+#define queueKIND_MAILBOX                   ( ( uint8_t ) 2U )
+#define queueKIND_SEMAPHORE                 ( ( uint8_t ) 3U )
+#define queueKIND_MUTEX                     ( ( uint8_t ) 4U )
+#define queueKIND_PRIORITY                  ( ( uint8_t ) 5U )
+#define queueKIND_BROADCAST                 ( ( uint8_t ) 6U )
+#define queueKIND_SUBSCRIBER                ( ( uint8_t ) 7U )
+#define queueKIND_RWLOCK                    ( ( uint8_t ) 8U )
+#if ( configUSE_LEAN_MUTEXES == 1 )
+    #define queueKIND_LEAN_MUTEX            ( ( uint8_t ) 9U )
+    #define queueKIND_COUNT                 ( ( uint8_t ) 10U )
+#else
+    #define queueKIND_COUNT                 ( ( uint8_t ) 9U )
+#endif
+
+#if ( configUSE_LEAN_MUTEXES == 1 )
+    #define prvQueueIsMutex( pxQueue )    ( ( ( pxQueue )->ucQueueKind == queueKIND_MUTEX ) || ( ( pxQueue )->ucQueueKind == queueKIND_LEAN_MUTEX ) )
+#else
+    #define prvQueueIsMutex( pxQueue )    ( ( pxQueue )->ucQueueKind == queueKIND_MUTEX )
+#endif
+
+/* Value of a free rt_lean_mutex.owner, and the bit set in it while tasks may
+ * be waiting for the holder. */
+#define queueLEAN_MUTEX_FREE                ( ( rt_ubase_t ) 0U )
+#define queueLEAN_MUTEX_CONTENDED           ( ( rt_ubase_t ) 1U )
+#define prvLeanMutexOwner( mutex )          ( ( rt_thread_t ) ( ( mutex )->owner & ~queueLEAN_MUTEX_CONTENDED ) )
+
+/* Where the memory of a handle came from, so vQueueDelete() knows how to
+ * release it.  A dynamic handle is a single block holding the handle, the
+ * kernel object and the queue storage. */
+#define queueALLOCATED_STATICALLY           ( ( uint8_t ) 0U )
+#define queueALLOCATED_FROM_HEAP            ( ( uint8_t ) 1U )
+#define queueALLOCATED_FROM_POOL            ( ( uint8_t ) 2U )
+
+/*
+ * The lock-free paths publish an item or a count, then wake a task that may
+ * have blocked on the old value.  On a single core a task that is about to
+ * block holds the interrupt lock from its last check until it is on the wait
+ * list, so the list can be looked at without the lock.  On SMP a task on
+ * another core can be between the two, so the list is only looked at with the
+ * lock held, and a store that publishes an index is fenced against the loads
+ * that follow it.
+ */
+#ifdef RT_USING_SMP
+    #define queueMAY_HAVE_WAITERS( pxWaitList )    ( RT_TRUE )
+    #define queueSMP_MEMORY_BARRIER()              portMEMORY_BARRIER()
+#else
+    #define queueMAY_HAVE_WAITERS( pxWaitList )    ( !rt_list_isempty( pxWaitList ) )
+    #define queueSMP_MEMORY_BARRIER()
+#endif
+
 typedef struct QueueDefinition
 {
     struct rt_ipc_object *rt_ipc;
+    uint8_t ucQueueKind;
+    uint8_t ucAllocation;
+    uint16_t usSlotsHeld;   /* Zero-copy slots acquired and not yet committed or released */
+    #if ( configUSE_QUEUE_SETS == 1 )
+        struct QueueDefinition * pxQueueSetContainer;
+    #endif
+    #if ( configUSE_QUEUE_STATISTICS == 1 )
+        QueueStatistics_t xStatistics;
+    #endif
+    #if ( configUSE_QUEUE_WATERMARKS == 1 )
+        QueueWatermarks_t xWatermarks;
+    #endif
 } xQUEUE;
 typedef xQUEUE Queue_t;
 
+#if ( configUSE_QUEUE_RING_BUFFER == 1 )
+    typedef struct rt_ring_queue      MessageQueue_t;
+#else
+    typedef struct rt_messagequeue    MessageQueue_t;
+
+/* Header that precedes every message in an rt_messagequeue pool.  Mirrors
+ * struct rt_mq_message, which RT-Thread keeps private to ipc.c up to 5.0, so
+ * that slots can be linked and unlinked in place by the zero-copy API.
+ * Kernels that publish the structure, with RT_MQ_BUF_SIZE(), are checked
+ * here; for the others prvMqCheckLayout() checks every new queue. */
+    typedef struct QueueMessage
+    {
+        struct QueueMessage * pxNext;
+    #if RT_VER_NUM >= 0x50001
+        rt_ssize_t xLength;
+    #endif
+    #ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+        rt_int32_t lPriority;
+    #endif
+    } QueueMessage_t;
+
+    #ifdef RT_MQ_BUF_SIZE
+        typedef char QueueMessageSizeCheck_t[ ( sizeof( QueueMessage_t ) == sizeof( struct rt_mq_message ) ) ? 1 : -1 ];
+    #endif
+#endif /* configUSE_QUEUE_RING_BUFFER */
+
 static volatile rt_uint8_t mutex_index = 0;
 static volatile rt_uint8_t sem_index = 0;
 static volatile rt_uint8_t queue_index = 0;
 
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+/* The queue registry is just a means for kernel aware debuggers and the
+ * queue_stats command to locate queue structures.  It has no other purpose
+ * so is an optional component. */
+    typedef struct QUEUE_REGISTRY_ITEM
+    {
+        const char * pcQueueName;
+        QueueHandle_t xHandle;
+    } xQueueRegistryItem;
+
+    typedef xQueueRegistryItem QueueRegistryItem_t;
+
+/* The queue registry is simply an array of QueueRegistryItem_t structures.
+ * The pcQueueName member of a structure being NULL is indicative of the
+ * array position being vacant. */
+    QueueRegistryItem_t xQueueRegistry[ configQUEUE_REGISTRY_SIZE ];
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+
+#if ( configQUEUE_POOL_BLOCK_COUNT > 0 )
+
+/* Blocks for dynamic handles.  Each block is preceded by the pointer that
+ * rt_mempool keeps in front of it. */
+    static struct rt_mempool xQueuePool;
+    static rt_uint8_t ucQueuePoolStorage[ configQUEUE_POOL_BLOCK_COUNT *
+                                          ( RT_ALIGN( configQUEUE_POOL_BLOCK_SIZE, RT_ALIGN_SIZE ) + sizeof( rt_uint8_t * ) ) ] rt_align( RT_ALIGN_SIZE );
+
+    static int prvQueuePoolInit( void )
+    {
+        rt_mp_init( &xQueuePool, "fqpool", ucQueuePoolStorage, sizeof( ucQueuePoolStorage ), configQUEUE_POOL_BLOCK_SIZE );
+
+        return 0;
+    }
+    INIT_PREV_EXPORT( prvQueuePoolInit );
+
+#endif /* configQUEUE_POOL_BLOCK_COUNT */
+
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
-                               BaseType_t xNewQueue )
+static void prvInitialiseNewQueue( Queue_t * pxNewQueue,
+                                   struct rt_ipc_object * pipc,
+                                   uint8_t ucQueueKind,
+                                   uint8_t ucAllocation )
 {
-    Queue_t * const pxQueue = xQueue;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
+    pxNewQueue->rt_ipc = pipc;
+    pxNewQueue->ucQueueKind = ucQueueKind;
+    pxNewQueue->ucAllocation = ucAllocation;
+    pxNewQueue->usSlotsHeld = 0;
+    #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            pxNewQueue->pxQueueSetContainer = NULL;
+        }
+    #endif
+    #if ( configUSE_QUEUE_STATISTICS == 1 )
+        {
+            rt_memset( &( pxNewQueue->xStatistics ), 0x00, sizeof( QueueStatistics_t ) );
+        }
+    #endif
+    #if ( configUSE_QUEUE_WATERMARKS == 1 )
+        {
+            rt_memset( &( pxNewQueue->xWatermarks ), 0x00, sizeof( QueueWatermarks_t ) );
+        }
+    #endif
+}
+/*-----------------------------------------------------------*/
 
-    configASSERT( pxQueue );
+/*
+ * Name a new object <prefix><index>, with at least two digits, as
+ * rt_snprintf( pcName, RT_NAME_MAX, "%s%02d", ... ) would but without the
+ * cost of formatting.
+ */
+static void prvQueueName( char * pcName,
+                          const char * pcPrefix,
+                          rt_uint8_t ucIndex )
+{
+    char cDigits[ 3 ];
+    rt_size_t xDigits = 0;
+    rt_size_t xLength = 0;
 
-    pipc = pxQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
+    do
+    {
+        cDigits[ xDigits++ ] = ( char ) ( '0' + ( ucIndex % 10U ) );
+        ucIndex /= 10U;
+    } while ( ucIndex != 0U );
+    if ( xDigits < 2U )
+    {
+        cDigits[ xDigits++ ] = '0';
+    }
+    while ( ( *pcPrefix != '\0' ) && ( xLength < RT_NAME_MAX - 1 ) )
+    {
+        pcName[ xLength++ ] = *pcPrefix++;
+    }
+    while ( ( xDigits > 0U ) && ( xLength < RT_NAME_MAX - 1 ) )
+    {
+        pcName[ xLength++ ] = cDigits[ --xDigits ];
+    }
+    pcName[ xLength ] = '\0';
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-    if ( type == RT_Object_Class_Semaphore )
+/*
+ * Allocate the single block that holds a dynamic handle, its kernel object
+ * and its storage.  The pool is tried first when the block fits in it.
+ */
+    static Queue_t * prvQueueAllocate( rt_size_t xSize,
+                                       uint8_t * pucAllocation )
     {
-        rt_sem_control( ( rt_sem_t ) pipc, RT_IPC_CMD_RESET, ( void * ) 0);
+        void * pvBlock;
+
+        #if ( configQUEUE_POOL_BLOCK_COUNT > 0 )
+            {
+                if ( xSize <= configQUEUE_POOL_BLOCK_SIZE )
+                {
+                    pvBlock = rt_mp_alloc( &xQueuePool, RT_WAITING_NO );
+                    if ( pvBlock != RT_NULL )
+                    {
+                        *pucAllocation = queueALLOCATED_FROM_POOL;
+                        return ( Queue_t * ) pvBlock;
+                    }
+                }
+            }
+        #endif /* configQUEUE_POOL_BLOCK_COUNT */
+        pvBlock = RT_KERNEL_MALLOC( xSize );
+        *pucAllocation = queueALLOCATED_FROM_HEAP;
+
+        return ( Queue_t * ) pvBlock;
     }
-    else if ( type == RT_Object_Class_MessageQueue )
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+/* Release the block of a dynamic handle.  Static handles are left alone. */
+static void prvQueueFree( Queue_t * pxQueue )
+{
+    switch ( pxQueue->ucAllocation )
     {
-        rt_mq_control( ( rt_mq_t ) pipc, RT_IPC_CMD_RESET, RT_NULL );
+    #if ( configQUEUE_POOL_BLOCK_COUNT > 0 )
+        case queueALLOCATED_FROM_POOL:
+            rt_mp_free( pxQueue );
+            break;
+    #endif
+        case queueALLOCATED_FROM_HEAP:
+            RT_KERNEL_FREE( pxQueue );
+            break;
+        default:
+            break;
     }
+}
+/*-----------------------------------------------------------*/
 
-    return pdPASS;
+#if ( configUSE_QUEUE_SETS == 1 )
+
+/*
+ * Post the handle of a member that has just become ready to its queue set.
+ * The set is sized to hold an event for every item its members can hold, so
+ * this cannot fail.  A mutex is only ready once it has no owner.
+ */
+    static void prvNotifyQueueSetContainer( Queue_t * const pxQueue )
+    {
+        Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+        struct rt_ipc_object * pipc = pxQueue->rt_ipc;
+        BaseType_t xReturn;
+
+        if ( pxQueueSetContainer == NULL )
+        {
+            return;
+        }
+        if ( ( pxQueue->ucQueueKind == queueKIND_MUTEX ) &&
+             ( ( ( rt_mutex_t ) pipc )->owner != RT_NULL ) )
+        {
+            return;
+        }
+    #if ( configUSE_LEAN_MUTEXES == 1 )
+        if ( ( pxQueue->ucQueueKind == queueKIND_LEAN_MUTEX ) &&
+             ( ( ( struct rt_lean_mutex * ) pipc )->owner != queueLEAN_MUTEX_FREE ) )
+        {
+            return;
+        }
+    #endif
+        xReturn = xQueueGenericSendFromISR( pxQueueSetContainer, &pxQueue, NULL, queueSEND_TO_BACK );
+        configASSERT( xReturn == pdPASS );
+        ( void ) xReturn;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+/*
+ * Block the calling thread on an IPC suspend list until it is resumed or the
+ * block time expires.  Waiters are kept in priority order, the same way
+ * RT_IPC_FLAG_PRIO objects order them.  Must be called with interrupts
+ * disabled, level being the value returned by rt_hw_interrupt_disable().
+ * Interrupts are enabled before the thread blocks and on return
+ * *pxTicksToWait holds the block time that remains.
+ */
+static rt_err_t prvQueueWait( rt_list_t * pxWaitList,
+                              TickType_t * const pxTicksToWait,
+                              rt_base_t level )
+{
+    rt_thread_t thread = rt_thread_self();
+    struct rt_list_node * node;
+    rt_tick_t tick_before = rt_tick_get();
+    rt_tick_t tick_elapsed;
+
+    thread->error = RT_EOK;
+    rt_thread_suspend( thread );
+
+    rt_list_for_each( node, pxWaitList )
+    {
+        if ( thread->current_priority < rt_list_entry( node, struct rt_thread, tlist )->current_priority )
+        {
+            break;
+        }
+    }
+    rt_list_insert_before( node, &( thread->tlist ) );
+
+    if ( ( rt_int32_t ) *pxTicksToWait > 0 )
+    {
+        rt_timer_control( &( thread->thread_timer ), RT_TIMER_CTRL_SET_TIME, pxTicksToWait );
+        rt_timer_start( &( thread->thread_timer ) );
+    }
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+
+    if ( ( rt_int32_t ) *pxTicksToWait > 0 )
+    {
+        tick_elapsed = rt_tick_get() - tick_before;
+        *pxTicksToWait = ( tick_elapsed < *pxTicksToWait ) ? ( *pxTicksToWait - tick_elapsed ) : 0;
+    }
+
+    return thread->error;
 }
 /*-----------------------------------------------------------*/
 
-#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+/*
+ * Resume the first thread on an IPC suspend list.  Must be called with
+ * interrupts disabled.  Returns the resumed thread, or RT_NULL if nothing was
+ * waiting.
+ */
+static rt_thread_t prvQueueWakeOne( rt_list_t * pxWaitList )
+{
+    rt_thread_t thread;
 
-    QueueHandle_t xQueueGenericCreateStatic( const UBaseType_t uxQueueLength,
-                                             const UBaseType_t uxItemSize,
-                                             uint8_t * pucQueueStorage,
-                                             StaticQueue_t * pxStaticQueue,
-                                             const uint8_t ucQueueType )
+    if ( rt_list_isempty( pxWaitList ) )
     {
-        Queue_t * pxNewQueue = NULL;
-        char name[RT_NAME_MAX] = {0};
+        return RT_NULL;
+    }
+    thread = rt_list_entry( pxWaitList->next, struct rt_thread, tlist );
+    thread->error = RT_EOK;
+    rt_thread_resume( thread );
+    vPortIsrYieldRequest( thread );
 
-        /* The StaticQueue_t structure and the queue storage area must be
-         * supplied. */
-        configASSERT( pxStaticQueue );
+    return thread;
+}
+/*-----------------------------------------------------------*/
 
-        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
-            ( pxStaticQueue != NULL ) &&
+/*
+ * Resume up to uxMaxThreads threads from the front of an IPC suspend list, one
+ * for each item a batch made available.  Must be called with interrupts
+ * disabled.  Returns the number of threads resumed.
+ */
+static UBaseType_t prvQueueWakeSome( rt_list_t * pxWaitList,
+                                     UBaseType_t uxMaxThreads )
+{
+    UBaseType_t uxWoken = 0;
 
-            /* A queue storage area should be provided if the item size is not 0, and
-             * should not be provided if the item size is 0. */
-            ( !( ( pucQueueStorage != NULL ) && ( uxItemSize == 0 ) ) ) &&
-            ( !( ( pucQueueStorage == NULL ) && ( uxItemSize != 0 ) ) ) )
+    while ( ( uxWoken < uxMaxThreads ) && ( prvQueueWakeOne( pxWaitList ) != RT_NULL ) )
+    {
+        uxWoken++;
+    }
+
+    return uxWoken;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Resume every thread on an IPC suspend list.  Pass -RT_ERROR when the object
+ * is reset or deleted, as the kernel does.  Must be called with interrupts
+ * disabled.
+ */
+static void prvQueueWakeAll( rt_list_t * pxWaitList,
+                             rt_err_t error )
+{
+    rt_thread_t thread;
+
+    while ( !rt_list_isempty( pxWaitList ) )
+    {
+        thread = rt_list_entry( pxWaitList->next, struct rt_thread, tlist );
+        thread->error = error;
+        rt_thread_resume( thread );
+        vPortIsrYieldRequest( thread );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Reschedule after resuming threads.  Inside a FromISR call with
+ * configUSE_DEFERRED_ISR_YIELD the wake ups have been recorded instead, and
+ * the switch is left to portYIELD_FROM_ISR().
+ */
+static void prvQueueSchedule( void )
+{
+    if ( xPortIsrYieldDeferred() == pdFALSE )
+    {
+        rt_schedule();
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Change the priority of a lock holder, for priority inheritance.
+ */
+static void prvQueueSetPriority( rt_thread_t thread,
+                                 rt_uint8_t priority )
+{
+    if ( thread->current_priority != priority )
+    {
+        rt_thread_control( thread, RT_THREAD_CTRL_CHANGE_PRIORITY, &priority );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Copy one item in or out of queue storage.  Small power of two sizes get a
+ * fixed size copy the compiler can turn into a single load and store.
+ */
+static void prvQueueCopyItem( void * pvDest,
+                              const void * pvSource,
+                              rt_uint16_t size )
+{
+    switch ( size )
+    {
+        case 1:
+            *( rt_uint8_t * ) pvDest = *( const rt_uint8_t * ) pvSource;
+            break;
+        case 2:
+            memcpy( pvDest, pvSource, 2 );
+            break;
+        case 4:
+            memcpy( pvDest, pvSource, 4 );
+            break;
+        case 8:
+            memcpy( pvDest, pvSource, 8 );
+            break;
+        default:
+            memcpy( pvDest, pvSource, size );
+            break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_RING_BUFFER == 1 )
+
+    static void prvRingInit( struct rt_ring_queue * ring,
+                             const char * name,
+                             rt_uint8_t * pool,
+                             UBaseType_t uxQueueLength,
+                             UBaseType_t uxItemSize )
+    {
+        rt_memset( ring, 0x00, sizeof( struct rt_ring_queue ) );
+        rt_strncpy( ring->parent.parent.name, name, RT_NAME_MAX );
+        ring->parent.parent.type = RT_Object_Class_MessageQueue | RT_Object_Class_Static;
+        rt_list_init( &( ring->parent.parent.list ) );
+        rt_list_init( &( ring->parent.suspend_thread ) );
+        rt_list_init( &( ring->suspend_sender_thread ) );
+        ring->msg_pool = pool;
+        ring->msg_size = ( rt_uint16_t ) uxItemSize;
+        ring->max_msgs = ( rt_uint16_t ) uxQueueLength;
+    }
+
+    static void prvRingReset( struct rt_ring_queue * ring )
+    {
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        prvQueueWakeAll( &( ring->parent.suspend_thread ), -RT_ERROR );
+        prvQueueWakeAll( &( ring->suspend_sender_thread ), -RT_ERROR );
+        ring->entry = 0;
+        ring->head = 0;
+        ring->tail = 0;
+        ring->send_reserved = 0;
+        ring->recv_reserved = 0;
+        rt_hw_interrupt_enable( level );
+        rt_schedule();
+    }
+
+    static void prvRingDetach( struct rt_ring_queue * ring )
+    {
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        prvQueueWakeAll( &( ring->parent.suspend_thread ), -RT_ERROR );
+        prvQueueWakeAll( &( ring->suspend_sender_thread ), -RT_ERROR );
+        ring->parent.parent.type = RT_Object_Class_Null;
+        rt_hw_interrupt_enable( level );
+        rt_schedule();
+    }
+
+/*
+ * Free slots.  A slot reserved through the zero-copy API is not free, even
+ * though it does not hold a message.
+ */
+    #define prvRingSpaces( ring )    ( ( ring )->max_msgs - ( ring )->entry - ( ring )->send_reserved - ( ring )->recv_reserved )
+
+/*
+ * Non-blocking send and receive.  Must be called with interrupts disabled.
+ * While a zero-copy send slot is outstanding the tail belongs to its owner,
+ * so other sends to the back wait; likewise an outstanding receive slot
+ * holds the head.
+ */
+    static rt_err_t prvRingSendLocked( struct rt_ring_queue * ring,
+                                       const void * pvItemToQueue,
+                                       const BaseType_t xCopyPosition )
+    {
+        if ( prvRingSpaces( ring ) == 0 )
         {
-            if ( ucQueueType == queueQUEUE_TYPE_RECURSIVE_MUTEX || ucQueueType == queueQUEUE_TYPE_MUTEX )
-            {
-                rt_snprintf( name, RT_NAME_MAX, "mutex%02d", mutex_index++ );
-                rt_mutex_init( ( rt_mutex_t ) &( ( StaticSemaphore_t * ) pxStaticQueue )->ipc_obj.mutex, name, RT_IPC_FLAG_PRIO );
-            }
-            else if ( ucQueueType == queueQUEUE_TYPE_BINARY_SEMAPHORE || ucQueueType == queueQUEUE_TYPE_COUNTING_SEMAPHORE )
-            {
-                rt_snprintf( name, RT_NAME_MAX, "sem%02d", sem_index++ );
-                rt_sem_init( ( rt_sem_t ) &( ( StaticSemaphore_t * ) pxStaticQueue )->ipc_obj.semaphore, name, 0, RT_IPC_FLAG_PRIO );
-                ( ( StaticSemaphore_t * ) pxStaticQueue )->ipc_obj.semaphore.max_value = uxQueueLength;
-            }
-            else if ( ucQueueType == queueQUEUE_TYPE_BASE )
+            return -RT_EFULL;
+        }
+        if ( xCopyPosition == queueSEND_TO_FRONT )
+        {
+            if ( ring->recv_reserved != 0 )
             {
-                rt_snprintf( name, RT_NAME_MAX, "queue%02d", queue_index++ );
-                rt_mq_init( &( pxStaticQueue->ipc_obj ), name, pucQueueStorage, uxItemSize, QUEUE_BUFFER_SIZE( uxQueueLength, uxItemSize ), RT_IPC_FLAG_PRIO );
+                return -RT_EFULL;
             }
-            else
+            ring->head = ( ring->head == 0 ) ? ( ring->max_msgs - 1 ) : ( ring->head - 1 );
+            prvQueueCopyItem( ring->msg_pool + ring->head * ring->msg_size, pvItemToQueue, ring->msg_size );
+        }
+        else
+        {
+            if ( ring->send_reserved != 0 )
             {
-                return pxNewQueue;
+                return -RT_EFULL;
             }
-            pxStaticQueue->rt_ipc = ( struct rt_ipc_object * ) &pxStaticQueue->ipc_obj;
-            pxNewQueue = ( QueueHandle_t ) pxStaticQueue;
+            prvQueueCopyItem( ring->msg_pool + ring->tail * ring->msg_size, pvItemToQueue, ring->msg_size );
+            ring->tail = ( ring->tail + 1 == ring->max_msgs ) ? 0 : ( ring->tail + 1 );
         }
+        ring->entry++;
 
-        return pxNewQueue;
+        return RT_EOK;
     }
 
-#endif /* configSUPPORT_STATIC_ALLOCATION */
-/*-----------------------------------------------------------*/
+    static rt_err_t prvRingReceiveLocked( struct rt_ring_queue * ring,
+                                          void * const pvBuffer )
+    {
+        if ( ( ring->entry == 0 ) || ( ring->recv_reserved != 0 ) )
+        {
+            return -RT_EEMPTY;
+        }
+        prvQueueCopyItem( pvBuffer, ring->msg_pool + ring->head * ring->msg_size, ring->msg_size );
+        ring->head = ( ring->head + 1 == ring->max_msgs ) ? 0 : ( ring->head + 1 );
+        ring->entry--;
 
-#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        return RT_EOK;
+    }
 
-    QueueHandle_t xQueueGenericCreate( const UBaseType_t uxQueueLength,
-                                       const UBaseType_t uxItemSize,
-                                       const uint8_t ucQueueType )
+    static rt_err_t prvRingSend( struct rt_ring_queue * ring,
+                                 const void * pvItemToQueue,
+                                 TickType_t xTicksToWait,
+                                 const BaseType_t xCopyPosition )
     {
-        Queue_t * pxNewQueue = NULL;
-        char name[RT_NAME_MAX] = {0};
-        struct rt_ipc_object * pipc = RT_NULL;
+        rt_thread_t thread;
+        rt_base_t level;
+        rt_err_t err;
 
-        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
-            /* Check for multiplication overflow. */
-            ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
-            /* Check for addition overflow. */
-            ( ( SIZE_MAX - sizeof( Queue_t ) ) >= ( uxQueueLength * uxItemSize ) ) )
+        level = rt_hw_interrupt_disable();
+        while ( ( err = prvRingSendLocked( ring, pvItemToQueue, xCopyPosition ) ) != RT_EOK )
         {
-            pxNewQueue = ( Queue_t * ) RT_KERNEL_MALLOC( sizeof( Queue_t ) );
-            if ( pxNewQueue == NULL )
+            if ( xTicksToWait == ( TickType_t ) 0 )
             {
-                return ( QueueHandle_t ) pxNewQueue;
+                rt_hw_interrupt_enable( level );
+                return err;
             }
-            if ( ucQueueType == queueQUEUE_TYPE_RECURSIVE_MUTEX || ucQueueType == queueQUEUE_TYPE_MUTEX )
+            err = prvQueueWait( &( ring->suspend_sender_thread ), &xTicksToWait, level );
+            if ( err != RT_EOK )
             {
-                rt_snprintf( name, RT_NAME_MAX, "mutex%02d", mutex_index++ );
-                pipc = ( struct rt_ipc_object * ) rt_mutex_create( name, RT_IPC_FLAG_PRIO );
+                return err;
             }
-            else if ( ucQueueType == queueQUEUE_TYPE_BINARY_SEMAPHORE || ucQueueType == queueQUEUE_TYPE_COUNTING_SEMAPHORE )
+            level = rt_hw_interrupt_disable();
+        }
+        thread = prvQueueWakeOne( &( ring->parent.suspend_thread ) );
+        rt_hw_interrupt_enable( level );
+
+        if ( thread != RT_NULL )
+        {
+            prvQueueSchedule();
+        }
+
+        return RT_EOK;
+    }
+
+    static rt_err_t prvRingReceive( struct rt_ring_queue * ring,
+                                    void * const pvBuffer,
+                                    TickType_t xTicksToWait )
+    {
+        rt_thread_t thread;
+        rt_base_t level;
+        rt_err_t err;
+
+        level = rt_hw_interrupt_disable();
+        while ( ( err = prvRingReceiveLocked( ring, pvBuffer ) ) != RT_EOK )
+        {
+            if ( xTicksToWait == ( TickType_t ) 0 )
             {
-                rt_snprintf( name, RT_NAME_MAX, "sem%02d", sem_index++ );
-                pipc = ( struct rt_ipc_object * ) RT_KERNEL_MALLOC( sizeof( struct rt_semaphore_wrapper ) );
-                if ( pipc != RT_NULL )
-                {
-                    rt_sem_init( ( rt_sem_t ) pipc, name, 0, RT_IPC_FLAG_PRIO );
-                    ( ( struct rt_semaphore_wrapper * ) pipc )->max_value = uxQueueLength;
-                    /* Mark as dynamic so we can distinguish in vQueueDelete */
-                    pipc->parent.type &= ~RT_Object_Class_Static;
-                }
+                rt_hw_interrupt_enable( level );
+                return err;
             }
-            else if ( ucQueueType == queueQUEUE_TYPE_BASE )
+            err = prvQueueWait( &( ring->parent.suspend_thread ), &xTicksToWait, level );
+            if ( err != RT_EOK )
             {
-                rt_snprintf( name, RT_NAME_MAX, "queue%02d", queue_index++ );
-                pipc = ( struct rt_ipc_object * ) rt_mq_create( name, uxItemSize, uxQueueLength, RT_IPC_FLAG_PRIO);
+                return err;
             }
+            level = rt_hw_interrupt_disable();
+        }
+        thread = prvQueueWakeOne( &( ring->suspend_sender_thread ) );
+        rt_hw_interrupt_enable( level );
 
-            if ( pipc == RT_NULL )
-            {
-                RT_KERNEL_FREE( pxNewQueue );
+        if ( thread != RT_NULL )
+        {
+            prvQueueSchedule();
+        }
+
+        return RT_EOK;
+    }
+
+/*
+ * Slot level access for the zero-copy API.  All four must be called with
+ * interrupts disabled.  Only one send slot and one receive slot can be
+ * outstanding at a time, because a ring slot cannot be published or
+ * recycled out of order.
+ */
+    static void * prvMqAllocSlot( MessageQueue_t * mq )
+    {
+        if ( ( prvRingSpaces( mq ) == 0 ) || ( mq->send_reserved != 0 ) )
+        {
+            return RT_NULL;
+        }
+        mq->send_reserved = 1;
+
+        return mq->msg_pool + mq->tail * mq->msg_size;
+    }
+
+    static void prvMqPostSlot( MessageQueue_t * mq,
+                               void * pvSlot )
+    {
+        RT_ASSERT( pvSlot == mq->msg_pool + mq->tail * mq->msg_size );
+        mq->tail = ( mq->tail + 1 == mq->max_msgs ) ? 0 : ( mq->tail + 1 );
+        mq->send_reserved = 0;
+        mq->entry++;
+    }
+
+    static void * prvMqTakeSlot( MessageQueue_t * mq )
+    {
+        if ( ( mq->entry == 0 ) || ( mq->recv_reserved != 0 ) )
+        {
+            return RT_NULL;
+        }
+        mq->recv_reserved = 1;
+        mq->entry--;
+
+        return mq->msg_pool + mq->head * mq->msg_size;
+    }
+
+    static void prvMqFreeSlot( MessageQueue_t * mq,
+                               void * pvSlot )
+    {
+        RT_ASSERT( pvSlot == mq->msg_pool + mq->head * mq->msg_size );
+        mq->head = ( mq->head + 1 == mq->max_msgs ) ? 0 : ( mq->head + 1 );
+        mq->recv_reserved = 0;
+    }
+
+/*
+ * The front message, left in place, or RT_NULL if the queue is empty.  Must
+ * be called with interrupts disabled.  A slot held by a zero-copy receiver has
+ * already left the queue, so the front message is the one after it.
+ */
+    static void * prvMqFrontSlot( MessageQueue_t * mq )
+    {
+        rt_uint32_t index;
+
+        if ( mq->entry == 0 )
+        {
+            return RT_NULL;
+        }
+        index = mq->head + mq->recv_reserved;
+        if ( index >= mq->max_msgs )
+        {
+            index -= mq->max_msgs;
+        }
+
+        return mq->msg_pool + index * mq->msg_size;
+    }
+
+#else /* configUSE_QUEUE_RING_BUFFER */
+
+/*
+ * Check that rt_mq_init() laid the pool out with headers of the size of
+ * QueueMessage_t.  It pushes every slot onto the free list in address order,
+ * each header linking to the one before it, so the free list starts at the
+ * last slot.  A kernel whose header differs fails here, when the queue is
+ * created, rather than corrupting it later.
+ */
+    static void prvMqCheckLayout( MessageQueue_t * mq )
+    {
+        const rt_size_t xStride = mq->msg_size + sizeof( QueueMessage_t );
+        QueueMessage_t * pxLast = ( QueueMessage_t * ) mq->msg_queue_free;
+
+        configASSERT( mq->max_msgs > 0 );
+        configASSERT( ( rt_uint8_t * ) pxLast == ( rt_uint8_t * ) mq->msg_pool + ( mq->max_msgs - 1 ) * xStride );
+        configASSERT( ( mq->max_msgs == 1 ) || ( ( rt_uint8_t * ) pxLast->pxNext == ( rt_uint8_t * ) pxLast - xStride ) );
+        ( void ) xStride;
+        ( void ) pxLast;
+    }
+
+/*
+ * Slot level access to an rt_messagequeue.  All five must be called with
+ * interrupts disabled.  A slot taken from the free list belongs to the caller
+ * until it is posted, and a slot taken from the message list belongs to the
+ * caller until it is freed.
+ */
+    static void * prvMqAllocSlot( MessageQueue_t * mq )
+    {
+        QueueMessage_t * pxMessage = ( QueueMessage_t * ) mq->msg_queue_free;
+
+        if ( pxMessage == RT_NULL )
+        {
+            return RT_NULL;
+        }
+        mq->msg_queue_free = pxMessage->pxNext;
+
+        return ( void * ) ( pxMessage + 1 );
+    }
+
+    static void prvMqPostSlot( MessageQueue_t * mq,
+                               void * pvSlot )
+    {
+        QueueMessage_t * pxMessage = ( QueueMessage_t * ) pvSlot - 1;
+
+    #if RT_VER_NUM >= 0x50001
+        pxMessage->xLength = mq->msg_size;
+    #endif
+    #ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+        pxMessage->lPriority = 0;
+    #endif
+        pxMessage->pxNext = RT_NULL;
+        if ( mq->msg_queue_tail != RT_NULL )
+        {
+            ( ( QueueMessage_t * ) mq->msg_queue_tail )->pxNext = pxMessage;
+        }
+        mq->msg_queue_tail = pxMessage;
+        if ( mq->msg_queue_head == RT_NULL )
+        {
+            mq->msg_queue_head = pxMessage;
+        }
+        mq->entry++;
+    }
+
+    static void prvMqPushSlot( MessageQueue_t * mq,
+                               void * pvSlot )
+    {
+        QueueMessage_t * pxMessage = ( QueueMessage_t * ) pvSlot - 1;
+
+    #if RT_VER_NUM >= 0x50001
+        pxMessage->xLength = mq->msg_size;
+    #endif
+    #ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+        pxMessage->lPriority = 0;
+    #endif
+        pxMessage->pxNext = ( QueueMessage_t * ) mq->msg_queue_head;
+        mq->msg_queue_head = pxMessage;
+        if ( mq->msg_queue_tail == RT_NULL )
+        {
+            mq->msg_queue_tail = pxMessage;
+        }
+        mq->entry++;
+    }
+
+    static void * prvMqTakeSlot( MessageQueue_t * mq )
+    {
+        QueueMessage_t * pxMessage = ( QueueMessage_t * ) mq->msg_queue_head;
+
+        if ( pxMessage == RT_NULL )
+        {
+            return RT_NULL;
+        }
+        mq->msg_queue_head = pxMessage->pxNext;
+        if ( mq->msg_queue_tail == pxMessage )
+        {
+            mq->msg_queue_tail = RT_NULL;
+        }
+        mq->entry--;
+
+        return ( void * ) ( pxMessage + 1 );
+    }
+
+    static void prvMqFreeSlot( MessageQueue_t * mq,
+                               void * pvSlot )
+    {
+        QueueMessage_t * pxMessage = ( QueueMessage_t * ) pvSlot - 1;
+
+        pxMessage->pxNext = ( QueueMessage_t * ) mq->msg_queue_free;
+        mq->msg_queue_free = pxMessage;
+    }
+
+/*
+ * The front message, left linked, or RT_NULL if the queue is empty.  Must be
+ * called with interrupts disabled.
+ */
+    static void * prvMqFrontSlot( MessageQueue_t * mq )
+    {
+        QueueMessage_t * pxMessage = ( QueueMessage_t * ) mq->msg_queue_head;
+
+        if ( pxMessage == RT_NULL )
+        {
+            return RT_NULL;
+        }
+
+        return ( void * ) ( pxMessage + 1 );
+    }
+
+/*
+ * rt_mq_urgent() fails at once when the queue is full.  Wait on the same
+ * suspended sender list that rt_mq_send_wait() uses, so rt_mq_recv() resumes
+ * us when a slot is freed, then try again.
+ */
+    static rt_err_t prvMqSendToFront( rt_mq_t mq,
+                                      const void * pvItemToQueue,
+                                      TickType_t xTicksToWait )
+    {
+        rt_base_t level;
+        rt_err_t err;
+
+        for ( ; ; )
+        {
+            level = rt_hw_interrupt_disable();
+            if ( mq->msg_queue_free != RT_NULL )
+            {
+                rt_hw_interrupt_enable( level );
+                err = rt_mq_urgent( mq, pvItemToQueue, mq->msg_size );
+                if ( err != -RT_EFULL )
+                {
+                    return err;
+                }
+                /* Another sender took the free slot first */
+                level = rt_hw_interrupt_disable();
+                if ( mq->msg_queue_free != RT_NULL )
+                {
+                    rt_hw_interrupt_enable( level );
+                    continue;
+                }
+            }
+            if ( xTicksToWait == ( TickType_t ) 0 )
+            {
+                rt_hw_interrupt_enable( level );
+                return -RT_EFULL;
+            }
+            err = prvQueueWait( &( mq->suspend_sender_thread ), &xTicksToWait, level );
+            if ( err != RT_EOK )
+            {
+                return err;
+            }
+        }
+    }
+
+/*
+ * Non-blocking send for FromISR calls that defer the context switch.
+ * rt_mq_send() and rt_mq_urgent() would reschedule on the spot, so the
+ * message is linked here and the receiver resumed with the switch recorded.
+ */
+    static rt_err_t prvMqSendDeferred( MessageQueue_t * mq,
+                                       const void * pvItemToQueue,
+                                       const BaseType_t xCopyPosition )
+    {
+        void * pvSlot;
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        pvSlot = prvMqAllocSlot( mq );
+        if ( pvSlot == RT_NULL )
+        {
+            rt_hw_interrupt_enable( level );
+            return -RT_EFULL;
+        }
+        prvQueueCopyItem( pvSlot, pvItemToQueue, mq->msg_size );
+        if ( xCopyPosition == queueSEND_TO_FRONT )
+        {
+            prvMqPushSlot( mq, pvSlot );
+        }
+        else
+        {
+            prvMqPostSlot( mq, pvSlot );
+        }
+        ( void ) prvQueueWakeOne( &( mq->parent.suspend_thread ) );
+        rt_hw_interrupt_enable( level );
+
+        return RT_EOK;
+    }
+
+#endif /* configUSE_QUEUE_RING_BUFFER */
+/*-----------------------------------------------------------*/
+
+/*
+ * Copy the front message of either message queue engine without removing it.
+ * The copy is made with interrupts disabled, so no receiver can recycle the
+ * slot underneath it.  A peeker is woken like a receiver but leaves the
+ * message in place, so the wake up is passed on to the next waiter, which
+ * may be a receiver.
+ */
+static rt_err_t prvMqPeek( MessageQueue_t * mq,
+                           void * const pvBuffer,
+                           TickType_t xTicksToWait )
+{
+    rt_thread_t thread;
+    void * pvSlot;
+    rt_base_t level;
+    rt_err_t err;
+
+    level = rt_hw_interrupt_disable();
+    while ( ( pvSlot = prvMqFrontSlot( mq ) ) == RT_NULL )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return -RT_EEMPTY;
+        }
+        err = prvQueueWait( &( mq->parent.suspend_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    prvQueueCopyItem( pvBuffer, pvSlot, mq->msg_size );
+    thread = prvQueueWakeOne( &( mq->parent.suspend_thread ) );
+    rt_hw_interrupt_enable( level );
+
+    if ( thread != RT_NULL )
+    {
+        prvQueueSchedule();
+    }
+
+    return RT_EOK;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * xQueueOverwrite() on a message queue of length one: replace the message in
+ * place if there is one, otherwise post it.  Never blocks.  *pxPosted tells
+ * whether the queue gained a message.
+ */
+static rt_err_t prvMqOverwrite( MessageQueue_t * mq,
+                                const void * pvItemToQueue,
+                                rt_bool_t * pxPosted )
+{
+    rt_thread_t thread = RT_NULL;
+    void * pvSlot;
+    rt_base_t level;
+
+    configASSERT( mq->max_msgs == 1 );
+
+    level = rt_hw_interrupt_disable();
+    pvSlot = prvMqFrontSlot( mq );
+    *pxPosted = ( pvSlot == RT_NULL );
+    if ( pvSlot != RT_NULL )
+    {
+        prvQueueCopyItem( pvSlot, pvItemToQueue, mq->msg_size );
+    }
+    else
+    {
+        /* Only fails while the slot is held through the zero-copy API */
+        pvSlot = prvMqAllocSlot( mq );
+        if ( pvSlot == RT_NULL )
+        {
+            rt_hw_interrupt_enable( level );
+            return -RT_EFULL;
+        }
+        prvQueueCopyItem( pvSlot, pvItemToQueue, mq->msg_size );
+        prvMqPostSlot( mq, pvSlot );
+        thread = prvQueueWakeOne( &( mq->parent.suspend_thread ) );
+    }
+    rt_hw_interrupt_enable( level );
+
+    if ( thread != RT_NULL )
+    {
+        prvQueueSchedule();
+    }
+
+    return RT_EOK;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Batched send and receive for either message queue engine.  Block until the
+ * first item can be moved, then move as many of the rest as fit without
+ * blocking again, all in one interrupt-disabled section.  One waiter is
+ * resumed for each item moved, with a single reschedule for the batch.
+ * Return the number of items moved.
+ */
+static UBaseType_t prvMqSendMultiple( MessageQueue_t * mq,
+                                      const rt_uint8_t * pucItems,
+                                      UBaseType_t uxItemCount,
+                                      TickType_t xTicksToWait )
+{
+    UBaseType_t uxCount = 0;
+    UBaseType_t uxWoken;
+    void * pvSlot;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    while ( ( pvSlot = prvMqAllocSlot( mq ) ) == RT_NULL )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return 0;
+        }
+        if ( prvQueueWait( &( mq->suspend_sender_thread ), &xTicksToWait, level ) != RT_EOK )
+        {
+            return 0;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    do
+    {
+        prvQueueCopyItem( pvSlot, pucItems, mq->msg_size );
+        prvMqPostSlot( mq, pvSlot );
+        pucItems += mq->msg_size;
+        uxCount++;
+    } while ( ( uxCount < uxItemCount ) && ( ( pvSlot = prvMqAllocSlot( mq ) ) != RT_NULL ) );
+    uxWoken = prvQueueWakeSome( &( mq->parent.suspend_thread ), uxCount );
+    rt_hw_interrupt_enable( level );
+
+    if ( uxWoken != 0 )
+    {
+        prvQueueSchedule();
+    }
+
+    return uxCount;
+}
+
+static UBaseType_t prvMqReceiveMultiple( MessageQueue_t * mq,
+                                         rt_uint8_t * pucBuffer,
+                                         UBaseType_t uxMaxItems,
+                                         TickType_t xTicksToWait )
+{
+    UBaseType_t uxCount = 0;
+    UBaseType_t uxWoken;
+    void * pvSlot;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    while ( ( pvSlot = prvMqTakeSlot( mq ) ) == RT_NULL )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return 0;
+        }
+        if ( prvQueueWait( &( mq->parent.suspend_thread ), &xTicksToWait, level ) != RT_EOK )
+        {
+            return 0;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    do
+    {
+        prvQueueCopyItem( pucBuffer, pvSlot, mq->msg_size );
+        prvMqFreeSlot( mq, pvSlot );
+        pucBuffer += mq->msg_size;
+        uxCount++;
+    } while ( ( uxCount < uxMaxItems ) && ( ( pvSlot = prvMqTakeSlot( mq ) ) != RT_NULL ) );
+    uxWoken = prvQueueWakeSome( &( mq->suspend_sender_thread ), uxCount );
+    rt_hw_interrupt_enable( level );
+
+    if ( uxWoken != 0 )
+    {
+        prvQueueSchedule();
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Single producer, single consumer queues.  The producer owns tail and the
+ * consumer owns head, so neither side needs a lock to move items: publishing
+ * an index with release ordering makes the item copied before it visible to
+ * the other side.  Interrupts are only masked to block or to wake a blocked
+ * task, and a task is only woken on the empty to not empty (or full to not
+ * full) transition.  Waiters recheck the indices with interrupts masked
+ * before blocking.  On SMP each index store is fenced, so of a waiter and the
+ * other side at least one sees the other's store, and the wait list is then
+ * checked under the lock; see queueMAY_HAVE_WAITERS().
+ */
+#define prvSpscNext( spsc, ulIndex )    ( ( ( ulIndex ) + 1U == 2U * ( spsc )->max_msgs ) ? 0U : ( ( ulIndex ) + 1U ) )
+
+static rt_uint32_t prvSpscCount( const struct rt_spsc_queue * spsc,
+                                 rt_uint32_t ulTail,
+                                 rt_uint32_t ulHead )
+{
+    return ( ulTail >= ulHead ) ? ( ulTail - ulHead ) : ( ulTail + 2U * spsc->max_msgs - ulHead );
+}
+
+static rt_uint8_t * prvSpscSlot( const struct rt_spsc_queue * spsc,
+                                 rt_uint32_t ulIndex )
+{
+    if ( ulIndex >= spsc->max_msgs )
+    {
+        ulIndex -= spsc->max_msgs;
+    }
+
+    return spsc->msg_pool + ulIndex * spsc->msg_size;
+}
+
+static void prvSpscWake( rt_list_t * pxWaitList )
+{
+    rt_thread_t thread;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    thread = prvQueueWakeOne( pxWaitList );
+    rt_hw_interrupt_enable( level );
+
+    if ( thread != RT_NULL )
+    {
+        prvQueueSchedule();
+    }
+}
+
+static void prvSpscInit( struct rt_spsc_queue * spsc,
+                         const char * name,
+                         rt_uint8_t * pool,
+                         UBaseType_t uxQueueLength,
+                         UBaseType_t uxItemSize )
+{
+    rt_memset( spsc, 0x00, sizeof( struct rt_spsc_queue ) );
+    rt_strncpy( spsc->parent.parent.name, name, RT_NAME_MAX );
+    spsc->parent.parent.type = RT_Object_Class_MessageQueue | RT_Object_Class_Static;
+    rt_list_init( &( spsc->parent.parent.list ) );
+    rt_list_init( &( spsc->parent.suspend_thread ) );
+    rt_list_init( &( spsc->suspend_sender_thread ) );
+    spsc->msg_pool = pool;
+    spsc->msg_size = ( rt_uint16_t ) uxItemSize;
+    spsc->max_msgs = ( rt_uint16_t ) uxQueueLength;
+}
+
+/*
+ * Reset and delete are not lock-free: neither the producer nor the consumer
+ * may be using the queue while they run.
+ */
+static void prvSpscReset( struct rt_spsc_queue * spsc,
+                          rt_bool_t xDetach )
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    prvQueueWakeAll( &( spsc->parent.suspend_thread ), -RT_ERROR );
+    prvQueueWakeAll( &( spsc->suspend_sender_thread ), -RT_ERROR );
+    spsc->head = 0;
+    spsc->tail = 0;
+    if ( xDetach )
+    {
+        spsc->parent.parent.type = RT_Object_Class_Null;
+    }
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+}
+
+static rt_err_t prvSpscSend( struct rt_spsc_queue * spsc,
+                             const void * pvItemToQueue,
+                             TickType_t xTicksToWait )
+{
+    rt_uint32_t ulTail = spsc->tail;
+    rt_base_t level;
+    rt_err_t err;
+
+    while ( prvSpscCount( spsc, ulTail, portATOMIC_LOAD_ACQUIRE( &( spsc->head ) ) ) == spsc->max_msgs )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            return -RT_EFULL;
+        }
+        level = rt_hw_interrupt_disable();
+        if ( prvSpscCount( spsc, ulTail, portATOMIC_LOAD_ACQUIRE( &( spsc->head ) ) ) != spsc->max_msgs )
+        {
+            rt_hw_interrupt_enable( level );
+            break;
+        }
+        err = prvQueueWait( &( spsc->suspend_sender_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+    }
+
+    prvQueueCopyItem( prvSpscSlot( spsc, ulTail ), pvItemToQueue, spsc->msg_size );
+    portATOMIC_STORE_RELEASE( &( spsc->tail ), prvSpscNext( spsc, ulTail ) );
+    queueSMP_MEMORY_BARRIER();
+
+    /* The item just published is the only one queued, so the consumer may be
+     * waiting for it. */
+    if ( ( portATOMIC_LOAD_ACQUIRE( &( spsc->head ) ) == ulTail ) &&
+         queueMAY_HAVE_WAITERS( &( spsc->parent.suspend_thread ) ) )
+    {
+        prvSpscWake( &( spsc->parent.suspend_thread ) );
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t prvSpscReceive( struct rt_spsc_queue * spsc,
+                                void * const pvBuffer,
+                                TickType_t xTicksToWait,
+                                const BaseType_t xJustPeeking )
+{
+    rt_uint32_t ulHead = spsc->head;
+    rt_base_t level;
+    rt_err_t err;
+
+    while ( portATOMIC_LOAD_ACQUIRE( &( spsc->tail ) ) == ulHead )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            return -RT_EEMPTY;
+        }
+        level = rt_hw_interrupt_disable();
+        if ( portATOMIC_LOAD_ACQUIRE( &( spsc->tail ) ) != ulHead )
+        {
+            rt_hw_interrupt_enable( level );
+            break;
+        }
+        err = prvQueueWait( &( spsc->parent.suspend_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+    }
+
+    prvQueueCopyItem( pvBuffer, prvSpscSlot( spsc, ulHead ), spsc->msg_size );
+    if ( xJustPeeking != pdFALSE )
+    {
+        /* Peeking is a consumer operation, so head cannot move under us */
+        return RT_EOK;
+    }
+    portATOMIC_STORE_RELEASE( &( spsc->head ), prvSpscNext( spsc, ulHead ) );
+    queueSMP_MEMORY_BARRIER();
+
+    /* The queue was full until this item was taken, so the producer may be
+     * waiting for space. */
+    if ( ( prvSpscCount( spsc, portATOMIC_LOAD_ACQUIRE( &( spsc->tail ) ), ulHead ) == spsc->max_msgs ) &&
+         queueMAY_HAVE_WAITERS( &( spsc->suspend_sender_thread ) ) )
+    {
+        prvSpscWake( &( spsc->suspend_sender_thread ) );
+    }
+
+    return RT_EOK;
+}
+
+/*
+ * Batched versions of the above.  The items are copied first and published
+ * with a single index store, so the other side sees the whole batch at once
+ * and is woken at most once.
+ */
+static UBaseType_t prvSpscSendMultiple( struct rt_spsc_queue * spsc,
+                                        const rt_uint8_t * pucItems,
+                                        UBaseType_t uxItemCount,
+                                        TickType_t xTicksToWait )
+{
+    rt_uint32_t ulTail = spsc->tail;
+    rt_uint32_t ulIndex = ulTail;
+    UBaseType_t uxSpaces;
+    UBaseType_t uxCount;
+    rt_base_t level;
+
+    while ( ( uxSpaces = spsc->max_msgs - prvSpscCount( spsc, ulTail, portATOMIC_LOAD_ACQUIRE( &( spsc->head ) ) ) ) == 0 )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            return 0;
+        }
+        level = rt_hw_interrupt_disable();
+        if ( prvSpscCount( spsc, ulTail, portATOMIC_LOAD_ACQUIRE( &( spsc->head ) ) ) != spsc->max_msgs )
+        {
+            rt_hw_interrupt_enable( level );
+            continue;
+        }
+        if ( prvQueueWait( &( spsc->suspend_sender_thread ), &xTicksToWait, level ) != RT_EOK )
+        {
+            return 0;
+        }
+    }
+
+    uxCount = ( uxItemCount < uxSpaces ) ? uxItemCount : uxSpaces;
+    for ( uxSpaces = 0; uxSpaces < uxCount; uxSpaces++ )
+    {
+        prvQueueCopyItem( prvSpscSlot( spsc, ulIndex ), pucItems, spsc->msg_size );
+        pucItems += spsc->msg_size;
+        ulIndex = prvSpscNext( spsc, ulIndex );
+    }
+    portATOMIC_STORE_RELEASE( &( spsc->tail ), ulIndex );
+    queueSMP_MEMORY_BARRIER();
+
+    if ( ( portATOMIC_LOAD_ACQUIRE( &( spsc->head ) ) == ulTail ) &&
+         queueMAY_HAVE_WAITERS( &( spsc->parent.suspend_thread ) ) )
+    {
+        prvSpscWake( &( spsc->parent.suspend_thread ) );
+    }
+
+    return uxCount;
+}
+
+static UBaseType_t prvSpscReceiveMultiple( struct rt_spsc_queue * spsc,
+                                           rt_uint8_t * pucBuffer,
+                                           UBaseType_t uxMaxItems,
+                                           TickType_t xTicksToWait )
+{
+    rt_uint32_t ulHead = spsc->head;
+    rt_uint32_t ulIndex = ulHead;
+    UBaseType_t uxWaiting;
+    UBaseType_t uxCount;
+    rt_base_t level;
+
+    while ( ( uxWaiting = prvSpscCount( spsc, portATOMIC_LOAD_ACQUIRE( &( spsc->tail ) ), ulHead ) ) == 0 )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            return 0;
+        }
+        level = rt_hw_interrupt_disable();
+        if ( portATOMIC_LOAD_ACQUIRE( &( spsc->tail ) ) != ulHead )
+        {
+            rt_hw_interrupt_enable( level );
+            continue;
+        }
+        if ( prvQueueWait( &( spsc->parent.suspend_thread ), &xTicksToWait, level ) != RT_EOK )
+        {
+            return 0;
+        }
+    }
+
+    uxCount = ( uxMaxItems < uxWaiting ) ? uxMaxItems : uxWaiting;
+    for ( uxWaiting = 0; uxWaiting < uxCount; uxWaiting++ )
+    {
+        prvQueueCopyItem( pucBuffer, prvSpscSlot( spsc, ulIndex ), spsc->msg_size );
+        pucBuffer += spsc->msg_size;
+        ulIndex = prvSpscNext( spsc, ulIndex );
+    }
+    portATOMIC_STORE_RELEASE( &( spsc->head ), ulIndex );
+    queueSMP_MEMORY_BARRIER();
+
+    /* Wake the producer if the queue was full when the batch was taken */
+    if ( ( prvSpscCount( spsc, portATOMIC_LOAD_ACQUIRE( &( spsc->tail ) ), ulHead ) == spsc->max_msgs ) &&
+         queueMAY_HAVE_WAITERS( &( spsc->suspend_sender_thread ) ) )
+    {
+        prvSpscWake( &( spsc->suspend_sender_thread ) );
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Mailboxes: queues of length one that hold the latest value.  Writers mask
+ * interrupts, so they never block and never race each other.  They bump the
+ * sequence counter to odd before touching the value and back to even after.
+ * A peek copies the value without masking interrupts and retries if the
+ * counter was odd or moved while it copied.  Only receiving (which empties
+ * the mailbox) and blocking take the interrupt lock on the reader side.
+ */
+static void prvMailboxInit( struct rt_mailbox_queue * mb,
+                            const char * name,
+                            rt_uint8_t * pool,
+                            UBaseType_t uxItemSize )
+{
+    rt_memset( mb, 0x00, sizeof( struct rt_mailbox_queue ) );
+    rt_strncpy( mb->parent.parent.name, name, RT_NAME_MAX );
+    mb->parent.parent.type = RT_Object_Class_MessageQueue | RT_Object_Class_Static;
+    rt_list_init( &( mb->parent.parent.list ) );
+    rt_list_init( &( mb->parent.suspend_thread ) );
+    rt_list_init( &( mb->suspend_sender_thread ) );
+    mb->msg_pool = pool;
+    mb->msg_size = ( rt_uint16_t ) uxItemSize;
+}
+
+/*
+ * Store a new value, or empty the mailbox if pvItemToQueue is NULL.  Must be
+ * called with interrupts disabled.
+ */
+static void prvMailboxWriteLocked( struct rt_mailbox_queue * mb,
+                                   const void * pvItemToQueue )
+{
+    rt_uint32_t ulSequence = mb->sequence;
+
+    mb->sequence = ulSequence + 1U;
+    portMEMORY_BARRIER();
+    if ( pvItemToQueue != NULL )
+    {
+        prvQueueCopyItem( mb->msg_pool, pvItemToQueue, mb->msg_size );
+        mb->full = 1;
+    }
+    else
+    {
+        mb->full = 0;
+    }
+    portATOMIC_STORE_RELEASE( &( mb->sequence ), ulSequence + 2U );
+}
+
+static rt_bool_t prvMailboxTryPeek( struct rt_mailbox_queue * mb,
+                                    void * const pvBuffer )
+{
+    rt_uint32_t ulSequence;
+    rt_uint8_t full;
+
+    do
+    {
+        ulSequence = portATOMIC_LOAD_ACQUIRE( &( mb->sequence ) );
+        full = mb->full;
+        if ( full )
+        {
+            prvQueueCopyItem( pvBuffer, mb->msg_pool, mb->msg_size );
+        }
+        portMEMORY_BARRIER();
+    } while ( ( ( ulSequence & 1U ) != 0U ) || ( mb->sequence != ulSequence ) );
+
+    return full ? RT_TRUE : RT_FALSE;
+}
+
+static void prvMailboxReset( struct rt_mailbox_queue * mb,
+                             rt_bool_t xDetach )
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    prvQueueWakeAll( &( mb->parent.suspend_thread ), -RT_ERROR );
+    prvQueueWakeAll( &( mb->suspend_sender_thread ), -RT_ERROR );
+    prvMailboxWriteLocked( mb, NULL );
+    if ( xDetach )
+    {
+        mb->parent.parent.type = RT_Object_Class_Null;
+    }
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+}
+
+/*
+ * queueOVERWRITE never blocks.  Sending to the front or back of a full
+ * mailbox waits for a receiver to empty it, as it would for any queue of
+ * length one.  Every blocked reader is woken, since peekers all want the new
+ * value.  *pxPosted tells whether the mailbox was empty.
+ */
+static rt_err_t prvMailboxSend( struct rt_mailbox_queue * mb,
+                                const void * pvItemToQueue,
+                                TickType_t xTicksToWait,
+                                const BaseType_t xCopyPosition,
+                                rt_bool_t * pxPosted )
+{
+    rt_bool_t xWaiters;
+    rt_base_t level;
+    rt_err_t err;
+
+    level = rt_hw_interrupt_disable();
+    while ( ( xCopyPosition != queueOVERWRITE ) && mb->full )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return -RT_EFULL;
+        }
+        err = prvQueueWait( &( mb->suspend_sender_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    *pxPosted = !mb->full;
+    prvMailboxWriteLocked( mb, pvItemToQueue );
+    xWaiters = !rt_list_isempty( &( mb->parent.suspend_thread ) );
+    prvQueueWakeAll( &( mb->parent.suspend_thread ), RT_EOK );
+    rt_hw_interrupt_enable( level );
+
+    if ( xWaiters )
+    {
+        prvQueueSchedule();
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t prvMailboxReceive( struct rt_mailbox_queue * mb,
+                                   void * const pvBuffer,
+                                   TickType_t xTicksToWait,
+                                   const BaseType_t xJustPeeking )
+{
+    rt_thread_t thread = RT_NULL;
+    rt_base_t level;
+    rt_err_t err;
+
+    if ( ( xJustPeeking != pdFALSE ) && prvMailboxTryPeek( mb, pvBuffer ) )
+    {
+        return RT_EOK;
+    }
+
+    level = rt_hw_interrupt_disable();
+    while ( !mb->full )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return -RT_EEMPTY;
+        }
+        err = prvQueueWait( &( mb->parent.suspend_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    prvQueueCopyItem( pvBuffer, mb->msg_pool, mb->msg_size );
+    if ( xJustPeeking == pdFALSE )
+    {
+        prvMailboxWriteLocked( mb, NULL );
+        thread = prvQueueWakeOne( &( mb->suspend_sender_thread ) );
+    }
+    rt_hw_interrupt_enable( level );
+
+    if ( thread != RT_NULL )
+    {
+        prvQueueSchedule();
+    }
+
+    return RT_EOK;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Priority queues: every item carries a priority level and receivers always
+ * get the oldest item of the highest level held.  Free slots and the items of
+ * each level are FIFOs of slot indexes linked through next[], so a send or a
+ * receive only touches the ends of two lists, and the highest non-empty level
+ * is read from the ready bitmap with one __rt_ffs().  Higher levels use lower
+ * bits for that reason.  Blocking works as for the ring buffer queue.
+ */
+#define queuePRIORITY_NONE                  ( ( rt_uint16_t ) 0xFFFFU )
+#define prvPriorityBit( uxLevel )           ( ( rt_uint32_t ) 1U << ( 31U - ( uxLevel ) ) )
+
+/* Return every slot to the free list.  Must be called with interrupts
+ * disabled. */
+static void prvPriorityEmptyLocked( struct rt_priority_queue * pq )
+{
+    rt_uint16_t i;
+
+    for ( i = 0; i < pq->max_msgs; i++ )
+    {
+        pq->next[ i ] = ( i + 1 == pq->max_msgs ) ? queuePRIORITY_NONE : ( rt_uint16_t ) ( i + 1 );
+    }
+    for ( i = 0; i < pq->levels; i++ )
+    {
+        pq->head[ i ] = queuePRIORITY_NONE;
+        pq->tail[ i ] = queuePRIORITY_NONE;
+    }
+    pq->free = 0;
+    pq->entry = 0;
+    pq->ready = 0;
+}
+
+static void prvPriorityInit( struct rt_priority_queue * pq,
+                             const char * name,
+                             rt_uint8_t * pool,
+                             UBaseType_t uxQueueLength,
+                             UBaseType_t uxItemSize,
+                             UBaseType_t uxPriorityLevels )
+{
+    rt_memset( pq, 0x00, sizeof( struct rt_priority_queue ) );
+    rt_strncpy( pq->parent.parent.name, name, RT_NAME_MAX );
+    pq->parent.parent.type = RT_Object_Class_MessageQueue | RT_Object_Class_Static;
+    rt_list_init( &( pq->parent.parent.list ) );
+    rt_list_init( &( pq->parent.suspend_thread ) );
+    rt_list_init( &( pq->suspend_sender_thread ) );
+    pq->msg_pool = pool;
+    pq->next = ( rt_uint16_t * ) ( pool + RT_ALIGN( uxQueueLength * uxItemSize, sizeof( rt_uint16_t ) ) );
+    pq->head = pq->next + uxQueueLength;
+    pq->tail = pq->head + uxPriorityLevels;
+    pq->msg_size = ( rt_uint16_t ) uxItemSize;
+    pq->max_msgs = ( rt_uint16_t ) uxQueueLength;
+    pq->levels = ( rt_uint8_t ) uxPriorityLevels;
+    prvPriorityEmptyLocked( pq );
+}
+
+static void prvPriorityReset( struct rt_priority_queue * pq,
+                              rt_bool_t xDetach )
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    prvQueueWakeAll( &( pq->parent.suspend_thread ), -RT_ERROR );
+    prvQueueWakeAll( &( pq->suspend_sender_thread ), -RT_ERROR );
+    prvPriorityEmptyLocked( pq );
+    if ( xDetach )
+    {
+        pq->parent.parent.type = RT_Object_Class_Null;
+    }
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+}
+
+/*
+ * Non-blocking send and receive.  Must be called with interrupts disabled.
+ * queueSEND_TO_BACK sends with level 0 and queueSEND_TO_FRONT puts the item
+ * at the front of the highest level, so that it is received next.
+ */
+static rt_err_t prvPrioritySendLocked( struct rt_priority_queue * pq,
+                                       const void * pvItemToQueue,
+                                       const BaseType_t xCopyPosition )
+{
+    UBaseType_t uxLevel = 0;
+    rt_uint16_t usSlot;
+
+    if ( xCopyPosition == queueSEND_TO_FRONT )
+    {
+        uxLevel = pq->levels - 1U;
+    }
+    else if ( xCopyPosition >= queueSEND_WITH_PRIORITY( 0 ) )
+    {
+        uxLevel = ( UBaseType_t ) ( xCopyPosition - queueSEND_WITH_PRIORITY( 0 ) );
+        configASSERT( uxLevel < pq->levels );
+        if ( uxLevel >= pq->levels )
+        {
+            uxLevel = pq->levels - 1U;
+        }
+    }
+    if ( pq->free == queuePRIORITY_NONE )
+    {
+        return -RT_EFULL;
+    }
+    usSlot = pq->free;
+    pq->free = pq->next[ usSlot ];
+    prvQueueCopyItem( pq->msg_pool + usSlot * pq->msg_size, pvItemToQueue, pq->msg_size );
+    if ( xCopyPosition == queueSEND_TO_FRONT )
+    {
+        pq->next[ usSlot ] = pq->head[ uxLevel ];
+        if ( pq->head[ uxLevel ] == queuePRIORITY_NONE )
+        {
+            pq->tail[ uxLevel ] = usSlot;
+        }
+        pq->head[ uxLevel ] = usSlot;
+    }
+    else
+    {
+        pq->next[ usSlot ] = queuePRIORITY_NONE;
+        if ( pq->tail[ uxLevel ] == queuePRIORITY_NONE )
+        {
+            pq->head[ uxLevel ] = usSlot;
+        }
+        else
+        {
+            pq->next[ pq->tail[ uxLevel ] ] = usSlot;
+        }
+        pq->tail[ uxLevel ] = usSlot;
+    }
+    pq->ready |= prvPriorityBit( uxLevel );
+    pq->entry++;
+
+    return RT_EOK;
+}
+
+static rt_err_t prvPriorityReceiveLocked( struct rt_priority_queue * pq,
+                                          void * const pvBuffer,
+                                          const BaseType_t xJustPeeking )
+{
+    UBaseType_t uxLevel;
+    rt_uint16_t usSlot;
+
+    if ( pq->ready == 0U )
+    {
+        return -RT_EEMPTY;
+    }
+    uxLevel = 32U - ( UBaseType_t ) __rt_ffs( ( int ) pq->ready );
+    usSlot = pq->head[ uxLevel ];
+    prvQueueCopyItem( pvBuffer, pq->msg_pool + usSlot * pq->msg_size, pq->msg_size );
+    if ( xJustPeeking == pdFALSE )
+    {
+        pq->head[ uxLevel ] = pq->next[ usSlot ];
+        if ( pq->head[ uxLevel ] == queuePRIORITY_NONE )
+        {
+            pq->tail[ uxLevel ] = queuePRIORITY_NONE;
+            pq->ready &= ~prvPriorityBit( uxLevel );
+        }
+        pq->next[ usSlot ] = pq->free;
+        pq->free = usSlot;
+        pq->entry--;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t prvPrioritySend( struct rt_priority_queue * pq,
+                                 const void * pvItemToQueue,
+                                 TickType_t xTicksToWait,
+                                 const BaseType_t xCopyPosition )
+{
+    rt_thread_t thread;
+    rt_base_t level;
+    rt_err_t err;
+
+    configASSERT( xCopyPosition != queueOVERWRITE );
+
+    level = rt_hw_interrupt_disable();
+    while ( ( err = prvPrioritySendLocked( pq, pvItemToQueue, xCopyPosition ) ) != RT_EOK )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return err;
+        }
+        err = prvQueueWait( &( pq->suspend_sender_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    thread = prvQueueWakeOne( &( pq->parent.suspend_thread ) );
+    rt_hw_interrupt_enable( level );
+
+    if ( thread != RT_NULL )
+    {
+        prvQueueSchedule();
+    }
+
+    return RT_EOK;
+}
+
+/*
+ * A peeker is woken like a receiver but leaves the item in place, so the wake
+ * up is passed on to the next waiter, as prvMqPeek() does.
+ */
+static rt_err_t prvPriorityReceive( struct rt_priority_queue * pq,
+                                    void * const pvBuffer,
+                                    TickType_t xTicksToWait,
+                                    const BaseType_t xJustPeeking )
+{
+    rt_thread_t thread;
+    rt_base_t level;
+    rt_err_t err;
+
+    level = rt_hw_interrupt_disable();
+    while ( ( err = prvPriorityReceiveLocked( pq, pvBuffer, xJustPeeking ) ) != RT_EOK )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return err;
+        }
+        err = prvQueueWait( &( pq->parent.suspend_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    if ( xJustPeeking != pdFALSE )
+    {
+        thread = prvQueueWakeOne( &( pq->parent.suspend_thread ) );
+    }
+    else
+    {
+        thread = prvQueueWakeOne( &( pq->suspend_sender_thread ) );
+    }
+    rt_hw_interrupt_enable( level );
+
+    if ( thread != RT_NULL )
+    {
+        prvQueueSchedule();
+    }
+
+    return RT_EOK;
+}
+
+/* Batches are sent with level 0 and received in priority order. */
+static UBaseType_t prvPrioritySendMultiple( struct rt_priority_queue * pq,
+                                            const rt_uint8_t * pucItems,
+                                            UBaseType_t uxItemCount,
+                                            TickType_t xTicksToWait )
+{
+    UBaseType_t uxCount = 0;
+    UBaseType_t uxWoken;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    while ( pq->free == queuePRIORITY_NONE )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return 0;
+        }
+        if ( prvQueueWait( &( pq->suspend_sender_thread ), &xTicksToWait, level ) != RT_EOK )
+        {
+            return 0;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    while ( ( uxCount < uxItemCount ) && ( prvPrioritySendLocked( pq, pucItems, queueSEND_TO_BACK ) == RT_EOK ) )
+    {
+        pucItems += pq->msg_size;
+        uxCount++;
+    }
+    uxWoken = prvQueueWakeSome( &( pq->parent.suspend_thread ), uxCount );
+    rt_hw_interrupt_enable( level );
+
+    if ( uxWoken != 0 )
+    {
+        prvQueueSchedule();
+    }
+
+    return uxCount;
+}
+
+static UBaseType_t prvPriorityReceiveMultiple( struct rt_priority_queue * pq,
+                                               rt_uint8_t * pucBuffer,
+                                               UBaseType_t uxMaxItems,
+                                               TickType_t xTicksToWait )
+{
+    UBaseType_t uxCount = 0;
+    UBaseType_t uxWoken;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    while ( pq->ready == 0U )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return 0;
+        }
+        if ( prvQueueWait( &( pq->parent.suspend_thread ), &xTicksToWait, level ) != RT_EOK )
+        {
+            return 0;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    while ( ( uxCount < uxMaxItems ) && ( prvPriorityReceiveLocked( pq, pucBuffer, pdFALSE ) == RT_EOK ) )
+    {
+        pucBuffer += pq->msg_size;
+        uxCount++;
+    }
+    uxWoken = prvQueueWakeSome( &( pq->suspend_sender_thread ), uxCount );
+    rt_hw_interrupt_enable( level );
+
+    if ( uxWoken != 0 )
+    {
+        prvQueueSchedule();
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Broadcast queues: one ring read by every subscriber.  A send copies the item
+ * once and wakes the reader of each subscriber.  The ring is full when the
+ * slowest subscriber is max_msgs items behind; then the policy decides
+ * whether the writer waits, the new item is dropped, or the subscribers that
+ * are that far behind lose their oldest item.  Subscribers are few, so the
+ * slowest one is found by walking the list.  Everything runs with interrupts
+ * disabled, as for the ring buffer queue.  Indexes run over twice the length,
+ * so that a full ring and an empty one differ, and are wrapped as they go, so
+ * finding a slot takes a compare rather than a division.
+ */
+#define prvBroadcastNext( bq, ulIndex )    ( ( ( ulIndex ) + 1U == 2U * ( bq )->max_msgs ) ? 0U : ( ( ulIndex ) + 1U ) )
+#define prvBroadcastSlot( bq, ulIndex )    ( ( bq )->msg_pool + ( ( ( ulIndex ) < ( bq )->max_msgs ) ? ( ulIndex ) : ( ( ulIndex ) - ( bq )->max_msgs ) ) * ( bq )->msg_size )
+
+/* Items a subscriber at ulCursor has left to read. */
+static rt_uint32_t prvBroadcastCount( const struct rt_broadcast_queue * bq,
+                                      rt_uint32_t ulCursor )
+{
+    return ( bq->tail >= ulCursor ) ? ( bq->tail - ulCursor ) : ( bq->tail + 2U * bq->max_msgs - ulCursor );
+}
+
+static void prvBroadcastInit( struct rt_broadcast_queue * bq,
+                              const char * name,
+                              rt_uint8_t * pool,
+                              UBaseType_t uxQueueLength,
+                              UBaseType_t uxItemSize,
+                              uint8_t ucPolicy )
+{
+    rt_memset( bq, 0x00, sizeof( struct rt_broadcast_queue ) );
+    rt_strncpy( bq->parent.parent.name, name, RT_NAME_MAX );
+    bq->parent.parent.type = RT_Object_Class_MessageQueue | RT_Object_Class_Static;
+    rt_list_init( &( bq->parent.parent.list ) );
+    rt_list_init( &( bq->parent.suspend_thread ) );
+    rt_list_init( &( bq->subscribers ) );
+    rt_list_init( &( bq->suspend_sender_thread ) );
+    bq->msg_pool = pool;
+    bq->msg_size = ( rt_uint16_t ) uxItemSize;
+    bq->max_msgs = ( rt_uint16_t ) uxQueueLength;
+    bq->policy = ucPolicy;
+}
+
+static void prvSubscriberInit( struct rt_broadcast_subscriber * sub,
+                               const char * name )
+{
+    rt_memset( sub, 0x00, sizeof( struct rt_broadcast_subscriber ) );
+    rt_strncpy( sub->parent.parent.name, name, RT_NAME_MAX );
+    sub->parent.parent.type = RT_Object_Class_MessageQueue | RT_Object_Class_Static;
+    rt_list_init( &( sub->parent.parent.list ) );
+    rt_list_init( &( sub->parent.suspend_thread ) );
+    rt_list_init( &( sub->node ) );
+}
+
+/* Attach a subscriber.  It sees the items sent from now on. */
+static void prvBroadcastSubscribe( struct rt_broadcast_queue * bq,
+                                   struct rt_broadcast_subscriber * sub )
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    sub->queue = bq;
+    sub->cursor = bq->tail;
+    rt_list_insert_before( &( bq->subscribers ), &( sub->node ) );
+    rt_hw_interrupt_enable( level );
+}
+
+/*
+ * Items the slowest subscriber has not read yet, which is the number of slots
+ * in use.  Must be called with interrupts disabled.
+ */
+static rt_uint32_t prvBroadcastHeldLocked( struct rt_broadcast_queue * bq )
+{
+    struct rt_list_node * node;
+    rt_uint32_t ulHeld = 0;
+    rt_uint32_t ulBehind;
+
+    rt_list_for_each( node, &( bq->subscribers ) )
+    {
+        ulBehind = prvBroadcastCount( bq, rt_list_entry( node, struct rt_broadcast_subscriber, node )->cursor );
+        if ( ulBehind > ulHeld )
+        {
+            ulHeld = ulBehind;
+        }
+    }
+
+    return ulHeld;
+}
+
+/*
+ * Append one item and resume the reader of every subscriber.  Must be called
+ * with interrupts disabled.  Returns the number of threads resumed, or a
+ * negative error if the ring is full and the policy keeps the item out.
+ */
+static rt_err_t prvBroadcastSendLocked( struct rt_broadcast_queue * bq,
+                                        const void * pvItemToQueue,
+                                        UBaseType_t * puxWoken )
+{
+    struct rt_list_node * node;
+    struct rt_broadcast_subscriber * sub;
+
+    if ( prvBroadcastHeldLocked( bq ) >= bq->max_msgs )
+    {
+        if ( bq->policy != queueBROADCAST_DROP_OLDEST )
+        {
+            return -RT_EFULL;
+        }
+        rt_list_for_each( node, &( bq->subscribers ) )
+        {
+            sub = rt_list_entry( node, struct rt_broadcast_subscriber, node );
+            if ( prvBroadcastCount( bq, sub->cursor ) >= bq->max_msgs )
+            {
+                sub->cursor = prvBroadcastNext( bq, sub->cursor );
+            }
+        }
+    }
+    prvQueueCopyItem( prvBroadcastSlot( bq, bq->tail ), pvItemToQueue, bq->msg_size );
+    bq->tail = prvBroadcastNext( bq, bq->tail );
+    rt_list_for_each( node, &( bq->subscribers ) )
+    {
+        sub = rt_list_entry( node, struct rt_broadcast_subscriber, node );
+        if ( prvQueueWakeOne( &( sub->parent.suspend_thread ) ) != RT_NULL )
+        {
+            ( *puxWoken )++;
+        }
+    }
+
+    return RT_EOK;
+}
+
+/*
+ * queueBROADCAST_BLOCK waits for the slowest subscriber like a send to a full
+ * queue.  queueBROADCAST_DROP_NEWEST fails at once, whatever the block time.
+ */
+static rt_err_t prvBroadcastSend( struct rt_broadcast_queue * bq,
+                                  const void * pvItemToQueue,
+                                  TickType_t xTicksToWait )
+{
+    UBaseType_t uxWoken = 0;
+    rt_base_t level;
+    rt_err_t err;
+
+    level = rt_hw_interrupt_disable();
+    while ( ( err = prvBroadcastSendLocked( bq, pvItemToQueue, &uxWoken ) ) != RT_EOK )
+    {
+        if ( ( xTicksToWait == ( TickType_t ) 0 ) || ( bq->policy != queueBROADCAST_BLOCK ) )
+        {
+            rt_hw_interrupt_enable( level );
+            return err;
+        }
+        err = prvQueueWait( &( bq->suspend_sender_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    rt_hw_interrupt_enable( level );
+
+    if ( uxWoken != 0 )
+    {
+        prvQueueSchedule();
+    }
+
+    return RT_EOK;
+}
+
+static UBaseType_t prvBroadcastSendMultiple( struct rt_broadcast_queue * bq,
+                                             const rt_uint8_t * pucItems,
+                                             UBaseType_t uxItemCount,
+                                             TickType_t xTicksToWait )
+{
+    UBaseType_t uxCount = 0;
+    UBaseType_t uxWoken = 0;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    while ( prvBroadcastSendLocked( bq, pucItems, &uxWoken ) != RT_EOK )
+    {
+        if ( ( xTicksToWait == ( TickType_t ) 0 ) || ( bq->policy != queueBROADCAST_BLOCK ) )
+        {
+            rt_hw_interrupt_enable( level );
+            return 0;
+        }
+        if ( prvQueueWait( &( bq->suspend_sender_thread ), &xTicksToWait, level ) != RT_EOK )
+        {
+            return 0;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    do
+    {
+        pucItems += bq->msg_size;
+        uxCount++;
+    } while ( ( uxCount < uxItemCount ) && ( prvBroadcastSendLocked( bq, pucItems, &uxWoken ) == RT_EOK ) );
+    rt_hw_interrupt_enable( level );
+
+    if ( uxWoken != 0 )
+    {
+        prvQueueSchedule();
+    }
+
+    return uxCount;
+}
+
+/*
+ * Drop everything that is queued.  Subscribers stay attached.  Detaching also
+ * cuts the subscribers loose: their readers are woken with an error and later
+ * receives fail.
+ */
+static void prvBroadcastReset( struct rt_broadcast_queue * bq,
+                               rt_bool_t xDetach )
+{
+    struct rt_broadcast_subscriber * sub;
+    struct rt_list_node * node;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    prvQueueWakeAll( &( bq->suspend_sender_thread ), -RT_ERROR );
+    rt_list_for_each( node, &( bq->subscribers ) )
+    {
+        sub = rt_list_entry( node, struct rt_broadcast_subscriber, node );
+        sub->cursor = bq->tail;
+        if ( xDetach )
+        {
+            prvQueueWakeAll( &( sub->parent.suspend_thread ), -RT_ERROR );
+            sub->queue = RT_NULL;
+        }
+    }
+    if ( xDetach )
+    {
+        while ( !rt_list_isempty( &( bq->subscribers ) ) )
+        {
+            rt_list_remove( bq->subscribers.next );
+        }
+        bq->parent.parent.type = RT_Object_Class_Null;
+    }
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+}
+
+/*
+ * Read the next item of a subscriber.  Must be called with interrupts
+ * disabled.  A writer waiting for room is resumed only when the read frees a
+ * slot, that is when this subscriber was the only one that far behind.
+ */
+static rt_err_t prvSubscriberReceiveLocked( struct rt_broadcast_subscriber * sub,
+                                            void * const pvBuffer,
+                                            const BaseType_t xJustPeeking,
+                                            rt_thread_t * pxWriter )
+{
+    struct rt_broadcast_queue * bq = sub->queue;
+    rt_uint32_t ulHeld;
+
+    if ( bq == RT_NULL )
+    {
+        return -RT_ERROR;
+    }
+    if ( sub->cursor == bq->tail )
+    {
+        return -RT_EEMPTY;
+    }
+    prvQueueCopyItem( pvBuffer, prvBroadcastSlot( bq, sub->cursor ), bq->msg_size );
+    if ( xJustPeeking == pdFALSE )
+    {
+        ulHeld = 0;
+        if ( ( *pxWriter == RT_NULL ) && !rt_list_isempty( &( bq->suspend_sender_thread ) ) )
+        {
+            /* Only a read by the slowest subscriber can free a slot */
+            ulHeld = prvBroadcastHeldLocked( bq );
+            if ( prvBroadcastCount( bq, sub->cursor ) < ulHeld )
+            {
+                ulHeld = 0;
+            }
+        }
+        sub->cursor = prvBroadcastNext( bq, sub->cursor );
+        if ( ( ulHeld != 0U ) && ( prvBroadcastHeldLocked( bq ) < ulHeld ) )
+        {
+            *pxWriter = prvQueueWakeOne( &( bq->suspend_sender_thread ) );
+        }
+    }
+
+    return RT_EOK;
+}
+
+/*
+ * A peeker is woken like a receiver but leaves the item in place, so the wake
+ * up is passed on to the next waiter, as prvMqPeek() does.
+ */
+static rt_err_t prvSubscriberReceive( struct rt_broadcast_subscriber * sub,
+                                      void * const pvBuffer,
+                                      TickType_t xTicksToWait,
+                                      const BaseType_t xJustPeeking )
+{
+    rt_thread_t thread = RT_NULL;
+    rt_base_t level;
+    rt_err_t err;
+
+    level = rt_hw_interrupt_disable();
+    while ( ( err = prvSubscriberReceiveLocked( sub, pvBuffer, xJustPeeking, &thread ) ) != RT_EOK )
+    {
+        if ( ( err != -RT_EEMPTY ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+        {
+            rt_hw_interrupt_enable( level );
+            return err;
+        }
+        err = prvQueueWait( &( sub->parent.suspend_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    if ( xJustPeeking != pdFALSE )
+    {
+        thread = prvQueueWakeOne( &( sub->parent.suspend_thread ) );
+    }
+    rt_hw_interrupt_enable( level );
+
+    if ( thread != RT_NULL )
+    {
+        prvQueueSchedule();
+    }
+
+    return RT_EOK;
+}
+
+static UBaseType_t prvSubscriberReceiveMultiple( struct rt_broadcast_subscriber * sub,
+                                                 rt_uint8_t * pucBuffer,
+                                                 UBaseType_t uxMaxItems,
+                                                 TickType_t xTicksToWait )
+{
+    rt_thread_t thread = RT_NULL;
+    UBaseType_t uxCount = 0;
+    rt_base_t level;
+    rt_err_t err;
+
+    level = rt_hw_interrupt_disable();
+    while ( ( err = prvSubscriberReceiveLocked( sub, pucBuffer, pdFALSE, &thread ) ) != RT_EOK )
+    {
+        if ( ( err != -RT_EEMPTY ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+        {
+            rt_hw_interrupt_enable( level );
+            return 0;
+        }
+        if ( prvQueueWait( &( sub->parent.suspend_thread ), &xTicksToWait, level ) != RT_EOK )
+        {
+            return 0;
+        }
+        level = rt_hw_interrupt_disable();
+    }
+    do
+    {
+        pucBuffer += sub->queue->msg_size;
+        uxCount++;
+    } while ( ( uxCount < uxMaxItems ) && ( prvSubscriberReceiveLocked( sub, pucBuffer, pdFALSE, &thread ) == RT_EOK ) );
+    rt_hw_interrupt_enable( level );
+
+    if ( thread != RT_NULL )
+    {
+        prvQueueSchedule();
+    }
+
+    return uxCount;
+}
+
+/*
+ * Reset skips a subscriber to the newest item.  Detach also unsubscribes it,
+ * which may let a waiting writer continue.
+ */
+static void prvSubscriberReset( struct rt_broadcast_subscriber * sub,
+                                rt_bool_t xDetach )
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    prvQueueWakeAll( &( sub->parent.suspend_thread ), -RT_ERROR );
+    if ( sub->queue != RT_NULL )
+    {
+        sub->cursor = sub->queue->tail;
+        prvQueueWakeAll( &( sub->queue->suspend_sender_thread ), RT_EOK );
+        if ( xDetach )
+        {
+            rt_list_remove( &( sub->node ) );
+            sub->queue = RT_NULL;
+        }
+    }
+    if ( xDetach )
+    {
+        sub->parent.parent.type = RT_Object_Class_Null;
+    }
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Per-kind operations.  The kind of object a handle wraps is recorded when it
+ * is created, so the public functions index xQueueOperations[] with it
+ * instead of looking up the RT-Thread object class and walking an if/else
+ * chain on every call.  Entries that make no sense for a kind are NULL.
+ */
+typedef struct QueueOperations
+{
+    /* Send an item.  *pxPosted is cleared when an existing item was
+     * overwritten instead of a new one being added. */
+    rt_err_t ( * pxSend )( struct rt_ipc_object * pipc,
+                           const void * pvItemToQueue,
+                           TickType_t xTicksToWait,
+                           const BaseType_t xCopyPosition,
+                           rt_bool_t * pxPosted );
+    /* Receive or peek at an item.  Semaphores and mutexes are taken. */
+    rt_err_t ( * pxReceive )( struct rt_ipc_object * pipc,
+                              void * const pvBuffer,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xJustPeeking );
+    UBaseType_t ( * pxSendMultiple )( struct rt_ipc_object * pipc,
+                                      const rt_uint8_t * pucItems,
+                                      UBaseType_t uxItemCount,
+                                      TickType_t xTicksToWait,
+                                      rt_bool_t * pxPosted );
+    UBaseType_t ( * pxReceiveMultiple )( struct rt_ipc_object * pipc,
+                                         rt_uint8_t * pucBuffer,
+                                         UBaseType_t uxMaxItems,
+                                         TickType_t xTicksToWait );
+    /* Queries.  Called with interrupts disabled. */
+    UBaseType_t ( * pxMessagesWaiting )( struct rt_ipc_object * pipc );
+    UBaseType_t ( * pxSpacesAvailable )( struct rt_ipc_object * pipc );
+    void ( * pxReset )( struct rt_ipc_object * pipc );
+    /* Detach the object.  vQueueDelete() releases the memory. */
+    void ( * pxDelete )( struct rt_ipc_object * pipc );
+} QueueOperations_t;
+
+/* Message queues, on either engine. */
+static rt_err_t prvMessageQueueSend( struct rt_ipc_object * pipc,
+                                     const void * pvItemToQueue,
+                                     TickType_t xTicksToWait,
+                                     const BaseType_t xCopyPosition,
+                                     rt_bool_t * pxPosted )
+{
+    if ( xCopyPosition == queueOVERWRITE )
+    {
+        return prvMqOverwrite( ( MessageQueue_t * ) pipc, pvItemToQueue, pxPosted );
+    }
+    #if ( configUSE_QUEUE_RING_BUFFER == 1 )
+        return prvRingSend( ( struct rt_ring_queue * ) pipc, pvItemToQueue, xTicksToWait, xCopyPosition );
+    #else
+        if ( xPortIsrYieldDeferred() != pdFALSE )
+        {
+            return prvMqSendDeferred( ( MessageQueue_t * ) pipc, pvItemToQueue, xCopyPosition );
+        }
+        if ( xCopyPosition == queueSEND_TO_FRONT )
+        {
+            return prvMqSendToFront( ( rt_mq_t ) pipc, pvItemToQueue, xTicksToWait );
+        }
+
+        return rt_mq_send_wait( ( rt_mq_t ) pipc, pvItemToQueue, ( ( rt_mq_t ) pipc )->msg_size, ( rt_int32_t ) xTicksToWait );
+    #endif
+}
+
+static rt_err_t prvMessageQueueReceive( struct rt_ipc_object * pipc,
+                                        void * const pvBuffer,
+                                        TickType_t xTicksToWait,
+                                        const BaseType_t xJustPeeking )
+{
+    rt_err_t err;
+
+    if ( xJustPeeking != pdFALSE )
+    {
+        return prvMqPeek( ( MessageQueue_t * ) pipc, pvBuffer, xTicksToWait );
+    }
+    #if ( configUSE_QUEUE_RING_BUFFER == 1 )
+        err = prvRingReceive( ( struct rt_ring_queue * ) pipc, pvBuffer, xTicksToWait );
+    #else
+        if ( xPortIsrYieldDeferred() != pdFALSE )
+        {
+            /* rt_mq_recv() would reschedule on the spot */
+            return ( prvMqReceiveMultiple( ( MessageQueue_t * ) pipc, pvBuffer, 1, 0 ) == 1 ) ? RT_EOK : -RT_EEMPTY;
+        }
+        err = ( rt_err_t ) rt_mq_recv( ( rt_mq_t ) pipc, pvBuffer, ( ( rt_mq_t ) pipc )->msg_size, ( rt_int32_t ) xTicksToWait );
+#if RT_VER_NUM >= 0x50001
+        if (( rt_ssize_t ) err >= 0)
+        {
+            err = RT_EOK;
+        }
+#endif
+    #endif
+
+    return err;
+}
+
+static UBaseType_t prvMessageQueueSendMultiple( struct rt_ipc_object * pipc,
+                                                const rt_uint8_t * pucItems,
+                                                UBaseType_t uxItemCount,
+                                                TickType_t xTicksToWait,
+                                                rt_bool_t * pxPosted )
+{
+    ( void ) pxPosted;
+
+    return prvMqSendMultiple( ( MessageQueue_t * ) pipc, pucItems, uxItemCount, xTicksToWait );
+}
+
+static UBaseType_t prvMessageQueueReceiveMultiple( struct rt_ipc_object * pipc,
+                                                   rt_uint8_t * pucBuffer,
+                                                   UBaseType_t uxMaxItems,
+                                                   TickType_t xTicksToWait )
+{
+    return prvMqReceiveMultiple( ( MessageQueue_t * ) pipc, pucBuffer, uxMaxItems, xTicksToWait );
+}
+
+static UBaseType_t prvMessageQueueMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    return ( ( MessageQueue_t * ) pipc )->entry;
+}
+
+static UBaseType_t prvMessageQueueSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    #if ( configUSE_QUEUE_RING_BUFFER == 1 )
+        return prvRingSpaces( ( struct rt_ring_queue * ) pipc );
+    #else
+        return ( ( rt_mq_t ) pipc )->max_msgs - ( ( rt_mq_t ) pipc )->entry;
+    #endif
+}
+
+static void prvMessageQueueReset( struct rt_ipc_object * pipc )
+{
+    #if ( configUSE_QUEUE_RING_BUFFER == 1 )
+        prvRingReset( ( struct rt_ring_queue * ) pipc );
+    #else
+        rt_mq_control( ( rt_mq_t ) pipc, RT_IPC_CMD_RESET, RT_NULL );
+    #endif
+}
+
+static void prvMessageQueueDelete( struct rt_ipc_object * pipc )
+{
+    #if ( configUSE_QUEUE_RING_BUFFER == 1 )
+        prvRingDetach( ( struct rt_ring_queue * ) pipc );
+    #else
+        rt_mq_detach( ( rt_mq_t ) pipc );
+    #endif
+}
+
+/* Single producer, single consumer queues. */
+static rt_err_t prvSpscQueueSend( struct rt_ipc_object * pipc,
+                                  const void * pvItemToQueue,
+                                  TickType_t xTicksToWait,
+                                  const BaseType_t xCopyPosition,
+                                  rt_bool_t * pxPosted )
+{
+    ( void ) pxPosted;
+    /* Only the consumer may move head.  A priority is ignored. */
+    configASSERT( ( xCopyPosition != queueSEND_TO_FRONT ) && ( xCopyPosition != queueOVERWRITE ) );
+
+    return prvSpscSend( ( struct rt_spsc_queue * ) pipc, pvItemToQueue, xTicksToWait );
+}
+
+static rt_err_t prvSpscQueueReceive( struct rt_ipc_object * pipc,
+                                     void * const pvBuffer,
+                                     TickType_t xTicksToWait,
+                                     const BaseType_t xJustPeeking )
+{
+    return prvSpscReceive( ( struct rt_spsc_queue * ) pipc, pvBuffer, xTicksToWait, xJustPeeking );
+}
+
+static UBaseType_t prvSpscQueueSendMultiple( struct rt_ipc_object * pipc,
+                                             const rt_uint8_t * pucItems,
+                                             UBaseType_t uxItemCount,
+                                             TickType_t xTicksToWait,
+                                             rt_bool_t * pxPosted )
+{
+    ( void ) pxPosted;
+
+    return prvSpscSendMultiple( ( struct rt_spsc_queue * ) pipc, pucItems, uxItemCount, xTicksToWait );
+}
+
+static UBaseType_t prvSpscQueueReceiveMultiple( struct rt_ipc_object * pipc,
+                                                rt_uint8_t * pucBuffer,
+                                                UBaseType_t uxMaxItems,
+                                                TickType_t xTicksToWait )
+{
+    return prvSpscReceiveMultiple( ( struct rt_spsc_queue * ) pipc, pucBuffer, uxMaxItems, xTicksToWait );
+}
+
+static UBaseType_t prvSpscQueueMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    struct rt_spsc_queue * spsc = ( struct rt_spsc_queue * ) pipc;
+
+    return prvSpscCount( spsc, spsc->tail, spsc->head );
+}
+
+static UBaseType_t prvSpscQueueSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    struct rt_spsc_queue * spsc = ( struct rt_spsc_queue * ) pipc;
+
+    return spsc->max_msgs - prvSpscCount( spsc, spsc->tail, spsc->head );
+}
+
+static void prvSpscQueueReset( struct rt_ipc_object * pipc )
+{
+    prvSpscReset( ( struct rt_spsc_queue * ) pipc, RT_FALSE );
+}
+
+static void prvSpscQueueDelete( struct rt_ipc_object * pipc )
+{
+    prvSpscReset( ( struct rt_spsc_queue * ) pipc, RT_TRUE );
+}
+
+/* Mailboxes hold a single item, so batches move at most one. */
+static rt_err_t prvMailboxQueueSend( struct rt_ipc_object * pipc,
+                                     const void * pvItemToQueue,
+                                     TickType_t xTicksToWait,
+                                     const BaseType_t xCopyPosition,
+                                     rt_bool_t * pxPosted )
+{
+    return prvMailboxSend( ( struct rt_mailbox_queue * ) pipc, pvItemToQueue, xTicksToWait, xCopyPosition, pxPosted );
+}
+
+static rt_err_t prvMailboxQueueReceive( struct rt_ipc_object * pipc,
+                                        void * const pvBuffer,
+                                        TickType_t xTicksToWait,
+                                        const BaseType_t xJustPeeking )
+{
+    return prvMailboxReceive( ( struct rt_mailbox_queue * ) pipc, pvBuffer, xTicksToWait, xJustPeeking );
+}
+
+static UBaseType_t prvMailboxQueueSendMultiple( struct rt_ipc_object * pipc,
+                                                const rt_uint8_t * pucItems,
+                                                UBaseType_t uxItemCount,
+                                                TickType_t xTicksToWait,
+                                                rt_bool_t * pxPosted )
+{
+    ( void ) uxItemCount;
+
+    return ( prvMailboxSend( ( struct rt_mailbox_queue * ) pipc, pucItems, xTicksToWait, queueSEND_TO_BACK, pxPosted ) == RT_EOK ) ? 1 : 0;
+}
+
+static UBaseType_t prvMailboxQueueReceiveMultiple( struct rt_ipc_object * pipc,
+                                                   rt_uint8_t * pucBuffer,
+                                                   UBaseType_t uxMaxItems,
+                                                   TickType_t xTicksToWait )
+{
+    ( void ) uxMaxItems;
+
+    return ( prvMailboxReceive( ( struct rt_mailbox_queue * ) pipc, pucBuffer, xTicksToWait, pdFALSE ) == RT_EOK ) ? 1 : 0;
+}
+
+static UBaseType_t prvMailboxQueueMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    return ( ( struct rt_mailbox_queue * ) pipc )->full;
+}
+
+static UBaseType_t prvMailboxQueueSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    return 1 - ( ( struct rt_mailbox_queue * ) pipc )->full;
+}
+
+static void prvMailboxQueueReset( struct rt_ipc_object * pipc )
+{
+    prvMailboxReset( ( struct rt_mailbox_queue * ) pipc, RT_FALSE );
+}
+
+static void prvMailboxQueueDelete( struct rt_ipc_object * pipc )
+{
+    prvMailboxReset( ( struct rt_mailbox_queue * ) pipc, RT_TRUE );
+}
+
+/* Priority queues. */
+static rt_err_t prvPriorityQueueSend( struct rt_ipc_object * pipc,
+                                      const void * pvItemToQueue,
+                                      TickType_t xTicksToWait,
+                                      const BaseType_t xCopyPosition,
+                                      rt_bool_t * pxPosted )
+{
+    ( void ) pxPosted;
+
+    return prvPrioritySend( ( struct rt_priority_queue * ) pipc, pvItemToQueue, xTicksToWait, xCopyPosition );
+}
+
+static rt_err_t prvPriorityQueueReceive( struct rt_ipc_object * pipc,
+                                         void * const pvBuffer,
+                                         TickType_t xTicksToWait,
+                                         const BaseType_t xJustPeeking )
+{
+    return prvPriorityReceive( ( struct rt_priority_queue * ) pipc, pvBuffer, xTicksToWait, xJustPeeking );
+}
+
+static UBaseType_t prvPriorityQueueSendMultiple( struct rt_ipc_object * pipc,
+                                                 const rt_uint8_t * pucItems,
+                                                 UBaseType_t uxItemCount,
+                                                 TickType_t xTicksToWait,
+                                                 rt_bool_t * pxPosted )
+{
+    ( void ) pxPosted;
+
+    return prvPrioritySendMultiple( ( struct rt_priority_queue * ) pipc, pucItems, uxItemCount, xTicksToWait );
+}
+
+static UBaseType_t prvPriorityQueueReceiveMultiple( struct rt_ipc_object * pipc,
+                                                    rt_uint8_t * pucBuffer,
+                                                    UBaseType_t uxMaxItems,
+                                                    TickType_t xTicksToWait )
+{
+    return prvPriorityReceiveMultiple( ( struct rt_priority_queue * ) pipc, pucBuffer, uxMaxItems, xTicksToWait );
+}
+
+static UBaseType_t prvPriorityQueueMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    return ( ( struct rt_priority_queue * ) pipc )->entry;
+}
+
+static UBaseType_t prvPriorityQueueSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    struct rt_priority_queue * pq = ( struct rt_priority_queue * ) pipc;
+
+    return pq->max_msgs - pq->entry;
+}
+
+static void prvPriorityQueueReset( struct rt_ipc_object * pipc )
+{
+    prvPriorityReset( ( struct rt_priority_queue * ) pipc, RT_FALSE );
+}
+
+static void prvPriorityQueueDelete( struct rt_ipc_object * pipc )
+{
+    prvPriorityReset( ( struct rt_priority_queue * ) pipc, RT_TRUE );
+}
+
+/* Broadcast queues are only sent to, and subscribers only received from. */
+static rt_err_t prvBroadcastQueueSend( struct rt_ipc_object * pipc,
+                                       const void * pvItemToQueue,
+                                       TickType_t xTicksToWait,
+                                       const BaseType_t xCopyPosition,
+                                       rt_bool_t * pxPosted )
+{
+    ( void ) pxPosted;
+    configASSERT( xCopyPosition != queueOVERWRITE );
+
+    return prvBroadcastSend( ( struct rt_broadcast_queue * ) pipc, pvItemToQueue, xTicksToWait );
+}
+
+static rt_err_t prvBroadcastQueueReceive( struct rt_ipc_object * pipc,
+                                          void * const pvBuffer,
+                                          TickType_t xTicksToWait,
+                                          const BaseType_t xJustPeeking )
+{
+    ( void ) pipc;
+    ( void ) pvBuffer;
+    ( void ) xTicksToWait;
+    ( void ) xJustPeeking;
+    /* Receive through a handle returned by xQueueSubscribe() */
+    configASSERT( 0 );
+
+    return -RT_ERROR;
+}
+
+static UBaseType_t prvBroadcastQueueSendMultiple( struct rt_ipc_object * pipc,
+                                                  const rt_uint8_t * pucItems,
+                                                  UBaseType_t uxItemCount,
+                                                  TickType_t xTicksToWait,
+                                                  rt_bool_t * pxPosted )
+{
+    ( void ) pxPosted;
+
+    return prvBroadcastSendMultiple( ( struct rt_broadcast_queue * ) pipc, pucItems, uxItemCount, xTicksToWait );
+}
+
+static UBaseType_t prvBroadcastQueueMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    UBaseType_t uxHeld;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    uxHeld = prvBroadcastHeldLocked( ( struct rt_broadcast_queue * ) pipc );
+    rt_hw_interrupt_enable( level );
+
+    return uxHeld;
+}
+
+static UBaseType_t prvBroadcastQueueSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    return ( ( struct rt_broadcast_queue * ) pipc )->max_msgs - prvBroadcastQueueMessagesWaiting( pipc );
+}
+
+static void prvBroadcastQueueReset( struct rt_ipc_object * pipc )
+{
+    prvBroadcastReset( ( struct rt_broadcast_queue * ) pipc, RT_FALSE );
+}
+
+static void prvBroadcastQueueDelete( struct rt_ipc_object * pipc )
+{
+    prvBroadcastReset( ( struct rt_broadcast_queue * ) pipc, RT_TRUE );
+}
+
+static rt_err_t prvSubscriberQueueSend( struct rt_ipc_object * pipc,
+                                        const void * pvItemToQueue,
+                                        TickType_t xTicksToWait,
+                                        const BaseType_t xCopyPosition,
+                                        rt_bool_t * pxPosted )
+{
+    ( void ) pipc;
+    ( void ) pvItemToQueue;
+    ( void ) xTicksToWait;
+    ( void ) xCopyPosition;
+    ( void ) pxPosted;
+    /* Send to the broadcast queue itself */
+    configASSERT( 0 );
+
+    return -RT_ERROR;
+}
+
+static rt_err_t prvSubscriberQueueReceive( struct rt_ipc_object * pipc,
+                                           void * const pvBuffer,
+                                           TickType_t xTicksToWait,
+                                           const BaseType_t xJustPeeking )
+{
+    return prvSubscriberReceive( ( struct rt_broadcast_subscriber * ) pipc, pvBuffer, xTicksToWait, xJustPeeking );
+}
+
+static UBaseType_t prvSubscriberQueueReceiveMultiple( struct rt_ipc_object * pipc,
+                                                      rt_uint8_t * pucBuffer,
+                                                      UBaseType_t uxMaxItems,
+                                                      TickType_t xTicksToWait )
+{
+    return prvSubscriberReceiveMultiple( ( struct rt_broadcast_subscriber * ) pipc, pucBuffer, uxMaxItems, xTicksToWait );
+}
+
+static UBaseType_t prvSubscriberQueueMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    struct rt_broadcast_subscriber * sub = ( struct rt_broadcast_subscriber * ) pipc;
+
+    return ( sub->queue == RT_NULL ) ? 0 : prvBroadcastCount( sub->queue, sub->cursor );
+}
+
+static UBaseType_t prvSubscriberQueueSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    struct rt_broadcast_subscriber * sub = ( struct rt_broadcast_subscriber * ) pipc;
+
+    return ( sub->queue == RT_NULL ) ? 0 : ( sub->queue->max_msgs - prvBroadcastCount( sub->queue, sub->cursor ) );
+}
+
+static void prvSubscriberQueueReset( struct rt_ipc_object * pipc )
+{
+    prvSubscriberReset( ( struct rt_broadcast_subscriber * ) pipc, RT_FALSE );
+}
+
+static void prvSubscriberQueueDelete( struct rt_ipc_object * pipc )
+{
+    prvSubscriberReset( ( struct rt_broadcast_subscriber * ) pipc, RT_TRUE );
+}
+
+/* Semaphores carry no data.  Giving beyond the maximum count fails. */
+#if ( configUSE_NATIVE_SEMAPHORES == 1 )
+
+/*
+ * Native semaphores.  The count only changes through compare-and-swap, so an
+ * uncontended give or take is a single atomic operation.  Interrupts are
+ * masked only to block or to wake a blocked taker.  A taker retries the count
+ * with interrupts masked before it blocks, and a giver looks for waiters
+ * after its increment, under the lock on SMP (see queueMAY_HAVE_WAITERS()),
+ * so a wake up cannot be missed.  A woken taker competes for the count
+ * again, so a give is never lost if another task takes it first.
+ */
+static void prvNativeSemaphoreInit( struct rt_native_semaphore * sem,
+                                    const char * name,
+                                    UBaseType_t uxMaxCount )
+{
+    rt_memset( sem, 0x00, sizeof( struct rt_native_semaphore ) );
+    rt_strncpy( sem->parent.parent.name, name, RT_NAME_MAX );
+    sem->parent.parent.type = RT_Object_Class_Semaphore | RT_Object_Class_Static;
+    rt_list_init( &( sem->parent.parent.list ) );
+    rt_list_init( &( sem->parent.suspend_thread ) );
+    sem->max_value = ( rt_uint32_t ) uxMaxCount;
+}
+
+static rt_bool_t prvNativeSemaphoreTryTake( struct rt_native_semaphore * sem )
+{
+    rt_uint32_t ulCount;
+
+    do
+    {
+        ulCount = sem->count;
+        if ( ulCount == 0 )
+        {
+            return RT_FALSE;
+        }
+    } while ( !portATOMIC_COMPARE_AND_SWAP( &( sem->count ), ulCount, ulCount - 1 ) );
+
+    return RT_TRUE;
+}
+
+static void prvNativeSemaphoreDetach( struct rt_native_semaphore * sem,
+                                      rt_bool_t xDetach )
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    prvQueueWakeAll( &( sem->parent.suspend_thread ), -RT_ERROR );
+    sem->count = 0;
+    if ( xDetach )
+    {
+        sem->parent.parent.type = RT_Object_Class_Null;
+    }
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+}
+
+static rt_err_t prvSemaphoreGive( struct rt_ipc_object * pipc,
+                                  const void * pvItemToQueue,
+                                  TickType_t xTicksToWait,
+                                  const BaseType_t xCopyPosition,
+                                  rt_bool_t * pxPosted )
+{
+    struct rt_native_semaphore * sem = ( struct rt_native_semaphore * ) pipc;
+    rt_uint32_t ulCount;
+    rt_thread_t thread;
+    rt_base_t level;
+
+    ( void ) pvItemToQueue;
+    ( void ) xTicksToWait;
+    ( void ) xCopyPosition;
+    ( void ) pxPosted;
+
+    do
+    {
+        ulCount = sem->count;
+        if ( ulCount >= sem->max_value )
+        {
+            return -RT_ERROR;
+        }
+    } while ( !portATOMIC_COMPARE_AND_SWAP( &( sem->count ), ulCount, ulCount + 1 ) );
+
+    if ( queueMAY_HAVE_WAITERS( &( sem->parent.suspend_thread ) ) )
+    {
+        level = rt_hw_interrupt_disable();
+        thread = prvQueueWakeOne( &( sem->parent.suspend_thread ) );
+        rt_hw_interrupt_enable( level );
+
+        if ( thread != RT_NULL )
+        {
+            prvQueueSchedule();
+        }
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t prvSemaphoreTake( struct rt_ipc_object * pipc,
+                                  void * const pvBuffer,
+                                  TickType_t xTicksToWait,
+                                  const BaseType_t xJustPeeking )
+{
+    struct rt_native_semaphore * sem = ( struct rt_native_semaphore * ) pipc;
+    rt_base_t level;
+    rt_err_t err;
+
+    ( void ) pvBuffer;
+
+    if ( xJustPeeking != pdFALSE )
+    {
+        /* Peeking at a semaphore is not supported */
+        return -RT_ERROR;
+    }
+    if ( prvNativeSemaphoreTryTake( sem ) )
+    {
+        return RT_EOK;
+    }
+    for ( ; ; )
+    {
+        level = rt_hw_interrupt_disable();
+        if ( prvNativeSemaphoreTryTake( sem ) )
+        {
+            rt_hw_interrupt_enable( level );
+            return RT_EOK;
+        }
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return -RT_ETIMEOUT;
+        }
+        err = prvQueueWait( &( sem->parent.suspend_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            return err;
+        }
+    }
+}
+
+static UBaseType_t prvSemaphoreMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    return ( ( struct rt_native_semaphore * ) pipc )->count;
+}
+
+static UBaseType_t prvSemaphoreSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    return ( ( struct rt_native_semaphore * ) pipc )->max_value - ( ( struct rt_native_semaphore * ) pipc )->count;
+}
+
+static void prvSemaphoreSetCount( struct rt_ipc_object * pipc,
+                                  UBaseType_t uxCount )
+{
+    ( ( struct rt_native_semaphore * ) pipc )->count = ( rt_uint32_t ) uxCount;
+}
+
+static void prvSemaphoreReset( struct rt_ipc_object * pipc )
+{
+    prvNativeSemaphoreDetach( ( struct rt_native_semaphore * ) pipc, RT_FALSE );
+}
+
+static void prvSemaphoreDelete( struct rt_ipc_object * pipc )
+{
+    prvNativeSemaphoreDetach( ( struct rt_native_semaphore * ) pipc, RT_TRUE );
+}
+
+#else /* configUSE_NATIVE_SEMAPHORES */
+
+static rt_err_t prvSemaphoreGive( struct rt_ipc_object * pipc,
+                                  const void * pvItemToQueue,
+                                  TickType_t xTicksToWait,
+                                  const BaseType_t xCopyPosition,
+                                  rt_bool_t * pxPosted )
+{
+    rt_err_t err = -RT_ERROR;
+    rt_base_t level;
+
+    ( void ) pvItemToQueue;
+    ( void ) xTicksToWait;
+    ( void ) xCopyPosition;
+    ( void ) pxPosted;
+
+    level = rt_hw_interrupt_disable();
+    if ( ( ( rt_sem_t ) pipc )->value < ( ( struct rt_semaphore_wrapper * ) pipc )->max_value )
+    {
+        if ( xPortIsrYieldDeferred() != pdFALSE )
+        {
+            /* rt_sem_release() would reschedule on the spot */
+            if ( prvQueueWakeOne( &( pipc->suspend_thread ) ) == RT_NULL )
+            {
+                ( ( rt_sem_t ) pipc )->value++;
+            }
+            err = RT_EOK;
+        }
+        else
+        {
+            err = rt_sem_release( ( rt_sem_t ) pipc );
+        }
+    }
+    rt_hw_interrupt_enable( level );
+
+    return err;
+}
+
+static rt_err_t prvSemaphoreTake( struct rt_ipc_object * pipc,
+                                  void * const pvBuffer,
+                                  TickType_t xTicksToWait,
+                                  const BaseType_t xJustPeeking )
+{
+    ( void ) pvBuffer;
+
+    if ( xJustPeeking != pdFALSE )
+    {
+        /* Peeking at a semaphore is not supported */
+        return -RT_ERROR;
+    }
+
+    return rt_sem_take( ( rt_sem_t ) pipc, ( rt_int32_t ) xTicksToWait );
+}
+
+static UBaseType_t prvSemaphoreMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    return ( ( rt_sem_t ) pipc )->value;
+}
+
+static UBaseType_t prvSemaphoreSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    return ( ( struct rt_semaphore_wrapper * ) pipc )->max_value - ( ( rt_sem_t ) pipc )->value;
+}
+
+static void prvSemaphoreSetCount( struct rt_ipc_object * pipc,
+                                  UBaseType_t uxCount )
+{
+    ( ( rt_sem_t ) pipc )->value = ( rt_uint16_t ) uxCount;
+}
+
+static void prvSemaphoreReset( struct rt_ipc_object * pipc )
+{
+    rt_sem_control( ( rt_sem_t ) pipc, RT_IPC_CMD_RESET, ( void * ) 0 );
+}
+
+static void prvSemaphoreDelete( struct rt_ipc_object * pipc )
+{
+    rt_sem_detach( ( rt_sem_t ) pipc );
+}
+
+#endif /* configUSE_NATIVE_SEMAPHORES */
+
+/* Mutexes.  A mutex holds one "item" while it has no owner. */
+static rt_err_t prvMutexGive( struct rt_ipc_object * pipc,
+                              const void * pvItemToQueue,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xCopyPosition,
+                              rt_bool_t * pxPosted )
+{
+    ( void ) pvItemToQueue;
+    ( void ) xTicksToWait;
+    ( void ) xCopyPosition;
+    ( void ) pxPosted;
+
+    return rt_mutex_release( ( rt_mutex_t ) pipc );
+}
+
+static rt_err_t prvMutexTake( struct rt_ipc_object * pipc,
+                              void * const pvBuffer,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xJustPeeking )
+{
+    ( void ) pvBuffer;
+
+    if ( xJustPeeking != pdFALSE )
+    {
+        return -RT_ERROR;
+    }
+
+    return rt_mutex_take( ( rt_mutex_t ) pipc, ( rt_int32_t ) xTicksToWait );
+}
+
+static UBaseType_t prvMutexMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    return ( ( ( rt_mutex_t ) pipc )->owner == RT_NULL ) ? 1 : 0;
+}
+
+static UBaseType_t prvMutexSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    return ( ( ( rt_mutex_t ) pipc )->owner == RT_NULL ) ? 0 : 1;
+}
+
+static void prvMutexDelete( struct rt_ipc_object * pipc )
+{
+    rt_mutex_detach( ( rt_mutex_t ) pipc );
+}
+
+/*
+ * Priority inheritance for lean mutexes and reader-writer locks.  A lock with
+ * a holder that tasks wait for is on one of these lists, through taken_list,
+ * until the holder gives it.  The holder runs at the highest of its base
+ * priority, init_priority, and the priorities of the first waiters on every
+ * listed lock it holds, worked out again whenever that can change.  Locks can
+ * then be nested and given back in any order, and vTaskPrioritySet() changes
+ * the base priority without losing what was inherited.
+ */
+#if ( configUSE_LEAN_MUTEXES == 1 )
+    static rt_list_t xQueueContendedLeanMutexes = RT_LIST_OBJECT_INIT( xQueueContendedLeanMutexes );
+#endif
+static rt_list_t xQueueContendedRWLocks = RT_LIST_OBJECT_INIT( xQueueContendedRWLocks );
+
+/* The higher of priority and that of the first task on a wait list */
+static rt_uint8_t prvQueueWaiterPriority( rt_list_t * pxWaitList,
+                                          rt_uint8_t priority )
+{
+    rt_thread_t waiter;
+
+    /* Waiters are kept in priority order */
+    if ( !rt_list_isempty( pxWaitList ) )
+    {
+        waiter = rt_list_entry( pxWaitList->next, struct rt_thread, tlist );
+        if ( waiter->current_priority < priority )
+        {
+            priority = waiter->current_priority;
+        }
+    }
+
+    return priority;
+}
+
+/*
+ * The highest of priority and the priorities thread inherits from the locks
+ * it holds.  Also called by vTaskPrioritySet().  Must be called with
+ * interrupts disabled.
+ */
+rt_uint8_t ucQueueInheritedPriority( rt_thread_t thread,
+                                     rt_uint8_t priority )
+{
+    struct rt_list_node * node;
+#if ( configUSE_LEAN_MUTEXES == 1 )
+    struct rt_lean_mutex * mutex;
+#endif
+    struct rt_rwlock * rwlock;
+
+#if ( configUSE_LEAN_MUTEXES == 1 )
+    rt_list_for_each( node, &xQueueContendedLeanMutexes )
+    {
+        mutex = rt_list_entry( node, struct rt_lean_mutex, taken_list );
+        if ( prvLeanMutexOwner( mutex ) == thread )
+        {
+            priority = prvQueueWaiterPriority( &( mutex->parent.suspend_thread ), priority );
+        }
+    }
+#endif
+    rt_list_for_each( node, &xQueueContendedRWLocks )
+    {
+        rwlock = rt_list_entry( node, struct rt_rwlock, taken_list );
+        if ( rwlock->writer == thread )
+        {
+            priority = prvQueueWaiterPriority( &( rwlock->parent.suspend_thread ), priority );
+            priority = prvQueueWaiterPriority( &( rwlock->suspend_writer_thread ), priority );
+        }
+    }
+
+    return priority;
+}
+
+/*
+ * Put a lock a task is about to wait for on its list, if it is not there
+ * yet.  Must be called with interrupts disabled.
+ */
+static void prvQueueMarkContended( rt_list_t * pxContendedList,
+                                   rt_list_t * pxTakenList )
+{
+    if ( rt_list_isempty( pxTakenList ) )
+    {
+        rt_list_insert_before( pxContendedList, pxTakenList );
+    }
+}
+
+/*
+ * Give a holder the priority it inherits from the locks it still holds, or
+ * its base priority when there are none.  Must be called with interrupts
+ * disabled.
+ */
+static void prvQueueUpdateInheritedPriority( rt_thread_t thread )
+{
+    prvQueueSetPriority( thread, ucQueueInheritedPriority( thread, thread->init_priority ) );
+}
+
+#if ( configUSE_LEAN_MUTEXES == 1 )
+
+/*
+ * Lean mutexes.  An uncontended take swaps owner from 0 to the taking thread
+ * and an uncontended give swaps it back, without masking interrupts.  A task
+ * that has to wait masks interrupts, sets the contended bit of owner so that
+ * the holder gives through prvLeanMutexGiveSlow(), raises the holder to its
+ * own priority and blocks.  Since the holder is recorded by the same swap
+ * that takes the mutex, a waiter always finds the task to raise.  A woken
+ * waiter competes for the mutex again and takes it with the contended bit
+ * set, since other tasks may still be waiting.  The slow paths change owner
+ * with compare-and-swap as well, so a fast give that frees the mutex while a
+ * waiter is marking it contended makes the waiter try again instead of
+ * waiting for a give that has already happened.  Once the contended bit is
+ * set only the slow give, under the lock, changes owner.
+ */
+static void prvLeanMutexInit( struct rt_lean_mutex * mutex,
+                              const char * name )
+{
+    rt_memset( mutex, 0x00, sizeof( struct rt_lean_mutex ) );
+    rt_strncpy( mutex->parent.parent.name, name, RT_NAME_MAX );
+    mutex->parent.parent.type = RT_Object_Class_Mutex | RT_Object_Class_Static;
+    rt_list_init( &( mutex->parent.parent.list ) );
+    rt_list_init( &( mutex->parent.suspend_thread ) );
+    rt_list_init( &( mutex->taken_list ) );
+}
+
+static rt_err_t prvLeanMutexTakeSlow( struct rt_lean_mutex * mutex,
+                                      TickType_t xTicksToWait )
+{
+    rt_thread_t thread = rt_thread_self();
+    rt_thread_t owner;
+    rt_ubase_t uxOwner;
+    rt_base_t level;
+    rt_err_t err;
+
+    for ( ; ; )
+    {
+        level = rt_hw_interrupt_disable();
+        /* The fast paths change owner without the lock, from another core or
+         * an interrupt that does not honour it, so every change made here is
+         * a compare-and-swap too.  A set contended bit is left alone by them. */
+        uxOwner = mutex->owner;
+        if ( uxOwner == queueLEAN_MUTEX_FREE )
+        {
+            if ( !portATOMIC_COMPARE_AND_SWAP_WORD( &( mutex->owner ), queueLEAN_MUTEX_FREE,
+                                                    rt_list_isempty( &( mutex->parent.suspend_thread ) ) ? ( rt_ubase_t ) thread : ( ( rt_ubase_t ) thread | queueLEAN_MUTEX_CONTENDED ) ) )
+            {
+                rt_hw_interrupt_enable( level );
+                continue;
+            }
+            /* The tasks still waiting raise the new holder */
+            if ( !rt_list_isempty( &( mutex->parent.suspend_thread ) ) )
+            {
+                prvQueueMarkContended( &xQueueContendedLeanMutexes, &( mutex->taken_list ) );
+                prvQueueUpdateInheritedPriority( thread );
+            }
+            rt_hw_interrupt_enable( level );
+            return RT_EOK;
+        }
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return -RT_ETIMEOUT;
+        }
+        owner = ( rt_thread_t ) ( uxOwner & ~queueLEAN_MUTEX_CONTENDED );
+        /* A non-recursive mutex taken twice by its holder never comes free */
+        configASSERT( owner != thread );
+        /* If the holder gave it back in the meantime, try again rather than
+         * wait for a give that has already happened */
+        if ( ( ( uxOwner & queueLEAN_MUTEX_CONTENDED ) == 0 ) &&
+             !portATOMIC_COMPARE_AND_SWAP_WORD( &( mutex->owner ), uxOwner, uxOwner | queueLEAN_MUTEX_CONTENDED ) )
+        {
+            rt_hw_interrupt_enable( level );
+            continue;
+        }
+        prvQueueMarkContended( &xQueueContendedLeanMutexes, &( mutex->taken_list ) );
+        if ( owner->current_priority > thread->current_priority )
+        {
+            prvQueueSetPriority( owner, thread->current_priority );
+        }
+        err = prvQueueWait( &( mutex->parent.suspend_thread ), &xTicksToWait, level );
+        if ( err != RT_EOK )
+        {
+            /* The holder no longer inherits this task's priority */
+            level = rt_hw_interrupt_disable();
+            owner = prvLeanMutexOwner( mutex );
+            if ( owner != RT_NULL )
+            {
+                prvQueueUpdateInheritedPriority( owner );
+            }
+            rt_hw_interrupt_enable( level );
+            return err;
+        }
+    }
+}
+
+static void prvLeanMutexGiveSlow( struct rt_lean_mutex * mutex,
+                                  rt_thread_t thread )
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    mutex->owner = queueLEAN_MUTEX_FREE;
+    rt_list_remove( &( mutex->taken_list ) );
+    prvQueueUpdateInheritedPriority( thread );
+    ( void ) prvQueueWakeOne( &( mutex->parent.suspend_thread ) );
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+}
+
+static rt_err_t prvLeanMutexGive( struct rt_ipc_object * pipc,
+                                  const void * pvItemToQueue,
+                                  TickType_t xTicksToWait,
+                                  const BaseType_t xCopyPosition,
+                                  rt_bool_t * pxPosted )
+{
+    struct rt_lean_mutex * mutex = ( struct rt_lean_mutex * ) pipc;
+    rt_thread_t thread = rt_thread_self();
+
+    ( void ) pvItemToQueue;
+    ( void ) xTicksToWait;
+    ( void ) xCopyPosition;
+    ( void ) pxPosted;
+
+    if ( prvLeanMutexOwner( mutex ) != thread )
+    {
+        return -RT_ERROR;
+    }
+    if ( !portATOMIC_COMPARE_AND_SWAP_WORD( &( mutex->owner ), ( rt_ubase_t ) thread, queueLEAN_MUTEX_FREE ) )
+    {
+        prvLeanMutexGiveSlow( mutex, thread );
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t prvLeanMutexTake( struct rt_ipc_object * pipc,
+                                  void * const pvBuffer,
+                                  TickType_t xTicksToWait,
+                                  const BaseType_t xJustPeeking )
+{
+    struct rt_lean_mutex * mutex = ( struct rt_lean_mutex * ) pipc;
+    rt_thread_t thread = rt_thread_self();
+
+    ( void ) pvBuffer;
+
+    if ( xJustPeeking != pdFALSE )
+    {
+        return -RT_ERROR;
+    }
+    if ( portATOMIC_COMPARE_AND_SWAP_WORD( &( mutex->owner ), queueLEAN_MUTEX_FREE, ( rt_ubase_t ) thread ) )
+    {
+        return RT_EOK;
+    }
+
+    return prvLeanMutexTakeSlow( mutex, xTicksToWait );
+}
+
+static UBaseType_t prvLeanMutexMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    return ( ( ( struct rt_lean_mutex * ) pipc )->owner == queueLEAN_MUTEX_FREE ) ? 1 : 0;
+}
+
+static UBaseType_t prvLeanMutexSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    return ( ( ( struct rt_lean_mutex * ) pipc )->owner == queueLEAN_MUTEX_FREE ) ? 0 : 1;
+}
+
+static void prvLeanMutexDelete( struct rt_ipc_object * pipc )
+{
+    struct rt_lean_mutex * mutex = ( struct rt_lean_mutex * ) pipc;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    prvQueueWakeAll( &( mutex->parent.suspend_thread ), -RT_ERROR );
+    rt_list_remove( &( mutex->taken_list ) );
+    mutex->parent.parent.type = RT_Object_Class_Null;
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+}
+
+#endif /* configUSE_LEAN_MUTEXES */
+
+/*
+ * Reader-writer locks.  Readers share the lock and a writer holds it alone.
+ * Writers are preferred: once a writer waits, new readers wait behind it, and
+ * the lock is handed to the next waiting writer before any waiting reader.
+ * The lock is handed over directly, so a woken task owns it on return from
+ * prvQueueWait() and no new task can slip in ahead of it.  Tasks waiting for
+ * a writer raise it to their priority; readers are not tracked one by one and
+ * do not inherit.
+ */
+static void prvRWLockInit( struct rt_rwlock * rwlock,
+                           const char * name )
+{
+    rt_memset( rwlock, 0x00, sizeof( struct rt_rwlock ) );
+    rt_strncpy( rwlock->parent.parent.name, name, RT_NAME_MAX );
+    rwlock->parent.parent.type = RT_Object_Class_Mutex | RT_Object_Class_Static;
+    rt_list_init( &( rwlock->parent.parent.list ) );
+    rt_list_init( &( rwlock->parent.suspend_thread ) );
+    rt_list_init( &( rwlock->suspend_writer_thread ) );
+    rt_list_init( &( rwlock->taken_list ) );
+}
+
+/*
+ * Hand a free lock to the first waiting writer, or failing that to every
+ * waiting reader.  Must be called with interrupts disabled.
+ */
+static void prvRWLockHandOver( struct rt_rwlock * rwlock )
+{
+    rt_thread_t thread;
+
+    thread = prvQueueWakeOne( &( rwlock->suspend_writer_thread ) );
+    if ( thread != RT_NULL )
+    {
+        rwlock->writer = thread;
+        /* The tasks still waiting raise the new writer */
+        if ( !rt_list_isempty( &( rwlock->parent.suspend_thread ) ) ||
+             !rt_list_isempty( &( rwlock->suspend_writer_thread ) ) )
+        {
+            prvQueueMarkContended( &xQueueContendedRWLocks, &( rwlock->taken_list ) );
+            prvQueueUpdateInheritedPriority( thread );
+        }
+    }
+    else
+    {
+        rwlock->readers += ( rt_uint32_t ) prvQueueWakeSome( &( rwlock->parent.suspend_thread ), ( UBaseType_t ) ~0U );
+    }
+}
+
+static rt_err_t prvRWLockTake( struct rt_rwlock * rwlock,
+                               TickType_t xTicksToWait,
+                               BaseType_t xWrite )
+{
+    rt_thread_t thread = rt_thread_self();
+    rt_list_t * pxWaitList;
+    rt_base_t level;
+    rt_err_t err;
+
+    level = rt_hw_interrupt_disable();
+    if ( xWrite != pdFALSE )
+    {
+        if ( ( rwlock->writer == RT_NULL ) && ( rwlock->readers == 0 ) )
+        {
+            rwlock->writer = thread;
+            rt_hw_interrupt_enable( level );
+            return RT_EOK;
+        }
+        /* Not recursive, a writer taking it again would wait for itself */
+        configASSERT( rwlock->writer != thread );
+        pxWaitList = &( rwlock->suspend_writer_thread );
+    }
+    else
+    {
+        if ( ( rwlock->writer == RT_NULL ) && rt_list_isempty( &( rwlock->suspend_writer_thread ) ) )
+        {
+            rwlock->readers++;
+            rt_hw_interrupt_enable( level );
+            return RT_EOK;
+        }
+        pxWaitList = &( rwlock->parent.suspend_thread );
+    }
+    if ( xTicksToWait == ( TickType_t ) 0 )
+    {
+        rt_hw_interrupt_enable( level );
+        return -RT_ETIMEOUT;
+    }
+    if ( rwlock->writer != RT_NULL )
+    {
+        prvQueueMarkContended( &xQueueContendedRWLocks, &( rwlock->taken_list ) );
+        if ( rwlock->writer->current_priority > thread->current_priority )
+        {
+            prvQueueSetPriority( rwlock->writer, thread->current_priority );
+        }
+    }
+    err = prvQueueWait( pxWaitList, &xTicksToWait, level );
+    if ( err != RT_EOK )
+    {
+        level = rt_hw_interrupt_disable();
+        /* The writer no longer inherits this task's priority */
+        if ( rwlock->writer != RT_NULL )
+        {
+            prvQueueUpdateInheritedPriority( rwlock->writer );
+        }
+        /* Readers held back only by this writer can go now */
+        if ( ( xWrite != pdFALSE ) && ( rwlock->writer == RT_NULL ) &&
+             rt_list_isempty( &( rwlock->suspend_writer_thread ) ) )
+        {
+            rwlock->readers += ( rt_uint32_t ) prvQueueWakeSome( &( rwlock->parent.suspend_thread ), ( UBaseType_t ) ~0U );
+        }
+        rt_hw_interrupt_enable( level );
+        prvQueueSchedule();
+    }
+
+    return err;
+}
+
+static rt_err_t prvRWLockGive( struct rt_rwlock * rwlock )
+{
+    rt_thread_t thread = rt_thread_self();
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if ( rwlock->writer == thread )
+    {
+        rwlock->writer = RT_NULL;
+        rt_list_remove( &( rwlock->taken_list ) );
+        prvQueueUpdateInheritedPriority( thread );
+        prvRWLockHandOver( rwlock );
+    }
+    else if ( ( rwlock->writer == RT_NULL ) && ( rwlock->readers > 0 ) )
+    {
+        rwlock->readers--;
+        if ( rwlock->readers == 0 )
+        {
+            prvRWLockHandOver( rwlock );
+        }
+    }
+    else
+    {
+        rt_hw_interrupt_enable( level );
+        return -RT_ERROR;
+    }
+    rt_hw_interrupt_enable( level );
+    prvQueueSchedule();
+
+    return RT_EOK;
+}
+
+static rt_err_t prvRWLockQueueGive( struct rt_ipc_object * pipc,
+                                    const void * pvItemToQueue,
+                                    TickType_t xTicksToWait,
+                                    const BaseType_t xCopyPosition,
+                                    rt_bool_t * pxPosted )
+{
+    ( void ) pvItemToQueue;
+    ( void ) xTicksToWait;
+    ( void ) xCopyPosition;
+    ( void ) pxPosted;
+
+    return prvRWLockGive( ( struct rt_rwlock * ) pipc );
+}
+
+/* A plain take of a reader-writer lock takes it for writing */
+static rt_err_t prvRWLockQueueTake( struct rt_ipc_object * pipc,
+                                    void * const pvBuffer,
+                                    TickType_t xTicksToWait,
+                                    const BaseType_t xJustPeeking )
+{
+    ( void ) pvBuffer;
+
+    if ( xJustPeeking != pdFALSE )
+    {
+        return -RT_ERROR;
+    }
+
+    return prvRWLockTake( ( struct rt_rwlock * ) pipc, xTicksToWait, pdTRUE );
+}
+
+static UBaseType_t prvRWLockMessagesWaiting( struct rt_ipc_object * pipc )
+{
+    struct rt_rwlock * rwlock = ( struct rt_rwlock * ) pipc;
+
+    return ( ( rwlock->writer == RT_NULL ) && ( rwlock->readers == 0 ) ) ? 1 : 0;
+}
+
+static UBaseType_t prvRWLockSpacesAvailable( struct rt_ipc_object * pipc )
+{
+    return 1 - prvRWLockMessagesWaiting( pipc );
+}
+
+static void prvRWLockDelete( struct rt_ipc_object * pipc )
+{
+    struct rt_rwlock * rwlock = ( struct rt_rwlock * ) pipc;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    prvQueueWakeAll( &( rwlock->parent.suspend_thread ), -RT_ERROR );
+    prvQueueWakeAll( &( rwlock->suspend_writer_thread ), -RT_ERROR );
+    rt_list_remove( &( rwlock->taken_list ) );
+    rwlock->parent.parent.type = RT_Object_Class_Null;
+    rt_hw_interrupt_enable( level );
+    rt_schedule();
+}
+
+/* Indexed by queueKIND_* */
+static const QueueOperations_t xQueueOperations[ queueKIND_COUNT ] =
+{
+    {
+        prvMessageQueueSend, prvMessageQueueReceive,
+        prvMessageQueueSendMultiple, prvMessageQueueReceiveMultiple,
+        prvMessageQueueMessagesWaiting, prvMessageQueueSpacesAvailable,
+        prvMessageQueueReset, prvMessageQueueDelete
+    },
+    {
+        prvSpscQueueSend, prvSpscQueueReceive,
+        prvSpscQueueSendMultiple, prvSpscQueueReceiveMultiple,
+        prvSpscQueueMessagesWaiting, prvSpscQueueSpacesAvailable,
+        prvSpscQueueReset, prvSpscQueueDelete
+    },
+    {
+        prvMailboxQueueSend, prvMailboxQueueReceive,
+        prvMailboxQueueSendMultiple, prvMailboxQueueReceiveMultiple,
+        prvMailboxQueueMessagesWaiting, prvMailboxQueueSpacesAvailable,
+        prvMailboxQueueReset, prvMailboxQueueDelete
+    },
+    {
+        prvSemaphoreGive, prvSemaphoreTake,
+        NULL, NULL,
+        prvSemaphoreMessagesWaiting, prvSemaphoreSpacesAvailable,
+        prvSemaphoreReset, prvSemaphoreDelete
+    },
+    {
+        prvMutexGive, prvMutexTake,
+        NULL, NULL,
+        prvMutexMessagesWaiting, prvMutexSpacesAvailable,
+        NULL, prvMutexDelete
+    },
+    {
+        prvPriorityQueueSend, prvPriorityQueueReceive,
+        prvPriorityQueueSendMultiple, prvPriorityQueueReceiveMultiple,
+        prvPriorityQueueMessagesWaiting, prvPriorityQueueSpacesAvailable,
+        prvPriorityQueueReset, prvPriorityQueueDelete
+    },
+    {
+        prvBroadcastQueueSend, prvBroadcastQueueReceive,
+        prvBroadcastQueueSendMultiple, NULL,
+        prvBroadcastQueueMessagesWaiting, prvBroadcastQueueSpacesAvailable,
+        prvBroadcastQueueReset, prvBroadcastQueueDelete
+    },
+    {
+        prvSubscriberQueueSend, prvSubscriberQueueReceive,
+        NULL, prvSubscriberQueueReceiveMultiple,
+        prvSubscriberQueueMessagesWaiting, prvSubscriberQueueSpacesAvailable,
+        prvSubscriberQueueReset, prvSubscriberQueueDelete
+    },
+    {
+        prvRWLockQueueGive, prvRWLockQueueTake,
+        NULL, NULL,
+        prvRWLockMessagesWaiting, prvRWLockSpacesAvailable,
+        NULL, prvRWLockDelete
+    },
+#if ( configUSE_LEAN_MUTEXES == 1 )
+    {
+        prvLeanMutexGive, prvLeanMutexTake,
+        NULL, NULL,
+        prvLeanMutexMessagesWaiting, prvLeanMutexSpacesAvailable,
+        NULL, prvLeanMutexDelete
+    }
+#endif
+};
+
+#define prvQueueOperations( pxQueue )    ( &xQueueOperations[ ( pxQueue )->ucQueueKind ] )
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WATERMARKS == 1 )
+
+/*
+ * Report a queue that has just reached its high mark, or drained back to its
+ * low mark since.  Called after every call that changes the number of items,
+ * from tasks and interrupts alike, so the callback runs without the lock.
+ */
+    static void prvQueueCheckWatermarks( Queue_t * pxQueue )
+    {
+        QueueWatermarks_t * pxWatermarks = &( pxQueue->xWatermarks );
+        QueueWatermarkCallback_t pxCallback;
+        void * pvContext;
+        UBaseType_t uxMessages;
+        BaseType_t xCrossed = pdFALSE;
+        BaseType_t xAboveHighMark;
+        rt_base_t level;
+
+        /* Only a hint; the callback is read again, with its context, under
+         * the lock, since xQueueSetWatermarks() may change both at any time */
+        if ( pxWatermarks->pxCallback == NULL )
+        {
+            return;
+        }
+        level = rt_hw_interrupt_disable();
+        pxCallback = pxWatermarks->pxCallback;
+        pvContext = pxWatermarks->pvContext;
+        if ( pxCallback == NULL )
+        {
+            rt_hw_interrupt_enable( level );
+            return;
+        }
+        uxMessages = prvQueueOperations( pxQueue )->pxMessagesWaiting( pxQueue->rt_ipc );
+        if ( ( pxWatermarks->xAboveHighMark == pdFALSE ) && ( uxMessages >= pxWatermarks->uxHighMark ) )
+        {
+            pxWatermarks->xAboveHighMark = pdTRUE;
+            xCrossed = pdTRUE;
+        }
+        else if ( ( pxWatermarks->xAboveHighMark != pdFALSE ) && ( uxMessages <= pxWatermarks->uxLowMark ) )
+        {
+            pxWatermarks->xAboveHighMark = pdFALSE;
+            xCrossed = pdTRUE;
+        }
+        xAboveHighMark = pxWatermarks->xAboveHighMark;
+        rt_hw_interrupt_enable( level );
+
+        if ( xCrossed != pdFALSE )
+        {
+            pxCallback( pxQueue, xAboveHighMark, pvContext );
+        }
+    }
+
+#else /* configUSE_QUEUE_WATERMARKS */
+
+    #define prvQueueCheckWatermarks( pxQueue )
+
+#endif /* configUSE_QUEUE_WATERMARKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATISTICS == 1 ) || ( configUSE_QUEUE_WATERMARKS == 1 )
+
+/* Results of a call with no block time that a block time would wait out. */
+    #define prvQueueWouldBlock( err )    ( ( ( err ) == -RT_EFULL ) || ( ( err ) == -RT_EEMPTY ) || ( ( err ) == -RT_ETIMEOUT ) )
+
+/*
+ * Count items moved in or out of a queue, track the most items it has held
+ * and check its watermarks.  FromISR calls update the counters too, so they
+ * are changed with interrupts disabled.
+ */
+    static void prvQueueRecordSend( Queue_t * pxQueue,
+                                    UBaseType_t uxCount )
+    {
+    #if ( configUSE_QUEUE_STATISTICS == 1 )
+        UBaseType_t uxMessages = prvQueueOperations( pxQueue )->pxMessagesWaiting( pxQueue->rt_ipc );
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        pxQueue->xStatistics.ulSends += ( uint32_t ) uxCount;
+        if ( uxMessages > pxQueue->xStatistics.uxPeakMessages )
+        {
+            pxQueue->xStatistics.uxPeakMessages = uxMessages;
+        }
+        rt_hw_interrupt_enable( level );
+    #else
+        ( void ) uxCount;
+    #endif
+        prvQueueCheckWatermarks( pxQueue );
+    }
+
+    static void prvQueueRecordReceive( Queue_t * pxQueue,
+                                       UBaseType_t uxCount )
+    {
+    #if ( configUSE_QUEUE_STATISTICS == 1 )
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        pxQueue->xStatistics.ulReceives += ( uint32_t ) uxCount;
+        rt_hw_interrupt_enable( level );
+    #else
+        ( void ) uxCount;
+    #endif
+        prvQueueCheckWatermarks( pxQueue );
+    }
+
+    #if ( configUSE_QUEUE_STATISTICS == 1 )
+
+        static void prvQueueRecordBlocked( Queue_t * pxQueue,
+                                           BaseType_t xSending,
+                                           rt_tick_t xTicks )
+        {
+            rt_base_t level;
+
+            level = rt_hw_interrupt_disable();
+            if ( xSending != pdFALSE )
+            {
+                pxQueue->xStatistics.ulSendsBlocked++;
+            }
+            else
+            {
+                pxQueue->xStatistics.ulReceivesBlocked++;
+            }
+            pxQueue->xStatistics.xBlockedTicks += ( TickType_t ) xTicks;
+            rt_hw_interrupt_enable( level );
+        }
+
+    #else
+
+        #define prvQueueRecordBlocked( pxQueue, xSending, xTicks )    ( void ) ( xTicks )
+
+    #endif
+
+/*
+ * Accounting wrappers around the operations table.  Each call is first made
+ * with no block time, so a call that has to wait is seen, and only then
+ * repeated with the caller's block time.
+ */
+    static rt_err_t prvQueueSend( Queue_t * pxQueue,
+                                  const void * pvItemToQueue,
+                                  TickType_t xTicksToWait,
+                                  const BaseType_t xCopyPosition,
+                                  rt_bool_t * pxPosted )
+    {
+        const QueueOperations_t * pxOperations = prvQueueOperations( pxQueue );
+        rt_tick_t xStart;
+        rt_err_t err;
+
+        err = pxOperations->pxSend( pxQueue->rt_ipc, pvItemToQueue, 0, xCopyPosition, pxPosted );
+        if ( prvQueueWouldBlock( err ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+        {
+            xStart = rt_tick_get();
+            err = pxOperations->pxSend( pxQueue->rt_ipc, pvItemToQueue, xTicksToWait, xCopyPosition, pxPosted );
+            prvQueueRecordBlocked( pxQueue, pdTRUE, rt_tick_get() - xStart );
+        }
+        if ( err == RT_EOK )
+        {
+            prvQueueRecordSend( pxQueue, 1 );
+        }
+
+        return err;
+    }
+
+    static rt_err_t prvQueueReceive( Queue_t * pxQueue,
+                                     void * const pvBuffer,
+                                     TickType_t xTicksToWait )
+    {
+        const QueueOperations_t * pxOperations = prvQueueOperations( pxQueue );
+        rt_tick_t xStart;
+        rt_err_t err;
+
+        err = pxOperations->pxReceive( pxQueue->rt_ipc, pvBuffer, 0, pdFALSE );
+        if ( prvQueueWouldBlock( err ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+        {
+            xStart = rt_tick_get();
+            err = pxOperations->pxReceive( pxQueue->rt_ipc, pvBuffer, xTicksToWait, pdFALSE );
+            prvQueueRecordBlocked( pxQueue, pdFALSE, rt_tick_get() - xStart );
+        }
+        if ( err == RT_EOK )
+        {
+            prvQueueRecordReceive( pxQueue, 1 );
+        }
+
+        return err;
+    }
+
+    static UBaseType_t prvQueueSendMultiple( Queue_t * pxQueue,
+                                             const rt_uint8_t * pucItems,
+                                             UBaseType_t uxItemCount,
+                                             TickType_t xTicksToWait,
+                                             rt_bool_t * pxPosted )
+    {
+        const QueueOperations_t * pxOperations = prvQueueOperations( pxQueue );
+        UBaseType_t uxCount;
+        rt_tick_t xStart;
+
+        uxCount = pxOperations->pxSendMultiple( pxQueue->rt_ipc, pucItems, uxItemCount, 0, pxPosted );
+        if ( ( uxCount == 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+        {
+            xStart = rt_tick_get();
+            uxCount = pxOperations->pxSendMultiple( pxQueue->rt_ipc, pucItems, uxItemCount, xTicksToWait, pxPosted );
+            prvQueueRecordBlocked( pxQueue, pdTRUE, rt_tick_get() - xStart );
+        }
+        if ( uxCount != 0 )
+        {
+            prvQueueRecordSend( pxQueue, uxCount );
+        }
+
+        return uxCount;
+    }
+
+    static UBaseType_t prvQueueReceiveMultiple( Queue_t * pxQueue,
+                                                rt_uint8_t * pucBuffer,
+                                                UBaseType_t uxMaxItems,
+                                                TickType_t xTicksToWait )
+    {
+        const QueueOperations_t * pxOperations = prvQueueOperations( pxQueue );
+        UBaseType_t uxCount;
+        rt_tick_t xStart;
+
+        uxCount = pxOperations->pxReceiveMultiple( pxQueue->rt_ipc, pucBuffer, uxMaxItems, 0 );
+        if ( ( uxCount == 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+        {
+            xStart = rt_tick_get();
+            uxCount = pxOperations->pxReceiveMultiple( pxQueue->rt_ipc, pucBuffer, uxMaxItems, xTicksToWait );
+            prvQueueRecordBlocked( pxQueue, pdFALSE, rt_tick_get() - xStart );
+        }
+        if ( uxCount != 0 )
+        {
+            prvQueueRecordReceive( pxQueue, uxCount );
+        }
+
+        return uxCount;
+    }
+
+#else /* ( configUSE_QUEUE_STATISTICS == 1 ) || ( configUSE_QUEUE_WATERMARKS == 1 ) */
+
+    #define prvQueueRecordSend( pxQueue, uxCount )
+    #define prvQueueRecordReceive( pxQueue, uxCount )
+    #define prvQueueSend( pxQueue, pvItemToQueue, xTicksToWait, xCopyPosition, pxPosted ) \
+    prvQueueOperations( pxQueue )->pxSend( ( pxQueue )->rt_ipc, ( pvItemToQueue ), ( xTicksToWait ), ( xCopyPosition ), ( pxPosted ) )
+    #define prvQueueReceive( pxQueue, pvBuffer, xTicksToWait ) \
+    prvQueueOperations( pxQueue )->pxReceive( ( pxQueue )->rt_ipc, ( pvBuffer ), ( xTicksToWait ), pdFALSE )
+    #define prvQueueSendMultiple( pxQueue, pucItems, uxItemCount, xTicksToWait, pxPosted ) \
+    prvQueueOperations( pxQueue )->pxSendMultiple( ( pxQueue )->rt_ipc, ( pucItems ), ( uxItemCount ), ( xTicksToWait ), ( pxPosted ) )
+    #define prvQueueReceiveMultiple( pxQueue, pucBuffer, uxMaxItems, xTicksToWait ) \
+    prvQueueOperations( pxQueue )->pxReceiveMultiple( ( pxQueue )->rt_ipc, ( pucBuffer ), ( uxMaxItems ), ( xTicksToWait ) )
+
+#endif /* ( configUSE_QUEUE_STATISTICS == 1 ) || ( configUSE_QUEUE_WATERMARKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+/* Profiled mutexes, newest first, walked by the mutex_stats command */
+    static Queue_t * pxProfiledMutexes = NULL;
+
+    #define prvMutexProfileOf( pxQueue )    ( ( StaticSemaphore_t * ) ( pxQueue ) )
+
+/* Histogram bucket of a time: 0 for 0, n for 2^(n-1) up to 2^n - 1. */
+    static UBaseType_t prvMutexProfileBucket( uint32_t ulTime )
+    {
+        UBaseType_t uxBucket = 0;
+
+        while ( ( ulTime != 0 ) && ( uxBucket < ( UBaseType_t ) ( configMUTEX_PROFILING_BUCKETS - 1 ) ) )
+        {
+            ulTime >>= 1;
+            uxBucket++;
+        }
+
+        return uxBucket;
+    }
+
+/*
+ * Whether the calling task holds the mutex exactly once, that is, whether it
+ * has just acquired it or is about to release it.  Called with interrupts
+ * disabled.
+ */
+    static BaseType_t prvMutexHeldOnce( Queue_t * pxQueue )
+    {
+        rt_thread_t thread = rt_thread_self();
+
+    #if ( configUSE_LEAN_MUTEXES == 1 )
+        if ( pxQueue->ucQueueKind == queueKIND_LEAN_MUTEX )
+        {
+            return prvLeanMutexOwner( ( struct rt_lean_mutex * ) pxQueue->rt_ipc ) == thread;
+        }
+    #endif
+
+        return ( ( ( rt_mutex_t ) pxQueue->rt_ipc )->owner == thread ) && ( ( ( rt_mutex_t ) pxQueue->rt_ipc )->hold == 1 );
+    }
+
+    static void prvMutexProfileInit( Queue_t * pxQueue )
+    {
+        StaticSemaphore_t * const pxMutex = prvMutexProfileOf( pxQueue );
+        rt_base_t level;
+
+        rt_memset( &( pxMutex->xMutexProfile ), 0, sizeof( MutexProfile_t ) );
+        pxMutex->ulHoldStart = 0;
+
+        level = rt_hw_interrupt_disable();
+        pxMutex->pxNextProfiledMutex = pxProfiledMutexes;
+        pxProfiledMutexes = pxQueue;
+        rt_hw_interrupt_enable( level );
+    }
+
+    static void prvMutexProfileRemove( Queue_t * pxQueue )
+    {
+        struct QueueDefinition ** ppxLink;
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        for ( ppxLink = &pxProfiledMutexes; *ppxLink != NULL; ppxLink = &( prvMutexProfileOf( *ppxLink )->pxNextProfiledMutex ) )
+        {
+            if ( *ppxLink == pxQueue )
+            {
+                *ppxLink = prvMutexProfileOf( pxQueue )->pxNextProfiledMutex;
+                break;
+            }
+        }
+        rt_hw_interrupt_enable( level );
+    }
+
+/*
+ * Take a mutex, timing the wait if it is held by another task.  As in
+ * prvQueueReceive(), the take is first tried with no block time so that a
+ * contended take is seen.
+ */
+    static rt_err_t prvMutexProfiledTake( Queue_t * pxQueue,
+                                          TickType_t xTicksToWait )
+    {
+        StaticSemaphore_t * const pxMutex = prvMutexProfileOf( pxQueue );
+        MutexProfile_t * const pxProfile = &( pxMutex->xMutexProfile );
+        const uint32_t ulStart = configMUTEX_PROFILING_CLOCK();
+        BaseType_t xContended = pdFALSE;
+        uint32_t ulNow;
+        uint32_t ulWait;
+        rt_err_t err;
+        rt_base_t level;
+
+        err = prvQueueOperations( pxQueue )->pxReceive( pxQueue->rt_ipc, NULL, 0, pdFALSE );
+        if ( err == RT_EOK )
+        {
+            prvQueueRecordReceive( pxQueue, 1 );
+        }
+        else if ( xTicksToWait != ( TickType_t ) 0 )
+        {
+            xContended = pdTRUE;
+            err = prvQueueReceive( pxQueue, NULL, xTicksToWait );
+        }
+        ulNow = configMUTEX_PROFILING_CLOCK();
+        ulWait = ulNow - ulStart;
+
+        level = rt_hw_interrupt_disable();
+        if ( err == RT_EOK )
+        {
+            /* Nested takes of a recursive mutex are not acquisitions */
+            if ( prvMutexHeldOnce( pxQueue ) != pdFALSE )
+            {
+                pxProfile->ulAcquisitions++;
+                pxMutex->ulHoldStart = ulNow;
+                if ( xContended != pdFALSE )
+                {
+                    pxProfile->ulContended++;
+                    pxProfile->ullTotalWait += ulWait;
+                    if ( ulWait > pxProfile->ulMaxWait )
+                    {
+                        pxProfile->ulMaxWait = ulWait;
+                    }
+                    pxProfile->ulWaitHistogram[ prvMutexProfileBucket( ulWait ) ]++;
+                }
+            }
+        }
+        else if ( xContended != pdFALSE )
+        {
+            pxProfile->ulTimeouts++;
+        }
+        rt_hw_interrupt_enable( level );
+
+        return err;
+    }
+
+/*
+ * Give a mutex, timing how long it was held if the give releases it.
+ */
+    static rt_err_t prvMutexProfiledGive( Queue_t * pxQueue,
+                                          rt_bool_t * pxPosted )
+    {
+        StaticSemaphore_t * const pxMutex = prvMutexProfileOf( pxQueue );
+        MutexProfile_t * const pxProfile = &( pxMutex->xMutexProfile );
+        rt_thread_t thread = rt_thread_self();
+        BaseType_t xReleasing;
+        uint32_t ulHeldSince;
+        uint32_t ulHold;
+        rt_err_t err;
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        xReleasing = prvMutexHeldOnce( pxQueue );
+        ulHeldSince = pxMutex->ulHoldStart;
+        rt_hw_interrupt_enable( level );
+
+        err = prvQueueSend( pxQueue, NULL, 0, queueSEND_TO_BACK, pxPosted );
+        if ( ( err == RT_EOK ) && ( xReleasing != pdFALSE ) )
+        {
+            ulHold = configMUTEX_PROFILING_CLOCK() - ulHeldSince;
+
+            level = rt_hw_interrupt_disable();
+            pxProfile->ulHoldHistogram[ prvMutexProfileBucket( ulHold ) ]++;
+            if ( ( ulHold > pxProfile->ulMaxHold ) || ( pxProfile->xMaxHoldTask == NULL ) )
+            {
+                pxProfile->ulMaxHold = ulHold;
+                pxProfile->xMaxHoldTask = ( struct tskTaskControlBlock * ) thread;
+                /* Keep the name too, the task may be gone when it is read */
+            #if RT_VER_NUM < 0x50000
+                rt_strncpy( pxProfile->pcMaxHoldTaskName, thread->name, sizeof( pxProfile->pcMaxHoldTaskName ) - 1 );
+            #else
+                rt_strncpy( pxProfile->pcMaxHoldTaskName, thread->parent.name, sizeof( pxProfile->pcMaxHoldTaskName ) - 1 );
+            #endif
+                pxProfile->pcMaxHoldTaskName[ sizeof( pxProfile->pcMaxHoldTaskName ) - 1 ] = '\0';
+            }
+            rt_hw_interrupt_enable( level );
+        }
+
+        return err;
+    }
+
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
+                               BaseType_t xNewQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+    const QueueOperations_t * pxOperations;
+
+    configASSERT( pxQueue );
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+
+    /* Resetting rebuilds the free space, which a held slot would then be
+     * linked into a second time when it is committed or released */
+    configASSERT( pxQueue->usSlotsHeld == 0 );
+
+    pxOperations = prvQueueOperations( pxQueue );
+    if ( pxOperations->pxReset != NULL )
+    {
+        pxOperations->pxReset( pxQueue->rt_ipc );
+        prvQueueCheckWatermarks( pxQueue );
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise the kernel object of a new queue, semaphore or mutex in place,
+ * then the handle in front of it.  Static and dynamic handles share the layout
+ * of StaticQueue_t, or of StaticSemaphore_t for semaphores and mutexes.
+ * Returns NULL if the queue type is not supported.
+ */
+static QueueHandle_t prvInitialiseQueueObject( StaticQueue_t * pxStaticQueue,
+                                               const UBaseType_t uxQueueLength,
+                                               const UBaseType_t uxItemSize,
+                                               uint8_t * pucQueueStorage,
+                                               const uint8_t ucQueueType,
+                                               const uint8_t ucAllocation )
+{
+    StaticSemaphore_t * pxStaticSemaphore = ( StaticSemaphore_t * ) pxStaticQueue;
+    struct rt_ipc_object * pipc;
+    char name[RT_NAME_MAX];
+    uint8_t ucQueueKind;
+
+#if ( configUSE_LEAN_MUTEXES == 1 )
+    if ( ucQueueType == queueQUEUE_TYPE_MUTEX )
+    {
+        prvQueueName( name, "mutex", mutex_index++ );
+        prvLeanMutexInit( &( pxStaticSemaphore->ipc_obj.lean_mutex ), name );
+        pipc = ( struct rt_ipc_object * ) &( pxStaticSemaphore->ipc_obj );
+        ucQueueKind = queueKIND_LEAN_MUTEX;
+    }
+    else
+#endif
+    if ( ucQueueType == queueQUEUE_TYPE_RECURSIVE_MUTEX || ucQueueType == queueQUEUE_TYPE_MUTEX )
+    {
+        prvQueueName( name, "mutex", mutex_index++ );
+        rt_mutex_init( &( pxStaticSemaphore->ipc_obj.mutex ), name, RT_IPC_FLAG_PRIO );
+        pipc = ( struct rt_ipc_object * ) &( pxStaticSemaphore->ipc_obj );
+        ucQueueKind = queueKIND_MUTEX;
+    }
+    else if ( ucQueueType == queueQUEUE_TYPE_RWLOCK )
+    {
+        prvQueueName( name, "rwl", mutex_index++ );
+        prvRWLockInit( &( pxStaticSemaphore->ipc_obj.rwlock ), name );
+        pipc = ( struct rt_ipc_object * ) &( pxStaticSemaphore->ipc_obj );
+        ucQueueKind = queueKIND_RWLOCK;
+    }
+    else if ( ucQueueType == queueQUEUE_TYPE_BINARY_SEMAPHORE || ucQueueType == queueQUEUE_TYPE_COUNTING_SEMAPHORE )
+    {
+        prvQueueName( name, "sem", sem_index++ );
+    #if ( configUSE_NATIVE_SEMAPHORES == 1 )
+        prvNativeSemaphoreInit( &( pxStaticSemaphore->ipc_obj.semaphore ), name, uxQueueLength );
+    #else
+        rt_sem_init( ( rt_sem_t ) &( pxStaticSemaphore->ipc_obj.semaphore ), name, 0, RT_IPC_FLAG_PRIO );
+        pxStaticSemaphore->ipc_obj.semaphore.max_value = uxQueueLength;
+    #endif
+        pipc = ( struct rt_ipc_object * ) &( pxStaticSemaphore->ipc_obj );
+        ucQueueKind = queueKIND_SEMAPHORE;
+    }
+    else if ( ucQueueType == queueQUEUE_TYPE_BASE )
+    {
+        prvQueueName( name, "queue", queue_index++ );
+    #if ( configUSE_QUEUE_RING_BUFFER == 1 )
+        configASSERT( ( uxQueueLength <= 0xFFFF ) && ( uxItemSize <= 0xFFFF ) );
+        prvRingInit( &( pxStaticQueue->ipc_obj.mq ), name, pucQueueStorage, uxQueueLength, uxItemSize );
+    #else
+        rt_mq_init( &( pxStaticQueue->ipc_obj.mq ), name, pucQueueStorage, uxItemSize, QUEUE_BUFFER_SIZE( uxQueueLength, uxItemSize ), RT_IPC_FLAG_PRIO );
+        prvMqCheckLayout( &( pxStaticQueue->ipc_obj.mq ) );
+    #endif
+        pipc = ( struct rt_ipc_object * ) &( pxStaticQueue->ipc_obj );
+        ucQueueKind = queueKIND_MESSAGE_QUEUE;
+    }
+    else
+    {
+        return NULL;
+    }
+    prvInitialiseNewQueue( ( Queue_t * ) pxStaticQueue, pipc, ucQueueKind, ucAllocation );
+#if ( configUSE_MUTEX_PROFILING == 1 )
+    if ( prvQueueIsMutex( ( Queue_t * ) pxStaticQueue ) )
+    {
+        prvMutexProfileInit( ( Queue_t * ) pxStaticQueue );
+    }
+#endif
+
+    return ( QueueHandle_t ) pxStaticQueue;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueGenericCreateStatic( const UBaseType_t uxQueueLength,
+                                             const UBaseType_t uxItemSize,
+                                             uint8_t * pucQueueStorage,
+                                             StaticQueue_t * pxStaticQueue,
+                                             const uint8_t ucQueueType )
+    {
+        Queue_t * pxNewQueue = NULL;
+
+        /* The StaticQueue_t structure and the queue storage area must be
+         * supplied. */
+        configASSERT( pxStaticQueue );
+
+        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+            ( pxStaticQueue != NULL ) &&
+
+            /* A queue storage area should be provided if the item size is not 0, and
+             * should not be provided if the item size is 0. */
+            ( !( ( pucQueueStorage != NULL ) && ( uxItemSize == 0 ) ) ) &&
+            ( !( ( pucQueueStorage == NULL ) && ( uxItemSize != 0 ) ) ) )
+        {
+            pxNewQueue = prvInitialiseQueueObject( pxStaticQueue, uxQueueLength, uxItemSize, pucQueueStorage, ucQueueType, queueALLOCATED_STATICALLY );
+        }
+
+        return pxNewQueue;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueGenericCreate( const UBaseType_t uxQueueLength,
+                                       const UBaseType_t uxItemSize,
+                                       const uint8_t ucQueueType )
+    {
+        Queue_t * pxNewQueue = NULL;
+        rt_size_t xHandleSize;
+        rt_size_t xStorageSize = 0;
+        uint8_t ucAllocation;
+
+        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+            /* Check for multiplication overflow. */
+            ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
+            /* Check for addition overflow. */
+            ( ( SIZE_MAX - sizeof( StaticQueue_t ) ) >= ( uxQueueLength * uxItemSize ) ) )
+        {
+            if ( ucQueueType == queueQUEUE_TYPE_RECURSIVE_MUTEX || ucQueueType == queueQUEUE_TYPE_MUTEX ||
+                 ucQueueType == queueQUEUE_TYPE_BINARY_SEMAPHORE || ucQueueType == queueQUEUE_TYPE_COUNTING_SEMAPHORE ||
+                 ucQueueType == queueQUEUE_TYPE_RWLOCK )
+            {
+                xHandleSize = sizeof( StaticSemaphore_t );
+            }
+            else if ( ucQueueType == queueQUEUE_TYPE_BASE )
+            {
+                /* The storage follows the handle in the same block */
+                xHandleSize = RT_ALIGN( sizeof( StaticQueue_t ), RT_ALIGN_SIZE );
+                xStorageSize = QUEUE_BUFFER_SIZE( uxQueueLength, uxItemSize );
+            }
+            else
+            {
                 return NULL;
             }
-            pxNewQueue->rt_ipc = pipc;
+            pxNewQueue = prvQueueAllocate( xHandleSize + xStorageSize, &ucAllocation );
+            if ( pxNewQueue != NULL )
+            {
+                prvInitialiseQueueObject( ( StaticQueue_t * ) pxNewQueue, uxQueueLength, uxItemSize,
+                                          ( uint8_t * ) pxNewQueue + xHandleSize, ucQueueType, ucAllocation );
+            }
+        }
+
+        return ( QueueHandle_t ) pxNewQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueCreateSPSCStatic( const UBaseType_t uxQueueLength,
+                                          const UBaseType_t uxItemSize,
+                                          uint8_t * pucQueueStorage,
+                                          StaticQueue_t * pxStaticQueue )
+    {
+        char name[RT_NAME_MAX];
+
+        configASSERT( pxStaticQueue );
+        configASSERT( pucQueueStorage );
+        configASSERT( ( uxQueueLength <= 0xFFFF ) && ( uxItemSize <= 0xFFFF ) );
+
+        if ( ( uxQueueLength == ( UBaseType_t ) 0 ) || ( uxItemSize == ( UBaseType_t ) 0 ) ||
+             ( pucQueueStorage == NULL ) || ( pxStaticQueue == NULL ) )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "spsc", queue_index++ );
+        prvSpscInit( &( pxStaticQueue->ipc_obj.spsc ), name, pucQueueStorage, uxQueueLength, uxItemSize );
+        prvInitialiseNewQueue( ( Queue_t * ) pxStaticQueue, ( struct rt_ipc_object * ) &pxStaticQueue->ipc_obj, queueKIND_SPSC, queueALLOCATED_STATICALLY );
+
+        return ( QueueHandle_t ) pxStaticQueue;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueCreateSPSC( const UBaseType_t uxQueueLength,
+                                    const UBaseType_t uxItemSize )
+    {
+        StaticQueue_t * pxNewQueue;
+        const rt_size_t xHandleSize = RT_ALIGN( sizeof( StaticQueue_t ), RT_ALIGN_SIZE );
+        char name[RT_NAME_MAX];
+        uint8_t ucAllocation;
+
+        configASSERT( ( uxQueueLength <= 0xFFFF ) && ( uxItemSize <= 0xFFFF ) );
+
+        if ( ( uxQueueLength == ( UBaseType_t ) 0 ) || ( uxItemSize == ( UBaseType_t ) 0 ) )
+        {
+            return NULL;
+        }
+        /* Handle, control block and storage come from a single allocation */
+        pxNewQueue = ( StaticQueue_t * ) prvQueueAllocate( xHandleSize + uxQueueLength * uxItemSize, &ucAllocation );
+        if ( pxNewQueue == NULL )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "spsc", queue_index++ );
+        prvSpscInit( &( pxNewQueue->ipc_obj.spsc ), name, ( rt_uint8_t * ) pxNewQueue + xHandleSize, uxQueueLength, uxItemSize );
+        prvInitialiseNewQueue( ( Queue_t * ) pxNewQueue, ( struct rt_ipc_object * ) &pxNewQueue->ipc_obj, queueKIND_SPSC, ucAllocation );
+
+        return ( QueueHandle_t ) pxNewQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueCreateMailboxStatic( const UBaseType_t uxItemSize,
+                                             uint8_t * pucMailboxStorage,
+                                             StaticQueue_t * pxStaticQueue )
+    {
+        char name[RT_NAME_MAX];
+
+        configASSERT( pxStaticQueue );
+        configASSERT( pucMailboxStorage );
+        configASSERT( uxItemSize <= 0xFFFF );
+
+        if ( ( uxItemSize == ( UBaseType_t ) 0 ) || ( pucMailboxStorage == NULL ) || ( pxStaticQueue == NULL ) )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "mbox", queue_index++ );
+        prvMailboxInit( &( pxStaticQueue->ipc_obj.mailbox ), name, pucMailboxStorage, uxItemSize );
+        prvInitialiseNewQueue( ( Queue_t * ) pxStaticQueue, ( struct rt_ipc_object * ) &pxStaticQueue->ipc_obj, queueKIND_MAILBOX, queueALLOCATED_STATICALLY );
+
+        return ( QueueHandle_t ) pxStaticQueue;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueCreateMailbox( const UBaseType_t uxItemSize )
+    {
+        StaticQueue_t * pxNewQueue;
+        const rt_size_t xHandleSize = RT_ALIGN( sizeof( StaticQueue_t ), RT_ALIGN_SIZE );
+        char name[RT_NAME_MAX];
+        uint8_t ucAllocation;
+
+        configASSERT( uxItemSize <= 0xFFFF );
+
+        if ( uxItemSize == ( UBaseType_t ) 0 )
+        {
+            return NULL;
+        }
+        /* Handle, control block and value come from a single allocation */
+        pxNewQueue = ( StaticQueue_t * ) prvQueueAllocate( xHandleSize + uxItemSize, &ucAllocation );
+        if ( pxNewQueue == NULL )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "mbox", queue_index++ );
+        prvMailboxInit( &( pxNewQueue->ipc_obj.mailbox ), name, ( rt_uint8_t * ) pxNewQueue + xHandleSize, uxItemSize );
+        prvInitialiseNewQueue( ( Queue_t * ) pxNewQueue, ( struct rt_ipc_object * ) &pxNewQueue->ipc_obj, queueKIND_MAILBOX, ucAllocation );
+
+        return ( QueueHandle_t ) pxNewQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueCreatePriorityStatic( const UBaseType_t uxQueueLength,
+                                              const UBaseType_t uxItemSize,
+                                              const UBaseType_t uxPriorityLevels,
+                                              uint8_t * pucQueueStorage,
+                                              StaticQueue_t * pxStaticQueue )
+    {
+        char name[RT_NAME_MAX];
+
+        configASSERT( pxStaticQueue );
+        configASSERT( pucQueueStorage );
+        configASSERT( ( ( rt_ubase_t ) pucQueueStorage & ( sizeof( rt_uint16_t ) - 1U ) ) == 0U );
+        configASSERT( ( uxQueueLength < 0xFFFF ) && ( uxItemSize <= 0xFFFF ) && ( uxPriorityLevels <= 32 ) );
+
+        if ( ( uxQueueLength == ( UBaseType_t ) 0 ) || ( uxItemSize == ( UBaseType_t ) 0 ) ||
+             ( uxPriorityLevels == ( UBaseType_t ) 0 ) || ( pucQueueStorage == NULL ) || ( pxStaticQueue == NULL ) )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "prioq", queue_index++ );
+        prvPriorityInit( &( pxStaticQueue->ipc_obj.priority ), name, pucQueueStorage, uxQueueLength, uxItemSize, uxPriorityLevels );
+        prvInitialiseNewQueue( ( Queue_t * ) pxStaticQueue, ( struct rt_ipc_object * ) &pxStaticQueue->ipc_obj, queueKIND_PRIORITY, queueALLOCATED_STATICALLY );
+
+        return ( QueueHandle_t ) pxStaticQueue;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueCreatePriority( const UBaseType_t uxQueueLength,
+                                        const UBaseType_t uxItemSize,
+                                        const UBaseType_t uxPriorityLevels )
+    {
+        StaticQueue_t * pxNewQueue;
+        const rt_size_t xHandleSize = RT_ALIGN( sizeof( StaticQueue_t ), RT_ALIGN_SIZE );
+        char name[RT_NAME_MAX];
+        uint8_t ucAllocation;
+
+        configASSERT( ( uxQueueLength < 0xFFFF ) && ( uxItemSize <= 0xFFFF ) && ( uxPriorityLevels <= 32 ) );
+
+        if ( ( uxQueueLength == ( UBaseType_t ) 0 ) || ( uxItemSize == ( UBaseType_t ) 0 ) ||
+             ( uxPriorityLevels == ( UBaseType_t ) 0 ) )
+        {
+            return NULL;
+        }
+        /* Handle, control block, slots and links come from a single allocation */
+        pxNewQueue = ( StaticQueue_t * ) prvQueueAllocate( xHandleSize + PRIORITY_QUEUE_BUFFER_SIZE( uxQueueLength, uxItemSize, uxPriorityLevels ), &ucAllocation );
+        if ( pxNewQueue == NULL )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "prioq", queue_index++ );
+        prvPriorityInit( &( pxNewQueue->ipc_obj.priority ), name, ( rt_uint8_t * ) pxNewQueue + xHandleSize, uxQueueLength, uxItemSize, uxPriorityLevels );
+        prvInitialiseNewQueue( ( Queue_t * ) pxNewQueue, ( struct rt_ipc_object * ) &pxNewQueue->ipc_obj, queueKIND_PRIORITY, ucAllocation );
+
+        return ( QueueHandle_t ) pxNewQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueCreateBroadcastStatic( const UBaseType_t uxQueueLength,
+                                               const UBaseType_t uxItemSize,
+                                               const uint8_t ucPolicy,
+                                               uint8_t * pucQueueStorage,
+                                               StaticQueue_t * pxStaticQueue )
+    {
+        char name[RT_NAME_MAX];
+
+        configASSERT( pxStaticQueue );
+        configASSERT( pucQueueStorage );
+        configASSERT( ( uxQueueLength <= 0xFFFF ) && ( uxItemSize <= 0xFFFF ) && ( ucPolicy <= queueBROADCAST_DROP_OLDEST ) );
+
+        if ( ( uxQueueLength == ( UBaseType_t ) 0 ) || ( uxItemSize == ( UBaseType_t ) 0 ) ||
+             ( pucQueueStorage == NULL ) || ( pxStaticQueue == NULL ) )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "bcast", queue_index++ );
+        prvBroadcastInit( &( pxStaticQueue->ipc_obj.broadcast ), name, pucQueueStorage, uxQueueLength, uxItemSize, ucPolicy );
+        prvInitialiseNewQueue( ( Queue_t * ) pxStaticQueue, ( struct rt_ipc_object * ) &pxStaticQueue->ipc_obj, queueKIND_BROADCAST, queueALLOCATED_STATICALLY );
+
+        return ( QueueHandle_t ) pxStaticQueue;
+    }
+/*-----------------------------------------------------------*/
+
+    QueueHandle_t xQueueSubscribeStatic( QueueHandle_t xBroadcastQueue,
+                                         StaticQueue_t * pxStaticQueue )
+    {
+        char name[RT_NAME_MAX];
+
+        configASSERT( xBroadcastQueue );
+        configASSERT( xBroadcastQueue->ucQueueKind == queueKIND_BROADCAST );
+        configASSERT( pxStaticQueue );
+
+        if ( pxStaticQueue == NULL )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "sub", queue_index++ );
+        prvSubscriberInit( &( pxStaticQueue->ipc_obj.subscriber ), name );
+        prvInitialiseNewQueue( ( Queue_t * ) pxStaticQueue, ( struct rt_ipc_object * ) &pxStaticQueue->ipc_obj, queueKIND_SUBSCRIBER, queueALLOCATED_STATICALLY );
+        prvBroadcastSubscribe( ( struct rt_broadcast_queue * ) xBroadcastQueue->rt_ipc, &( pxStaticQueue->ipc_obj.subscriber ) );
+
+        return ( QueueHandle_t ) pxStaticQueue;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    QueueHandle_t xQueueCreateBroadcast( const UBaseType_t uxQueueLength,
+                                         const UBaseType_t uxItemSize,
+                                         const uint8_t ucPolicy )
+    {
+        StaticQueue_t * pxNewQueue;
+        const rt_size_t xHandleSize = RT_ALIGN( sizeof( StaticQueue_t ), RT_ALIGN_SIZE );
+        char name[RT_NAME_MAX];
+        uint8_t ucAllocation;
+
+        configASSERT( ( uxQueueLength <= 0xFFFF ) && ( uxItemSize <= 0xFFFF ) && ( ucPolicy <= queueBROADCAST_DROP_OLDEST ) );
+
+        if ( ( uxQueueLength == ( UBaseType_t ) 0 ) || ( uxItemSize == ( UBaseType_t ) 0 ) )
+        {
+            return NULL;
+        }
+        /* Handle, control block and the shared ring come from a single allocation */
+        pxNewQueue = ( StaticQueue_t * ) prvQueueAllocate( xHandleSize + uxQueueLength * uxItemSize, &ucAllocation );
+        if ( pxNewQueue == NULL )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "bcast", queue_index++ );
+        prvBroadcastInit( &( pxNewQueue->ipc_obj.broadcast ), name, ( rt_uint8_t * ) pxNewQueue + xHandleSize, uxQueueLength, uxItemSize, ucPolicy );
+        prvInitialiseNewQueue( ( Queue_t * ) pxNewQueue, ( struct rt_ipc_object * ) &pxNewQueue->ipc_obj, queueKIND_BROADCAST, ucAllocation );
+
+        return ( QueueHandle_t ) pxNewQueue;
+    }
+/*-----------------------------------------------------------*/
+
+    QueueHandle_t xQueueSubscribe( QueueHandle_t xBroadcastQueue )
+    {
+        StaticQueue_t * pxNewQueue;
+        char name[RT_NAME_MAX];
+        uint8_t ucAllocation;
+
+        configASSERT( xBroadcastQueue );
+        configASSERT( xBroadcastQueue->ucQueueKind == queueKIND_BROADCAST );
+
+        pxNewQueue = ( StaticQueue_t * ) prvQueueAllocate( sizeof( StaticQueue_t ), &ucAllocation );
+        if ( pxNewQueue == NULL )
+        {
+            return NULL;
+        }
+        prvQueueName( name, "sub", queue_index++ );
+        prvSubscriberInit( &( pxNewQueue->ipc_obj.subscriber ), name );
+        prvInitialiseNewQueue( ( Queue_t * ) pxNewQueue, ( struct rt_ipc_object * ) &pxNewQueue->ipc_obj, queueKIND_SUBSCRIBER, ucAllocation );
+        prvBroadcastSubscribe( ( struct rt_broadcast_queue * ) xBroadcastQueue->rt_ipc, &( pxNewQueue->ipc_obj.subscriber ) );
+
+        return ( QueueHandle_t ) pxNewQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, ucQueueType );
+        return xNewQueue;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
+                                           StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        xNewQueue = xQueueGenericCreateStatic( uxMutexLength, uxMutexSize, NULL, pxStaticQueue, ucQueueType );
+
+        return xNewQueue;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+
+    TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
+    {
+        TaskHandle_t pxReturn;
+        struct rt_ipc_object *pipc;
+        rt_base_t level;
+
+        configASSERT( xSemaphore );
+
+        pipc = xSemaphore->rt_ipc;
+        RT_ASSERT( pipc != RT_NULL );
+
+        if ( xSemaphore->ucQueueKind == queueKIND_MUTEX )
+        {
+            level = rt_hw_interrupt_disable();
+            pxReturn = ( TaskHandle_t ) ( ( rt_mutex_t ) pipc )->owner;
+            rt_hw_interrupt_enable( level );
+        }
+    #if ( configUSE_LEAN_MUTEXES == 1 )
+        else if ( xSemaphore->ucQueueKind == queueKIND_LEAN_MUTEX )
+        {
+            pxReturn = ( TaskHandle_t ) prvLeanMutexOwner( ( struct rt_lean_mutex * ) pipc );
+        }
+    #endif
+        else
+        {
+            pxReturn = NULL;
+        }
+
+        return pxReturn;
+    }
+
+#endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+
+    TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore )
+    {
+        return xQueueGetMutexHolder( xSemaphore );
+    }
+
+#endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+    BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
+    {
+        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+        configASSERT( pxMutex );
+        return xQueueGenericSend( pxMutex, NULL, queueMUTEX_GIVE_BLOCK_TIME, queueSEND_TO_BACK );
+    }
+
+#endif /* configUSE_RECURSIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+
+    BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex,
+                                         TickType_t xTicksToWait )
+    {
+        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+        configASSERT( pxMutex );
+        return xQueueSemaphoreTake( pxMutex, xTicksToWait );
+    }
+
+#endif /* configUSE_RECURSIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
+                                                       const UBaseType_t uxInitialCount,
+                                                       StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xHandle = NULL;
+
+        if( ( uxMaxCount != 0 ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
+            {
+                prvSemaphoreSetCount( ( ( Queue_t * ) xHandle )->rt_ipc, uxInitialCount );
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+        }
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
+                                                 const UBaseType_t uxInitialCount )
+    {
+        QueueHandle_t xHandle = NULL;
+
+        if( ( uxMaxCount != 0 ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
+            {
+                prvSemaphoreSetCount( ( ( Queue_t * ) xHandle )->rt_ipc, uxInitialCount );
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+        }
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
+                              const void * const pvItemToQueue,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xCopyPosition )
+{
+    Queue_t * const pxQueue = xQueue;
+    rt_bool_t xPosted = RT_TRUE;
+    rt_err_t err;
+
+    configASSERT( pxQueue );
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+    #if ( configUSE_MUTEX_PROFILING == 1 )
+        if ( prvQueueIsMutex( pxQueue ) )
+        {
+            err = prvMutexProfiledGive( pxQueue, &xPosted );
+        }
+        else
+    #endif
+    {
+        err = prvQueueSend( pxQueue, pvItemToQueue, xTicksToWait, xCopyPosition, &xPosted );
+    }
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        if ( ( err == RT_EOK ) && ( xPosted == RT_TRUE ) )
+        {
+            prvNotifyQueueSetContainer( pxQueue );
+        }
+    #endif
+
+    return rt_err_to_freertos( err );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
+                                     const void * const pvItemToQueue,
+                                     BaseType_t * const pxHigherPriorityTaskWoken,
+                                     const BaseType_t xCopyPosition )
+{
+    Queue_t * const pxQueue = xQueue;
+    rt_bool_t xPosted = RT_TRUE;
+    BaseType_t xPreviousYield;
+    rt_err_t err;
+
+    configASSERT( pxQueue );
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+    RT_ASSERT( !prvQueueIsMutex( pxQueue ) && ( pxQueue->ucQueueKind != queueKIND_RWLOCK ) );
+
+    xPreviousYield = xPortIsrYieldBegin();
+    err = prvQueueSend( pxQueue, pvItemToQueue, 0, xCopyPosition, &xPosted );
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        if ( ( err == RT_EOK ) && ( xPosted == RT_TRUE ) )
+        {
+            prvNotifyQueueSetContainer( pxQueue );
+        }
+    #endif
+    vPortIsrYieldEnd( xPreviousYield, pxHigherPriorityTaskWoken );
+
+    return rt_err_to_freertos( err );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
+                              BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    Queue_t * const pxQueue = xQueue;
+    BaseType_t xPreviousYield;
+    rt_err_t err;
+
+    configASSERT( pxQueue );
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+    RT_ASSERT( pxQueue->ucQueueKind == queueKIND_SEMAPHORE );
+
+    xPreviousYield = xPortIsrYieldBegin();
+    err = prvQueueSend( pxQueue, NULL, 0, queueSEND_TO_BACK, NULL );
+    #if ( configUSE_QUEUE_SETS == 1 )
+        if ( err == RT_EOK )
+        {
+            prvNotifyQueueSetContainer( pxQueue );
+        }
+    #endif
+    vPortIsrYieldEnd( xPreviousYield, pxHigherPriorityTaskWoken );
+
+    return rt_err_to_freertos( err );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue,
+                          void * const pvBuffer,
+                          TickType_t xTicksToWait )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    /* Check the queue pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+
+    return rt_err_to_freertos( prvQueueReceive( pxQueue, pvBuffer, xTicksToWait ) );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                TickType_t xTicksToWait )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    /* Check the queue pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+    RT_ASSERT( ( pxQueue->ucQueueKind == queueKIND_SEMAPHORE ) || prvQueueIsMutex( pxQueue ) );
+
+    #if ( configUSE_MUTEX_PROFILING == 1 )
+        if ( prvQueueIsMutex( pxQueue ) )
+        {
+            return rt_err_to_freertos( prvMutexProfiledTake( pxQueue, xTicksToWait ) );
+        }
+    #endif
+
+    return rt_err_to_freertos( prvQueueReceive( pxQueue, NULL, xTicksToWait ) );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueTakeRWLock( QueueHandle_t xRWLock,
+                             TickType_t xTicksToWait,
+                             BaseType_t xWrite )
+{
+    Queue_t * const pxQueue = xRWLock;
+    rt_err_t err;
+
+    configASSERT( ( pxQueue ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+    RT_ASSERT( pxQueue->ucQueueKind == queueKIND_RWLOCK );
+
+    err = prvRWLockTake( ( struct rt_rwlock * ) pxQueue->rt_ipc, xTicksToWait, xWrite );
+    if ( err == RT_EOK )
+    {
+        prvQueueRecordReceive( pxQueue, 1 );
+    }
+
+    return rt_err_to_freertos( err );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
+                                 void * const pvBuffer,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    Queue_t * const pxQueue = xQueue;
+    BaseType_t xPreviousYield;
+    rt_err_t err;
+
+    configASSERT( pxQueue );
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+    RT_ASSERT( !prvQueueIsMutex( pxQueue ) );
+
+    xPreviousYield = xPortIsrYieldBegin();
+    err = prvQueueReceive( pxQueue, pvBuffer, 0 );
+    vPortIsrYieldEnd( xPreviousYield, pxHigherPriorityTaskWoken );
+
+    return rt_err_to_freertos( err );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeek( QueueHandle_t xQueue,
+                       void * const pvBuffer,
+                       TickType_t xTicksToWait )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    /* Check the queue pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+
+    return rt_err_to_freertos( prvQueueOperations( pxQueue )->pxReceive( pxQueue->rt_ipc, pvBuffer, xTicksToWait, pdTRUE ) );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
+                              void * const pvBuffer )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+
+    return rt_err_to_freertos( prvQueueOperations( pxQueue )->pxReceive( pxQueue->rt_ipc, pvBuffer, 0, pdTRUE ) );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                                const void * pvItems,
+                                UBaseType_t uxItemCount,
+                                TickType_t xTicksToWait )
+{
+    Queue_t * const pxQueue = xQueue;
+    const QueueOperations_t * pxOperations;
+    UBaseType_t uxCount;
+    rt_bool_t xPosted = RT_TRUE;
+
+    configASSERT( pxQueue );
+    configASSERT( ( pvItems != NULL ) || ( uxItemCount == 0 ) );
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    if ( uxItemCount == 0 )
+    {
+        return 0;
+    }
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+    pxOperations = prvQueueOperations( pxQueue );
+    /* Semaphores and mutexes carry no items */
+    configASSERT( pxOperations->pxSendMultiple != NULL );
+    uxCount = prvQueueSendMultiple( pxQueue, pvItems, uxItemCount, xTicksToWait, &xPosted );
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        if ( xPosted == RT_TRUE )
+        {
+            UBaseType_t uxEvent;
+
+            for ( uxEvent = 0; uxEvent < uxCount; uxEvent++ )
+            {
+                prvNotifyQueueSetContainer( pxQueue );
+            }
+        }
+    #endif
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                       const void * pvItems,
+                                       UBaseType_t uxItemCount,
+                                       BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxCount;
+    BaseType_t xPreviousYield;
+
+    xPreviousYield = xPortIsrYieldBegin();
+    uxCount = xQueueSendMultiple( xQueue, pvItems, uxItemCount, 0 );
+    vPortIsrYieldEnd( xPreviousYield, pxHigherPriorityTaskWoken );
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                   void * pvBuffer,
+                                   UBaseType_t uxMaxItems,
+                                   TickType_t xTicksToWait )
+{
+    Queue_t * const pxQueue = xQueue;
+    const QueueOperations_t * pxOperations;
+
+    configASSERT( pxQueue );
+    configASSERT( ( pvBuffer != NULL ) || ( uxMaxItems == 0 ) );
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    if ( uxMaxItems == 0 )
+    {
+        return 0;
+    }
+    RT_ASSERT( pxQueue->rt_ipc != RT_NULL );
+    pxOperations = prvQueueOperations( pxQueue );
+    configASSERT( pxOperations->pxReceiveMultiple != NULL );
+
+    return prvQueueReceiveMultiple( pxQueue, pvBuffer, uxMaxItems, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                          void * pvBuffer,
+                                          UBaseType_t uxMaxItems,
+                                          BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxCount;
+    BaseType_t xPreviousYield;
+
+    xPreviousYield = xPortIsrYieldBegin();
+    uxCount = xQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, 0 );
+    vPortIsrYieldEnd( xPreviousYield, pxHigherPriorityTaskWoken );
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    rt_base_t level;
+
+    configASSERT( xQueue );
+    RT_ASSERT( xQueue->rt_ipc != RT_NULL );
+
+    level = rt_hw_interrupt_disable();
+    uxReturn = prvQueueOperations( xQueue )->pxMessagesWaiting( xQueue->rt_ipc );
+    rt_hw_interrupt_enable( level );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    rt_base_t level;
+
+    configASSERT( xQueue );
+    RT_ASSERT( xQueue->rt_ipc != RT_NULL );
+
+    level = rt_hw_interrupt_disable();
+    uxReturn = prvQueueOperations( xQueue )->pxSpacesAvailable( xQueue->rt_ipc );
+    #if ( configUSE_QUEUE_RING_BUFFER == 0 )
+        /* A held slot is on neither list of an rt_messagequeue, so its
+         * count of free slots includes it.  The ring engine excludes them. */
+        uxReturn -= xQueue->usSlotsHeld;
+    #endif
+    rt_hw_interrupt_enable( level );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    return uxQueueMessagesWaiting( xQueue );
+}
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+    struct rt_ipc_object *pipc;
+
+    configASSERT( pxQueue );
+
+    pipc = pxQueue->rt_ipc;
+    RT_ASSERT( pipc != RT_NULL );
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        {
+            vQueueUnregisterQueue( pxQueue );
+        }
+    #endif
+    #if ( configUSE_MUTEX_PROFILING == 1 )
+        if ( prvQueueIsMutex( pxQueue ) )
+        {
+            prvMutexProfileRemove( pxQueue );
+        }
+    #endif
+    prvQueueOperations( pxQueue )->pxDelete( pipc );
+    prvQueueFree( pxQueue );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
+{
+    BaseType_t xReturn;
+
+    configASSERT( xQueue );
+
+    if( uxQueueMessagesWaiting( xQueue ) == ( UBaseType_t ) 0 )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
+{
+    BaseType_t xReturn;
+
+    configASSERT( xQueue );
+
+    if ( uxQueueSpacesAvailable( xQueue ) == ( UBaseType_t ) 0 )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static MessageQueue_t * prvGetMessageQueue( QueueHandle_t xQueue )
+{
+    struct rt_ipc_object *pipc;
+
+    configASSERT( xQueue );
+
+    pipc = xQueue->rt_ipc;
+    RT_ASSERT( pipc != RT_NULL );
+    /* Only message queues have slots to hand out. */
+    RT_ASSERT( xQueue->ucQueueKind == queueKIND_MESSAGE_QUEUE );
+
+    return ( MessageQueue_t * ) pipc;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueAcquireSendSlot( QueueHandle_t xQueue,
+                                  void ** ppvSlot,
+                                  TickType_t xTicksToWait )
+{
+    MessageQueue_t * mq = prvGetMessageQueue( xQueue );
+    void * pvMessage;
+    rt_base_t level;
+
+    configASSERT( ppvSlot );
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    level = rt_hw_interrupt_disable();
+    while ( ( pvMessage = prvMqAllocSlot( mq ) ) == RT_NULL )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
+        {
+            rt_hw_interrupt_enable( level );
+            return errQUEUE_FULL;
+        }
+        if ( prvQueueWait( &( mq->suspend_sender_thread ), &xTicksToWait, level ) != RT_EOK )
+        {
+            return errQUEUE_FULL;
         }
-
-        return ( QueueHandle_t ) pxNewQueue;
+        level = rt_hw_interrupt_disable();
     }
+    xQueue->usSlotsHeld++;
+    rt_hw_interrupt_enable( level );
 
-#endif /* configSUPPORT_STATIC_ALLOCATION */
+    *ppvSlot = pvMessage;
+
+    return pdPASS;
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+BaseType_t xQueueAcquireSendSlotFromISR( QueueHandle_t xQueue,
+                                         void ** ppvSlot )
+{
+    MessageQueue_t * mq = prvGetMessageQueue( xQueue );
+    void * pvMessage;
+    rt_base_t level;
 
-    QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType )
+    configASSERT( ppvSlot );
+
+    level = rt_hw_interrupt_disable();
+    pvMessage = prvMqAllocSlot( mq );
+    if ( pvMessage != RT_NULL )
     {
-        QueueHandle_t xNewQueue;
-        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+        xQueue->usSlotsHeld++;
+    }
+    rt_hw_interrupt_enable( level );
 
-        xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, ucQueueType );
-        return xNewQueue;
+    if ( pvMessage == RT_NULL )
+    {
+        return errQUEUE_FULL;
     }
+    *ppvSlot = pvMessage;
 
-#endif /* configUSE_MUTEXES */
+    return pdPASS;
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+BaseType_t xQueueCommitSend( QueueHandle_t xQueue,
+                             void * pvSlot )
+{
+    MessageQueue_t * mq = prvGetMessageQueue( xQueue );
+    rt_thread_t thread;
+    rt_base_t level;
 
-    QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
-                                           StaticQueue_t * pxStaticQueue )
-    {
-        QueueHandle_t xNewQueue;
-        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+    configASSERT( pvSlot );
 
-        xNewQueue = xQueueGenericCreateStatic( uxMutexLength, uxMutexSize, NULL, pxStaticQueue, ucQueueType );
+    level = rt_hw_interrupt_disable();
+    configASSERT( xQueue->usSlotsHeld > 0 );
+    xQueue->usSlotsHeld--;
+    prvMqPostSlot( mq, pvSlot );
+    thread = prvQueueWakeOne( &( mq->parent.suspend_thread ) );
+    rt_hw_interrupt_enable( level );
 
-        return xNewQueue;
+    if ( thread != RT_NULL )
+    {
+        prvQueueSchedule();
     }
+    prvQueueRecordSend( ( Queue_t * ) xQueue, 1 );
+    #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            prvNotifyQueueSetContainer( ( Queue_t * ) xQueue );
+        }
+    #endif
 
-#endif /* configUSE_MUTEXES */
+    return pdPASS;
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+BaseType_t xQueueCommitSendFromISR( QueueHandle_t xQueue,
+                                    void * pvSlot,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xPreviousYield;
 
-    TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
-    {
-        TaskHandle_t pxReturn;
-        struct rt_ipc_object *pipc;
-        rt_uint8_t type;
-        rt_base_t level;
+    xPreviousYield = xPortIsrYieldBegin();
+    xQueueCommitSend( xQueue, pvSlot );
+    vPortIsrYieldEnd( xPreviousYield, pxHigherPriorityTaskWoken );
 
-        configASSERT( xSemaphore );
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
 
-        pipc = xSemaphore->rt_ipc;
-        RT_ASSERT( pipc != RT_NULL );
-        type = rt_object_get_type( &pipc->parent );
+BaseType_t xQueueAcquireReceiveSlot( QueueHandle_t xQueue,
+                                     void ** ppvSlot,
+                                     TickType_t xTicksToWait )
+{
+    MessageQueue_t * mq = prvGetMessageQueue( xQueue );
+    void * pvMessage;
+    rt_base_t level;
 
-        if ( type == RT_Object_Class_Mutex )
+    configASSERT( ppvSlot );
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    level = rt_hw_interrupt_disable();
+    while ( ( pvMessage = prvMqTakeSlot( mq ) ) == RT_NULL )
+    {
+        if ( xTicksToWait == ( TickType_t ) 0 )
         {
-            level = rt_hw_interrupt_disable();
-            pxReturn = ( TaskHandle_t ) ( ( rt_mutex_t ) pipc )->owner;
             rt_hw_interrupt_enable( level );
+            return errQUEUE_EMPTY;
         }
-        else
+        if ( prvQueueWait( &( mq->parent.suspend_thread ), &xTicksToWait, level ) != RT_EOK )
         {
-            pxReturn = NULL;
+            return errQUEUE_EMPTY;
         }
-
-        return pxReturn;
+        level = rt_hw_interrupt_disable();
     }
+    xQueue->usSlotsHeld++;
+    rt_hw_interrupt_enable( level );
 
-#endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+    *ppvSlot = pvMessage;
+
+    return pdPASS;
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+BaseType_t xQueueAcquireReceiveSlotFromISR( QueueHandle_t xQueue,
+                                            void ** ppvSlot )
+{
+    MessageQueue_t * mq = prvGetMessageQueue( xQueue );
+    void * pvMessage;
+    rt_base_t level;
 
-    TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore )
+    configASSERT( ppvSlot );
+
+    level = rt_hw_interrupt_disable();
+    pvMessage = prvMqTakeSlot( mq );
+    if ( pvMessage != RT_NULL )
     {
-        return xQueueGetMutexHolder( xSemaphore );
+        xQueue->usSlotsHeld++;
     }
+    rt_hw_interrupt_enable( level );
 
-#endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+    if ( pvMessage == RT_NULL )
+    {
+        return errQUEUE_EMPTY;
+    }
+    *ppvSlot = pvMessage;
+
+    return pdPASS;
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+BaseType_t xQueueReleaseReceiveSlot( QueueHandle_t xQueue,
+                                     void * pvSlot )
+{
+    MessageQueue_t * mq = prvGetMessageQueue( xQueue );
+    rt_thread_t thread;
+    rt_base_t level;
 
-    BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
+    configASSERT( pvSlot );
+
+    level = rt_hw_interrupt_disable();
+    configASSERT( xQueue->usSlotsHeld > 0 );
+    xQueue->usSlotsHeld--;
+    prvMqFreeSlot( mq, pvSlot );
+    thread = prvQueueWakeOne( &( mq->suspend_sender_thread ) );
+    rt_hw_interrupt_enable( level );
+
+    if ( thread != RT_NULL )
     {
-        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
-        configASSERT( pxMutex );
-        return xQueueGenericSend( pxMutex, NULL, queueMUTEX_GIVE_BLOCK_TIME, queueSEND_TO_BACK );
+        prvQueueSchedule();
     }
+    prvQueueRecordReceive( ( Queue_t * ) xQueue, 1 );
 
-#endif /* configUSE_RECURSIVE_MUTEXES */
+    return pdPASS;
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_RECURSIVE_MUTEXES == 1 )
+BaseType_t xQueueReleaseReceiveSlotFromISR( QueueHandle_t xQueue,
+                                            void * pvSlot,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xPreviousYield;
 
-    BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex,
-                                         TickType_t xTicksToWait )
-    {
-        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
-        configASSERT( pxMutex );
-        return xQueueSemaphoreTake( pxMutex, xTicksToWait );
-    }
+    xPreviousYield = xPortIsrYieldBegin();
+    xQueueReleaseReceiveSlot( xQueue, pvSlot );
+    vPortIsrYieldEnd( xPreviousYield, pxHigherPriorityTaskWoken );
 
-#endif /* configUSE_RECURSIVE_MUTEXES */
+    return pdPASS;
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
 
-    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
-                                                       const UBaseType_t uxInitialCount,
-                                                       StaticQueue_t * pxStaticQueue )
+    void vQueueAddToRegistry( QueueHandle_t xQueue,
+                              const char * pcQueueName )
     {
-        QueueHandle_t xHandle = NULL;
+        UBaseType_t ux;
+        QueueRegistryItem_t * pxEntryToWrite = NULL;
+        rt_base_t level;
 
-        if( ( uxMaxCount != 0 ) &&
-            ( uxInitialCount <= uxMaxCount ) )
-        {
-            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+        configASSERT( xQueue );
 
-            if( xHandle != NULL )
+        level = rt_hw_interrupt_disable();
+        if ( pcQueueName != NULL )
+        {
+            /* See if there is an empty space in the registry.  A NULL name denotes
+             * a free slot. */
+            for ( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
             {
-                ( ( rt_sem_t ) ( ( Queue_t * ) xHandle )->rt_ipc )->value = uxInitialCount;
+                /* Replace an existing entry if the queue is already in the registry. */
+                if ( xQueue == xQueueRegistry[ ux ].xHandle )
+                {
+                    pxEntryToWrite = &( xQueueRegistry[ ux ] );
+                    break;
+                }
+                /* Otherwise, store in the next empty location */
+                else if ( ( pxEntryToWrite == NULL ) && ( xQueueRegistry[ ux ].pcQueueName == NULL ) )
+                {
+                    pxEntryToWrite = &( xQueueRegistry[ ux ] );
+                }
             }
         }
-        else
+
+        if ( pxEntryToWrite != NULL )
         {
-            configASSERT( xHandle );
+        #if ( configUSE_NAME_INDEX == 1 )
+            if ( pxEntryToWrite->xHandle == xQueue )
+            {
+                vTaskNameIndexRemove( pxEntryToWrite->pcQueueName, xQueue, taskNAME_INDEX_QUEUE );
+            }
+            vTaskNameIndexInsert( pcQueueName, xQueue, taskNAME_INDEX_QUEUE );
+        #endif
+            /* Store the information on this queue. */
+            pxEntryToWrite->pcQueueName = pcQueueName;
+            pxEntryToWrite->xHandle = xQueue;
         }
-
-        return xHandle;
+        rt_hw_interrupt_enable( level );
     }
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+#endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
 
-    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
-                                                 const UBaseType_t uxInitialCount )
+    const char * pcQueueGetName( QueueHandle_t xQueue )
     {
-        QueueHandle_t xHandle = NULL;
+        UBaseType_t ux;
+        const char * pcReturn = NULL;
+        rt_base_t level;
 
-        if( ( uxMaxCount != 0 ) &&
-            ( uxInitialCount <= uxMaxCount ) )
-        {
-            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+        configASSERT( xQueue );
 
-            if( xHandle != NULL )
+        level = rt_hw_interrupt_disable();
+        for ( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        {
+            if ( xQueueRegistry[ ux ].xHandle == xQueue )
             {
-                ( ( rt_sem_t ) ( ( Queue_t * ) xHandle )->rt_ipc )->value = uxInitialCount;
+                pcReturn = xQueueRegistry[ ux ].pcQueueName;
+                break;
             }
         }
-        else
-        {
-            configASSERT( xHandle );
-        }
+        rt_hw_interrupt_enable( level );
 
-        return xHandle;
+        return pcReturn;
     }
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+#endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
-                              const void * const pvItemToQueue,
-                              TickType_t xTicksToWait,
-                              const BaseType_t xCopyPosition )
-{
-    Queue_t * const pxQueue = xQueue;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
-    rt_base_t level;
-    rt_err_t err = -RT_ERROR;
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
 
-    configASSERT( pxQueue );
-    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+    QueueHandle_t xQueueGetHandle( const char * pcQueueName )
+    {
+        UBaseType_t ux;
+        QueueHandle_t xReturn = NULL;
+        rt_base_t level;
+    #if ( configUSE_NAME_INDEX == 1 )
+        void * pvHandle;
+    #endif
+
+        configASSERT( pcQueueName );
+
+    #if ( configUSE_NAME_INDEX == 1 )
+        if ( xTaskNameIndexFind( pcQueueName, taskNAME_INDEX_QUEUE, &pvHandle ) != pdFALSE )
         {
-            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            return ( QueueHandle_t ) pvHandle;
         }
-    #endif
+    #endif /* configUSE_NAME_INDEX */
 
-    pipc = pxQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
-    if ( type == RT_Object_Class_Mutex )
-    {
-        err = rt_mutex_release( ( rt_mutex_t ) pipc );
-    }
-    else if ( type == RT_Object_Class_Semaphore )
-    {
         level = rt_hw_interrupt_disable();
-        if ( ( ( rt_sem_t ) pipc )->value < ( ( struct rt_semaphore_wrapper * ) pipc )->max_value )
+        for ( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
         {
-            err = rt_sem_release( ( rt_sem_t ) pipc );
+            if ( ( xQueueRegistry[ ux ].pcQueueName != NULL ) && ( rt_strcmp( xQueueRegistry[ ux ].pcQueueName, pcQueueName ) == 0 ) )
+            {
+                xReturn = xQueueRegistry[ ux ].xHandle;
+                break;
+            }
         }
         rt_hw_interrupt_enable( level );
+
+        return xReturn;
     }
-    else if ( type == RT_Object_Class_MessageQueue )
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+    void vQueueUnregisterQueue( QueueHandle_t xQueue )
     {
-        if ( xCopyPosition == queueSEND_TO_BACK )
-        {
-            err = rt_mq_send_wait( ( rt_mq_t ) pipc, pvItemToQueue, ( ( rt_mq_t ) pipc )->msg_size, ( rt_int32_t ) xTicksToWait );
-        }
-        else if ( xCopyPosition == queueSEND_TO_FRONT )
+        UBaseType_t ux;
+        rt_base_t level;
+
+        configASSERT( xQueue );
+
+        level = rt_hw_interrupt_disable();
+        /* See if the handle of the queue being unregistered in actually in the
+         * registry. */
+        for ( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
         {
-            // TODO: need to implement the timeout for LIFO
-            err = rt_mq_urgent( ( rt_mq_t ) pipc, pvItemToQueue, ( ( rt_mq_t ) pipc )->msg_size );
+            if ( xQueueRegistry[ ux ].xHandle == xQueue )
+            {
+            #if ( configUSE_NAME_INDEX == 1 )
+                vTaskNameIndexRemove( xQueueRegistry[ ux ].pcQueueName, xQueue, taskNAME_INDEX_QUEUE );
+            #endif
+
+                /* Set the name to NULL to show that this slot if free again. */
+                xQueueRegistry[ ux ].pcQueueName = NULL;
+
+                /* Set the handle to NULL to ensure the same queue handle cannot
+                 * appear in the registry twice if it is added, removed, then
+                 * added again. */
+                xQueueRegistry[ ux ].xHandle = ( QueueHandle_t ) 0;
+                break;
+            }
         }
+        rt_hw_interrupt_enable( level );
     }
 
-    return rt_err_to_freertos( err );
-}
+#endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
-                                     const void * const pvItemToQueue,
-                                     BaseType_t * const pxHigherPriorityTaskWoken,
-                                     const BaseType_t xCopyPosition )
-{
-    Queue_t * const pxQueue = xQueue;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
-    rt_err_t err = -RT_ERROR;
+#if ( configUSE_QUEUE_STATISTICS == 1 )
 
-    configASSERT( pxQueue );
+    void vQueueGetStatistics( QueueHandle_t xQueue,
+                              QueueStatistics_t * pxStatistics )
+    {
+        Queue_t * const pxQueue = xQueue;
+        rt_base_t level;
 
-    pipc = pxQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
-    if ( type == RT_Object_Class_MessageQueue )
+        configASSERT( pxQueue );
+        configASSERT( pxStatistics );
+
+        level = rt_hw_interrupt_disable();
+        *pxStatistics = pxQueue->xStatistics;
+        rt_hw_interrupt_enable( level );
+    }
+
+#endif /* configUSE_QUEUE_STATISTICS */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATISTICS == 1 ) && defined( RT_USING_FINSH )
+
+/*
+ * List the counters of every registered queue, the ones that blocked most
+ * often first, then the ones that spent the longest blocked.
+ */
+    static int queue_stats( void )
     {
-        if ( xCopyPosition == queueSEND_TO_BACK )
+        /* Static to keep the shell stack small; the shell runs one command at a time */
+        static struct
+        {
+            const char * pcQueueName;
+            QueueStatistics_t xStatistics;
+        } xEntries[ configQUEUE_REGISTRY_SIZE ], xEntry;
+        UBaseType_t uxCount = 0;
+        UBaseType_t ux;
+        UBaseType_t uxSlot;
+        rt_base_t level;
+
+        /* Copy under the lock, vQueueDelete() unregisters before freeing */
+        level = rt_hw_interrupt_disable();
+        for ( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
         {
-            err = rt_mq_send( ( rt_mq_t ) pipc, pvItemToQueue, ( ( rt_mq_t ) pipc )->msg_size);
+            if ( xQueueRegistry[ ux ].pcQueueName != NULL )
+            {
+                xEntries[ uxCount ].pcQueueName = xQueueRegistry[ ux ].pcQueueName;
+                xEntries[ uxCount ].xStatistics = ( ( Queue_t * ) xQueueRegistry[ ux ].xHandle )->xStatistics;
+                uxCount++;
+            }
         }
-        else if ( xCopyPosition == queueSEND_TO_FRONT )
+        rt_hw_interrupt_enable( level );
+
+        /* Insertion sort, the registry is small */
+        #define prvContention( x )    ( ( x ).xStatistics.ulSendsBlocked + ( x ).xStatistics.ulReceivesBlocked )
+        for ( ux = 1; ux < uxCount; ux++ )
         {
-            err = rt_mq_urgent( ( rt_mq_t ) pipc, pvItemToQueue, ( ( rt_mq_t ) pipc )->msg_size );
+            xEntry = xEntries[ ux ];
+            for ( uxSlot = ux; uxSlot > 0; uxSlot-- )
+            {
+                if ( ( prvContention( xEntries[ uxSlot - 1 ] ) > prvContention( xEntry ) ) ||
+                     ( ( prvContention( xEntries[ uxSlot - 1 ] ) == prvContention( xEntry ) ) &&
+                       ( xEntries[ uxSlot - 1 ].xStatistics.xBlockedTicks >= xEntry.xStatistics.xBlockedTicks ) ) )
+                {
+                    break;
+                }
+                xEntries[ uxSlot ] = xEntries[ uxSlot - 1 ];
+            }
+            xEntries[ uxSlot ] = xEntry;
         }
-    }
+        #undef prvContention
 
-    return rt_err_to_freertos( err );
-}
-/*-----------------------------------------------------------*/
+        rt_kprintf( "queue            sends      receives   send blk   recv blk   blk ticks  peak\n" );
+        rt_kprintf( "---------------- ---------- ---------- ---------- ---------- ---------- ------\n" );
+        for ( ux = 0; ux < uxCount; ux++ )
+        {
+            rt_kprintf( "%-16.16s %-10u %-10u %-10u %-10u %-10u %u\n",
+                        xEntries[ ux ].pcQueueName,
+                        xEntries[ ux ].xStatistics.ulSends,
+                        xEntries[ ux ].xStatistics.ulReceives,
+                        xEntries[ ux ].xStatistics.ulSendsBlocked,
+                        xEntries[ ux ].xStatistics.ulReceivesBlocked,
+                        ( uint32_t ) xEntries[ ux ].xStatistics.xBlockedTicks,
+                        ( uint32_t ) xEntries[ ux ].xStatistics.uxPeakMessages );
+        }
 
-BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
-                              BaseType_t * const pxHigherPriorityTaskWoken )
-{
-    Queue_t * const pxQueue = xQueue;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
-    rt_base_t level;
-    rt_err_t err = -RT_ERROR;
+        return 0;
+    }
+    MSH_CMD_EXPORT( queue_stats, list registered FreeRTOS queues by contention );
 
-    configASSERT( pxQueue );
+#endif /* if ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATISTICS == 1 ) && defined( RT_USING_FINSH ) */
+/*-----------------------------------------------------------*/
 
-    pipc = pxQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
-    RT_ASSERT( type != RT_Object_Class_Mutex );
-    if ( type == RT_Object_Class_Semaphore )
+#if ( configUSE_QUEUE_WATERMARKS == 1 )
+
+    BaseType_t xQueueSetWatermarks( QueueHandle_t xQueue,
+                                    UBaseType_t uxHighMark,
+                                    UBaseType_t uxLowMark,
+                                    QueueWatermarkCallback_t pxCallback,
+                                    void * pvContext )
     {
-        level = rt_hw_interrupt_disable();
-        if ( ( ( rt_sem_t ) pipc )->value < ( ( struct rt_semaphore_wrapper * ) pipc )->max_value )
+        Queue_t * const pxQueue = xQueue;
+        rt_base_t level;
+
+        configASSERT( pxQueue );
+        /* Items reach subscribers without a send to their handle, and a mutex
+         * or a reader-writer lock holds no items. */
+        configASSERT( !prvQueueIsMutex( pxQueue ) &&
+                      ( pxQueue->ucQueueKind != queueKIND_RWLOCK ) &&
+                      ( pxQueue->ucQueueKind != queueKIND_BROADCAST ) &&
+                      ( pxQueue->ucQueueKind != queueKIND_SUBSCRIBER ) );
+
+        if ( ( pxCallback != NULL ) && ( uxHighMark <= uxLowMark ) )
         {
-            err = rt_sem_release( ( rt_sem_t ) pipc );
+            return pdFAIL;
         }
+        level = rt_hw_interrupt_disable();
+        pxQueue->xWatermarks.pxCallback = pxCallback;
+        pxQueue->xWatermarks.pvContext = pvContext;
+        pxQueue->xWatermarks.uxHighMark = uxHighMark;
+        pxQueue->xWatermarks.uxLowMark = uxLowMark;
+        pxQueue->xWatermarks.xAboveHighMark = pdFALSE;
         rt_hw_interrupt_enable( level );
-    }
-    if ( pxHigherPriorityTaskWoken != NULL )
-    {
-        *pxHigherPriorityTaskWoken = pdFALSE;
-    }
 
-    return rt_err_to_freertos( err );
-}
-/*-----------------------------------------------------------*/
+        /* Report a queue that is already past the high mark */
+        prvQueueCheckWatermarks( pxQueue );
 
-BaseType_t xQueueReceive( QueueHandle_t xQueue,
-                          void * const pvBuffer,
-                          TickType_t xTicksToWait )
-{
-    Queue_t * const pxQueue = xQueue;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
-    rt_err_t err = -RT_ERROR;
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
 
-    /* Check the queue pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        static void prvQueueWatermarkNotify( QueueHandle_t xQueue,
+                                             BaseType_t xAboveHighMark,
+                                             void * pvContext )
         {
-            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            ( void ) xQueue;
+            ( void ) xTaskNotify( ( TaskHandle_t ) pvContext,
+                                  ( xAboveHighMark != pdFALSE ) ? queueWATERMARK_HIGH_BIT : queueWATERMARK_LOW_BIT,
+                                  eSetBits );
         }
-    #endif
 
-    pipc = pxQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
-    if ( type == RT_Object_Class_MessageQueue )
-    {
-        err = ( rt_err_t ) rt_mq_recv( ( rt_mq_t ) pipc, pvBuffer, ( ( rt_mq_t ) pipc )->msg_size, ( rt_int32_t ) xTicksToWait );
-#if RT_VER_NUM >= 0x50001
-        if (( rt_ssize_t ) err >= 0)
+        BaseType_t xQueueSetWatermarkNotify( QueueHandle_t xQueue,
+                                             UBaseType_t uxHighMark,
+                                             UBaseType_t uxLowMark,
+                                             TaskHandle_t xTaskToNotify )
         {
-            err = RT_EOK;
+            configASSERT( xTaskToNotify );
+
+            return xQueueSetWatermarks( xQueue, uxHighMark, uxLowMark, prvQueueWatermarkNotify, xTaskToNotify );
         }
-#endif
-    }
 
-    return rt_err_to_freertos( err );
-}
+    #endif /* configUSE_TASK_NOTIFICATIONS */
+
+#endif /* configUSE_QUEUE_WATERMARKS */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
-                                TickType_t xTicksToWait )
-{
-    Queue_t * const pxQueue = xQueue;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
-    rt_err_t err = -RT_ERROR;
+#if ( configUSE_MUTEX_PROFILING == 1 )
 
-    /* Check the queue pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+    void vQueueGetMutexProfile( QueueHandle_t xMutex,
+                                MutexProfile_t * pxProfile )
+    {
+        Queue_t * const pxQueue = xMutex;
+        rt_base_t level;
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
-        {
-            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-        }
-    #endif
+        configASSERT( pxQueue );
+        configASSERT( pxProfile );
+        configASSERT( prvQueueIsMutex( pxQueue ) );
 
-    pipc = pxQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
-    if ( type == RT_Object_Class_Mutex )
-    {
-        err = rt_mutex_take( ( rt_mutex_t ) pipc, ( rt_int32_t ) xTicksToWait );
+        level = rt_hw_interrupt_disable();
+        *pxProfile = prvMutexProfileOf( pxQueue )->xMutexProfile;
+        rt_hw_interrupt_enable( level );
     }
-    else if ( type == RT_Object_Class_Semaphore )
+/*-----------------------------------------------------------*/
+
+    void vQueueResetMutexProfile( QueueHandle_t xMutex )
     {
-        err = rt_sem_take( ( rt_sem_t ) pipc, ( rt_int32_t ) xTicksToWait );
-    }
+        Queue_t * const pxQueue = xMutex;
+        rt_base_t level;
 
-    return rt_err_to_freertos( err );
-}
+        configASSERT( pxQueue );
+        configASSERT( prvQueueIsMutex( pxQueue ) );
+
+        /* The hold start is kept, a mutex held now is timed from its take */
+        level = rt_hw_interrupt_disable();
+        rt_memset( &( prvMutexProfileOf( pxQueue )->xMutexProfile ), 0, sizeof( MutexProfile_t ) );
+        rt_hw_interrupt_enable( level );
+    }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
-                                 void * const pvBuffer,
-                                 BaseType_t * const pxHigherPriorityTaskWoken )
-{
-    Queue_t * const pxQueue = xQueue;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
-    rt_err_t err = -RT_ERROR;
+    #if defined( RT_USING_FINSH )
 
-    configASSERT( pxQueue );
+        #define mutexPROFILE_SHOWN    16
 
-    pipc = pxQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
-    RT_ASSERT( type != RT_Object_Class_Mutex );
-    if ( type == RT_Object_Class_Semaphore )
-    {
-        err = rt_sem_take( ( rt_sem_t ) pipc, RT_WAITING_NO );
-    }
-    else if ( type == RT_Object_Class_MessageQueue )
-    {
-        err = ( rt_err_t ) rt_mq_recv( ( rt_mq_t ) pipc, pvBuffer, ( ( rt_mq_t ) pipc )->msg_size, RT_WAITING_NO );
-#if RT_VER_NUM >= 0x50001
-        if (( rt_ssize_t ) err >= 0)
+/*
+ * List the mutexes that were waited for longest, up to mutexPROFILE_SHOWN of
+ * them.  Given a mutex name, print its wait and hold histograms instead.
+ */
+        static int mutex_stats( int argc,
+                                char ** argv )
         {
-            err = RT_EOK;
-        }
-#endif
-    }
-    if ( pxHigherPriorityTaskWoken != NULL )
-    {
-        *pxHigherPriorityTaskWoken = pdFALSE;
-    }
-
-    return rt_err_to_freertos( err );
-}
-/*-----------------------------------------------------------*/
+            /* Static to keep the shell stack small; the shell runs one command at a time */
+            static struct
+            {
+                const char * pcName;
+                char cObjectName[ RT_NAME_MAX ];
+                MutexProfile_t xProfile;
+            } xEntries[ mutexPROFILE_SHOWN ];
+            Queue_t * pxTop[ mutexPROFILE_SHOWN ];
+            Queue_t * pxQueue;
+            UBaseType_t uxCount = 0;
+            UBaseType_t uxTotal = 0;
+            UBaseType_t ux;
+            UBaseType_t uxSlot;
+            char cLabel[ 24 ];
+            rt_base_t level;
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn = 0;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
-    rt_base_t level;
+            #define prvTotalWait( pxQueue )    ( prvMutexProfileOf( pxQueue )->xMutexProfile.ullTotalWait )
 
-    configASSERT( xQueue );
+            /* Rank and copy under the lock, vQueueDelete() unlinks before freeing */
+            level = rt_hw_interrupt_disable();
+            for ( pxQueue = pxProfiledMutexes; pxQueue != NULL; pxQueue = prvMutexProfileOf( pxQueue )->pxNextProfiledMutex )
+            {
+                uxTotal++;
+                if ( argc > 1 )
+                {
+                    if ( rt_strncmp( ( ( struct rt_object * ) pxQueue->rt_ipc )->name, argv[ 1 ], RT_NAME_MAX ) != 0 )
+                    {
+                    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                        if ( ( pcQueueGetName( pxQueue ) == NULL ) || ( rt_strcmp( pcQueueGetName( pxQueue ), argv[ 1 ] ) != 0 ) )
+                    #endif
+                        {
+                            continue;
+                        }
+                    }
+                    pxTop[ 0 ] = pxQueue;
+                    uxCount = 1;
+                    break;
+                }
 
-    pipc = xQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
+                /* Insertion into the longest waits seen so far */
+                for ( uxSlot = uxCount; uxSlot > 0; uxSlot-- )
+                {
+                    if ( prvTotalWait( pxTop[ uxSlot - 1 ] ) >= prvTotalWait( pxQueue ) )
+                    {
+                        break;
+                    }
+                    if ( uxSlot < mutexPROFILE_SHOWN )
+                    {
+                        pxTop[ uxSlot ] = pxTop[ uxSlot - 1 ];
+                    }
+                }
+                if ( uxSlot < mutexPROFILE_SHOWN )
+                {
+                    pxTop[ uxSlot ] = pxQueue;
+                    if ( uxCount < mutexPROFILE_SHOWN )
+                    {
+                        uxCount++;
+                    }
+                }
+            }
+            for ( ux = 0; ux < uxCount; ux++ )
+            {
+                xEntries[ ux ].pcName = NULL;
+            #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                xEntries[ ux ].pcName = pcQueueGetName( pxTop[ ux ] );
+            #endif
+                rt_strncpy( xEntries[ ux ].cObjectName, ( ( struct rt_object * ) pxTop[ ux ]->rt_ipc )->name, RT_NAME_MAX - 1 );
+                xEntries[ ux ].cObjectName[ RT_NAME_MAX - 1 ] = '\0';
+                xEntries[ ux ].xProfile = prvMutexProfileOf( pxTop[ ux ] )->xMutexProfile;
+            }
+            rt_hw_interrupt_enable( level );
 
-    level = rt_hw_interrupt_disable();
+            #undef prvTotalWait
 
-    if ( type == RT_Object_Class_Mutex )
-    {
-        if ( ( ( rt_mutex_t ) pipc )->owner == RT_NULL )
-        {
-            uxReturn = 1;
-        }
-        else
-        {
-            uxReturn = 0;
-        }
-    }
-    else if ( type == RT_Object_Class_Semaphore )
-    {
-        uxReturn = ( ( rt_sem_t ) pipc )->value;
-    }
-    else if ( type == RT_Object_Class_MessageQueue )
-    {
-        uxReturn = ( ( rt_mq_t ) pipc )->entry;
-    }
+            if ( argc > 1 )
+            {
+                if ( uxCount == 0 )
+                {
+                    rt_kprintf( "no profiled mutex named %s\n", argv[ 1 ] );
+                    return -1;
+                }
+                rt_kprintf( "time             waits      holds\n" );
+                rt_kprintf( "---------------- ---------- ----------\n" );
+                for ( ux = 0; ux < ( UBaseType_t ) configMUTEX_PROFILING_BUCKETS; ux++ )
+                {
+                    if ( ux == ( UBaseType_t ) ( configMUTEX_PROFILING_BUCKETS - 1 ) )
+                    {
+                        rt_snprintf( cLabel, sizeof( cLabel ), "%u+", ( ux == 0 ) ? 0U : ( 1U << ( ux - 1 ) ) );
+                    }
+                    else if ( ux <= 1 )
+                    {
+                        rt_snprintf( cLabel, sizeof( cLabel ), "%u", ( unsigned int ) ux );
+                    }
+                    else
+                    {
+                        rt_snprintf( cLabel, sizeof( cLabel ), "%u-%u", 1U << ( ux - 1 ), ( 1U << ux ) - 1U );
+                    }
+                    rt_kprintf( "%-16s %-10u %u\n", cLabel,
+                                xEntries[ 0 ].xProfile.ulWaitHistogram[ ux ],
+                                xEntries[ 0 ].xProfile.ulHoldHistogram[ ux ] );
+                }
 
-    rt_hw_interrupt_enable( level );
+                return 0;
+            }
 
-    return uxReturn;
-}
-/*-----------------------------------------------------------*/
+            rt_kprintf( "mutex            takes      contended  timeouts   avg wait   max wait   max hold   holder\n" );
+            rt_kprintf( "---------------- ---------- ---------- ---------- ---------- ---------- ---------- ----------------\n" );
+            for ( ux = 0; ux < uxCount; ux++ )
+            {
+                rt_kprintf( "%-16.16s %-10u %-10u %-10u %-10u %-10u %-10u %s\n",
+                            ( xEntries[ ux ].pcName != NULL ) ? xEntries[ ux ].pcName : xEntries[ ux ].cObjectName,
+                            xEntries[ ux ].xProfile.ulAcquisitions,
+                            xEntries[ ux ].xProfile.ulContended,
+                            xEntries[ ux ].xProfile.ulTimeouts,
+                            ( xEntries[ ux ].xProfile.ulContended != 0 ) ?
+                            ( uint32_t ) ( xEntries[ ux ].xProfile.ullTotalWait / xEntries[ ux ].xProfile.ulContended ) : 0U,
+                            xEntries[ ux ].xProfile.ulMaxWait,
+                            xEntries[ ux ].xProfile.ulMaxHold,
+                            xEntries[ ux ].xProfile.pcMaxHoldTaskName );
+            }
+            if ( uxTotal > uxCount )
+            {
+                rt_kprintf( "%u more not shown\n", ( unsigned int ) ( uxTotal - uxCount ) );
+            }
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn = 0;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
-    rt_base_t level;
+            return 0;
+        }
+        MSH_CMD_EXPORT( mutex_stats, list FreeRTOS mutexes by wait time or show the histograms of one );
 
-    configASSERT( xQueue );
+    #endif /* RT_USING_FINSH */
 
-    pipc = xQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
+#endif /* configUSE_MUTEX_PROFILING */
+/*-----------------------------------------------------------*/
 
-    level = rt_hw_interrupt_disable();
+#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    if ( type == RT_Object_Class_Mutex )
+    QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength )
     {
-        if ( ( ( rt_mutex_t ) pipc )->owner == RT_NULL )
-        {
-            uxReturn = 0;
-        }
-        else
-        {
-            uxReturn = 1;
-        }
-    }
-    else if ( type == RT_Object_Class_Semaphore )
-    {
-        uxReturn = ( ( struct rt_semaphore_wrapper * ) pipc )->max_value - ( ( rt_sem_t ) pipc )->value;
-    }
-    else if ( type == RT_Object_Class_MessageQueue )
-    {
-        uxReturn = ( ( rt_mq_t ) pipc )->max_msgs - ( ( rt_mq_t ) pipc )->entry;
+        return xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
     }
 
-    rt_hw_interrupt_enable( level );
-
-    return uxReturn;
-}
+#endif /* ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    return uxQueueMessagesWaiting( xQueue );
-}
-/*-----------------------------------------------------------*/
+#if ( configUSE_QUEUE_SETS == 1 )
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
-    struct rt_ipc_object *pipc;
-    rt_uint8_t type;
+    BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                               QueueSetHandle_t xQueueSet )
+    {
+        Queue_t * const pxQueue = xQueueOrSemaphore;
+        BaseType_t xReturn;
+        rt_base_t level;
 
-    configASSERT( pxQueue );
+        configASSERT( pxQueue );
+        configASSERT( xQueueSet );
+        configASSERT( xQueueOrSemaphore != xQueueSet );
+        /* Items reach subscribers without a send to their handle, and
+         * readers take a reader-writer lock without a receive. */
+        configASSERT( ( pxQueue->ucQueueKind != queueKIND_BROADCAST ) && ( pxQueue->ucQueueKind != queueKIND_SUBSCRIBER ) &&
+                      ( pxQueue->ucQueueKind != queueKIND_RWLOCK ) );
 
-    pipc = pxQueue->rt_ipc;
-    RT_ASSERT( pipc != RT_NULL );
-    type = rt_object_get_type( &pipc->parent );
-#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    if ( rt_object_is_systemobject( ( rt_object_t ) pipc ) )
-#endif
-    {
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-        if ( type == RT_Object_Class_Mutex )
+        level = rt_hw_interrupt_disable();
+        if ( pxQueue->pxQueueSetContainer != NULL )
         {
-            rt_mutex_detach( ( rt_mutex_t ) pipc );
+            /* Cannot add a queue/semaphore to more than one queue set. */
+            xReturn = pdFAIL;
         }
-        else if ( type == RT_Object_Class_Semaphore )
+        else if ( uxQueueMessagesWaiting( xQueueOrSemaphore ) != ( UBaseType_t ) 0 )
         {
-            rt_sem_detach( ( rt_sem_t ) pipc );
+            /* Cannot add a queue/semaphore to a queue set if there are already
+             * items in the queue/semaphore. */
+            xReturn = pdFAIL;
         }
-        else if ( type == RT_Object_Class_MessageQueue )
+        else
         {
-            rt_mq_detach( ( rt_mq_t ) pipc );
+            pxQueue->pxQueueSetContainer = xQueueSet;
+            xReturn = pdPASS;
         }
-    #endif
-#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        rt_hw_interrupt_enable( level );
+
+        return xReturn;
     }
-    else
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                                    QueueSetHandle_t xQueueSet )
     {
-#endif
-    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-        if ( type == RT_Object_Class_Mutex )
-        {
-            rt_mutex_delete( ( rt_mutex_t ) pipc );
-        }
-        else if ( type == RT_Object_Class_Semaphore )
+        Queue_t * const pxQueue = xQueueOrSemaphore;
+        BaseType_t xReturn;
+        rt_base_t level;
+
+        configASSERT( pxQueue );
+
+        level = rt_hw_interrupt_disable();
+        if ( pxQueue->pxQueueSetContainer != xQueueSet )
         {
-            /* Allocated with rt_sem_init in xQueueGenericCreate */
-            pipc->parent.type |= RT_Object_Class_Static;
-            rt_sem_detach( ( rt_sem_t ) pipc );
-            RT_KERNEL_FREE( pipc );
+            /* The queue was not a member of the set. */
+            xReturn = pdFAIL;
         }
-        else if ( type == RT_Object_Class_MessageQueue )
+        else if ( uxQueueMessagesWaiting( xQueueOrSemaphore ) != ( UBaseType_t ) 0 )
         {
-            rt_mq_delete( ( rt_mq_t ) pipc );
+            /* It is dangerous to remove a queue from a set when the queue is
+             * not empty because the queue set will still hold pending events for
+             * the queue. */
+            xReturn = pdFAIL;
         }
         else
         {
-            return;
+            pxQueue->pxQueueSetContainer = NULL;
+            xReturn = pdPASS;
         }
-        RT_KERNEL_FREE( pxQueue );
-    #endif
+        rt_hw_interrupt_enable( level );
+
+        return xReturn;
     }
-}
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
-{
-    BaseType_t xReturn;
+    QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
+                                                TickType_t const xTicksToWait )
+    {
+        QueueSetMemberHandle_t xReturn = NULL;
 
-    configASSERT( xQueue );
+        ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait );
 
-    if( uxQueueMessagesWaiting( xQueue ) == ( UBaseType_t ) 0 )
-    {
-        xReturn = pdTRUE;
-    }
-    else
-    {
-        xReturn = pdFALSE;
+        return xReturn;
     }
-
-    return xReturn;
-}
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
-{
-    BaseType_t xReturn;
+    QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet )
+    {
+        QueueSetMemberHandle_t xReturn = NULL;
 
-    configASSERT( xQueue );
+        ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL );
 
-    if ( uxQueueSpacesAvailable( xQueue ) == ( UBaseType_t ) 0 )
-    {
-        xReturn = pdTRUE;
-    }
-    else
-    {
-        xReturn = pdFALSE;
+        return xReturn;
     }
 
-    return xReturn;
-}
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#ifdef ESP_PLATFORM
+#if defined( ESP_PLATFORM ) && ( configUSE_QUEUE_SETS == 0 )
 /* Unimplemented */
 #include "esp_log.h"
 static const char *TAG = "freertos";
@@ -790,27 +5942,4 @@ QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet )
     configASSERT(0);
     return NULL;
 }
-
-BaseType_t xQueuePeek( QueueHandle_t xQueue,
-                       void * const pvBuffer,
-                       TickType_t xTicksToWait )
-{
-    ESP_LOGE(TAG, "xQueuePeek unimplemented");
-    configASSERT(0);
-    return pdFAIL;
-}
-
-BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void * pvItemToQueue)
-{
-    ESP_LOGE(TAG, "xQueueOverwrite unimplemented");
-    configASSERT(0);
-    return pdFAIL;
-}
-
-BaseType_t xQueueOverwriteFromISR(QueueHandle_t xQueue, const void * pvItemToQueue, BaseType_t *pxHigherPriorityTaskWoken)
-{
-    ESP_LOGE(TAG, "xQueueOverwriteFromISR unimplemented");
-    configASSERT(0);
-    return pdFAIL;
-}
 #endif
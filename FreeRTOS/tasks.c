@@ -39,6 +39,23 @@
 #define taskWAITING_NOTIFICATION                  ( ( uint8_t ) 1 )
 #define taskNOTIFICATION_RECEIVED                 ( ( uint8_t ) 2 )
 
+/* Characters used by vTaskList() to show the state of each task. */
+#define tskRUNNING_CHAR      ( 'X' )
+#define tskBLOCKED_CHAR      ( 'B' )
+#define tskREADY_CHAR        ( 'R' )
+#define tskDELETED_CHAR      ( 'D' )
+#define tskSUSPENDED_CHAR    ( 'S' )
+
+/* The object hooks keep a table of the live threads when the run time of each
+ * thread has to be found on every switch, or when a snapshot has to check
+ * that a thread it copied has not been freed since.  Without RT_USING_HOOK a
+ * snapshot walks the thread list instead. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) || ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_STACK_MONITOR == 1 ) ) && defined( RT_USING_HOOK ) )
+    #define taskUSE_THREAD_TABLE    1
+#else
+    #define taskUSE_THREAD_TABLE    0
+#endif
+
 /*
  * Several functions take a TaskHandle_t parameter that can optionally be NULL,
  * where NULL is used to indicate that the handle of the currently executing
@@ -299,15 +316,10 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
 #if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
 
-    eTaskState eTaskGetState( TaskHandle_t xTask )
+/* Must be called with interrupts disabled. */
+    static eTaskState prvTaskGetState( rt_thread_t thread )
     {
         eTaskState eReturn;
-        rt_thread_t thread = ( rt_thread_t ) xTask;
-        rt_base_t level;
-
-        configASSERT( xTask );
-
-        level = rt_hw_interrupt_disable();
 
         switch ( thread->stat & RT_THREAD_STAT_MASK )
         {
@@ -344,6 +356,18 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 eReturn = eInvalid;
         }
 
+        return eReturn;
+    }
+
+    eTaskState eTaskGetState( TaskHandle_t xTask )
+    {
+        eTaskState eReturn;
+        rt_base_t level;
+
+        configASSERT( xTask );
+
+        level = rt_hw_interrupt_disable();
+        eReturn = prvTaskGetState( ( rt_thread_t ) xTask );
         rt_hw_interrupt_enable( level );
 
         return eReturn;
@@ -386,6 +410,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                            UBaseType_t uxNewPriority )
     {
         extern rt_thread_t rt_current_thread;
+        extern rt_uint8_t ucQueueInheritedPriority( rt_thread_t thread, rt_uint8_t priority );
         rt_thread_t thread;
         rt_uint8_t current_priority;
         rt_bool_t need_schedule = RT_FALSE;
@@ -403,6 +428,11 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         level = rt_hw_interrupt_disable();
 
         thread = ( rt_thread_t ) prvGetTCBFromHandle( xTask );
+        /* init_priority is the base priority lean mutexes and reader-writer
+         * locks drop back to.  A task holding one that a higher priority task
+         * waits for keeps the inherited priority until it gives it. */
+        thread->init_priority = uxNewPriority;
+        uxNewPriority = ucQueueInheritedPriority( thread, uxNewPriority );
         current_priority = thread->current_priority;
         if ( current_priority != uxNewPriority )
         {
@@ -468,10 +498,11 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             if ( rt_thread_resume( thread ) == RT_EOK && thread->current_priority <= rt_thread_self()->current_priority )
             {
                 need_schedule = RT_TRUE;
+                vPortIsrYieldRequest( thread );
             }
             rt_hw_interrupt_enable( level );
         }
-        if (need_schedule == RT_TRUE)
+        if ( ( need_schedule == RT_TRUE ) && ( xPortIsrYieldDeferred() == pdFALSE ) )
         {
             rt_schedule();
         }
@@ -485,8 +516,14 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
     BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
     {
+        BaseType_t xPreviousYield;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        xPreviousYield = xPortIsrYieldBegin();
         vTaskResume( xTaskToResume );
-        return pdFALSE;
+        vPortIsrYieldEnd( xPreviousYield, &xYieldRequired );
+
+        return xYieldRequired;
     }
 
 #endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
@@ -534,8 +571,461 @@ TickType_t xTaskGetTickCountFromISR( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_NAME_INDEX == 1 )
+
+/* Open addressing hash table of named handles, probed linearly.  An entry with
+ * a NULL name is free.  Entries are only touched with interrupts disabled. */
+    typedef struct
+    {
+        const char * pcName;
+        void * pvHandle;
+        rt_uint32_t ulHash;
+        uint8_t ucKind;
+    } NameIndexEntry_t;
+
+    #define taskNAME_INDEX_MASK    ( ( rt_uint32_t ) configNAME_INDEX_SIZE - 1U )
+
+    #if ( configNAME_INDEX_SIZE < 2 ) || ( ( configNAME_INDEX_SIZE & ( configNAME_INDEX_SIZE - 1 ) ) != 0 )
+        #error configNAME_INDEX_SIZE must be a power of two, and at least 2.
+    #endif
+
+    static NameIndexEntry_t xNameIndex[ configNAME_INDEX_SIZE ];
+
+/* One slot is always left free, so that every probe ends on an empty slot */
+    static UBaseType_t uxNameIndexUsed = 0;
+
+/* Handles of each kind that did not fit in the table, which lookups then have
+ * to find by themselves */
+    static UBaseType_t uxNameIndexMissing[ taskNAME_INDEX_KINDS ];
+
+/* FNV-1a over the part of the name that RT-Thread keeps for an object */
+    static rt_uint32_t prvNameIndexHash( const char * pcName,
+                                         uint8_t ucKind )
+    {
+        rt_uint32_t ulHash = 2166136261UL ^ ucKind;
+        int i;
+
+        for ( i = 0; ( i < RT_NAME_MAX ) && ( pcName[ i ] != '\0' ); i++ )
+        {
+            ulHash = ( ulHash ^ ( rt_uint8_t ) pcName[ i ] ) * 16777619UL;
+        }
+
+        return ulHash;
+    }
+
+    static BaseType_t prvNameIndexMatch( const NameIndexEntry_t * pxEntry,
+                                         const char * pcName,
+                                         uint8_t ucKind )
+    {
+        if ( pxEntry->ucKind != ucKind )
+        {
+            return pdFALSE;
+        }
+        /* Object names are cut to RT_NAME_MAX characters, registry names are not */
+        if ( ucKind == taskNAME_INDEX_QUEUE )
+        {
+            return ( rt_strcmp( pxEntry->pcName, pcName ) == 0 ) ? pdTRUE : pdFALSE;
+        }
+
+        return ( rt_strncmp( pxEntry->pcName, pcName, RT_NAME_MAX ) == 0 ) ? pdTRUE : pdFALSE;
+    }
+
+    void vTaskNameIndexInsert( const char * pcName,
+                               void * pvHandle,
+                               uint8_t ucKind )
+    {
+        rt_uint32_t ulHash = prvNameIndexHash( pcName, ucKind );
+        rt_uint32_t ulSlot = ulHash & taskNAME_INDEX_MASK;
+        rt_base_t level;
+
+        configASSERT( ucKind < taskNAME_INDEX_KINDS );
+
+        level = rt_hw_interrupt_disable();
+        if ( uxNameIndexUsed < ( UBaseType_t ) ( configNAME_INDEX_SIZE - 1 ) )
+        {
+            while ( xNameIndex[ ulSlot ].pcName != NULL )
+            {
+                ulSlot = ( ulSlot + 1U ) & taskNAME_INDEX_MASK;
+            }
+            xNameIndex[ ulSlot ].pcName = pcName;
+            xNameIndex[ ulSlot ].pvHandle = pvHandle;
+            xNameIndex[ ulSlot ].ulHash = ulHash;
+            xNameIndex[ ulSlot ].ucKind = ucKind;
+            uxNameIndexUsed += 1;
+        }
+        else
+        {
+            uxNameIndexMissing[ ucKind ] += 1;
+        }
+        rt_hw_interrupt_enable( level );
+    }
+
+    void vTaskNameIndexRemove( const char * pcName,
+                               void * pvHandle,
+                               uint8_t ucKind )
+    {
+        rt_uint32_t ulSlot = prvNameIndexHash( pcName, ucKind ) & taskNAME_INDEX_MASK;
+        rt_uint32_t ulNext, ulHome;
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        while ( ( xNameIndex[ ulSlot ].pcName != NULL ) &&
+                ( ( xNameIndex[ ulSlot ].pvHandle != pvHandle ) || ( xNameIndex[ ulSlot ].ucKind != ucKind ) ) )
+        {
+            ulSlot = ( ulSlot + 1U ) & taskNAME_INDEX_MASK;
+        }
+
+        if ( xNameIndex[ ulSlot ].pcName == NULL )
+        {
+            /* It was one of the handles that did not fit */
+            if ( uxNameIndexMissing[ ucKind ] > 0 )
+            {
+                uxNameIndexMissing[ ucKind ] -= 1;
+            }
+        }
+        else
+        {
+            /* Move back every following entry of the run that may no longer be
+             * reached from its home slot once this one is freed */
+            ulNext = ulSlot;
+            for ( ;; )
+            {
+                ulNext = ( ulNext + 1U ) & taskNAME_INDEX_MASK;
+                if ( xNameIndex[ ulNext ].pcName == NULL )
+                {
+                    break;
+                }
+                ulHome = xNameIndex[ ulNext ].ulHash & taskNAME_INDEX_MASK;
+                if ( ( ( ulNext - ulHome ) & taskNAME_INDEX_MASK ) >= ( ( ulNext - ulSlot ) & taskNAME_INDEX_MASK ) )
+                {
+                    xNameIndex[ ulSlot ] = xNameIndex[ ulNext ];
+                    ulSlot = ulNext;
+                }
+            }
+            xNameIndex[ ulSlot ].pcName = NULL;
+            xNameIndex[ ulSlot ].pvHandle = NULL;
+            uxNameIndexUsed -= 1;
+        }
+        rt_hw_interrupt_enable( level );
+    }
+
+    BaseType_t xTaskNameIndexFind( const char * pcName,
+                                   uint8_t ucKind,
+                                   void ** ppvHandle )
+    {
+        rt_uint32_t ulSlot = prvNameIndexHash( pcName, ucKind ) & taskNAME_INDEX_MASK;
+        BaseType_t xReturn;
+        rt_base_t level;
+
+        *ppvHandle = NULL;
+
+        level = rt_hw_interrupt_disable();
+        while ( xNameIndex[ ulSlot ].pcName != NULL )
+        {
+            if ( prvNameIndexMatch( &( xNameIndex[ ulSlot ] ), pcName, ucKind ) != pdFALSE )
+            {
+                *ppvHandle = xNameIndex[ ulSlot ].pvHandle;
+                break;
+            }
+            ulSlot = ( ulSlot + 1U ) & taskNAME_INDEX_MASK;
+        }
+        /* A miss is only final if every handle of the kind is in the table */
+        xReturn = ( ( *ppvHandle != NULL ) || ( uxNameIndexMissing[ ucKind ] == 0 ) ) ? pdTRUE : pdFALSE;
+        rt_hw_interrupt_enable( level );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_NAME_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( taskUSE_THREAD_TABLE == 1 )
+
+/* Open addressing hash table of the live threads, keyed by the thread and
+ * probed linearly, with the run time of each.  An entry with a NULL thread is
+ * free.  The object hooks add a thread when it is created and remove it before
+ * it is freed, and entries are only touched with interrupts disabled. */
+    typedef struct
+    {
+        rt_thread_t thread;
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulRunTime;
+    #endif
+    } ThreadEntry_t;
+
+    #define taskTHREAD_TABLE_MASK    ( ( rt_uint32_t ) configTHREAD_TABLE_SIZE - 1U )
+
+    #if ( configTHREAD_TABLE_SIZE < 2 ) || ( ( configTHREAD_TABLE_SIZE & ( configTHREAD_TABLE_SIZE - 1 ) ) != 0 )
+        #error configTHREAD_TABLE_SIZE must be a power of two, and at least 2.
+    #endif
+
+    static ThreadEntry_t xThreadTable[ configTHREAD_TABLE_SIZE ];
+
+/* One slot is always left free, so that every probe ends on an empty slot */
+    static UBaseType_t uxThreadTableUsed = 0;
+
+/* Live threads that did not fit in the table */
+    static UBaseType_t uxThreadTableMissing = 0;
+
+/* Thread control blocks are at least word aligned, so drop the low bits */
+    static rt_uint32_t prvThreadTableHome( rt_thread_t thread )
+    {
+        return ( ( rt_uint32_t ) ( ( rt_ubase_t ) thread / sizeof( rt_ubase_t ) ) * 2654435761UL ) & taskTHREAD_TABLE_MASK;
+    }
+
+/* Must be called with interrupts disabled.  Returns NULL for a thread that is
+ * gone, or that did not fit in the table. */
+    static ThreadEntry_t * prvThreadTableFind( rt_thread_t thread )
+    {
+        rt_uint32_t ulSlot = prvThreadTableHome( thread );
+
+        while ( xThreadTable[ ulSlot ].thread != RT_NULL )
+        {
+            if ( xThreadTable[ ulSlot ].thread == thread )
+            {
+                return &( xThreadTable[ ulSlot ] );
+            }
+            ulSlot = ( ulSlot + 1U ) & taskTHREAD_TABLE_MASK;
+        }
+
+        return NULL;
+    }
+
+/* Must be called with interrupts disabled.  A new thread starts from 0. */
+    static void prvThreadTableInsert( rt_thread_t thread )
+    {
+        rt_uint32_t ulSlot = prvThreadTableHome( thread );
+
+        if ( uxThreadTableUsed < ( UBaseType_t ) ( configTHREAD_TABLE_SIZE - 1 ) )
+        {
+            while ( xThreadTable[ ulSlot ].thread != RT_NULL )
+            {
+                ulSlot = ( ulSlot + 1U ) & taskTHREAD_TABLE_MASK;
+            }
+            xThreadTable[ ulSlot ].thread = thread;
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            xThreadTable[ ulSlot ].ulRunTime = 0;
+        #endif
+            uxThreadTableUsed += 1;
+        }
+        else
+        {
+            uxThreadTableMissing += 1;
+        }
+    }
+
+/* Must be called with interrupts disabled */
+    static void prvThreadTableRemove( rt_thread_t thread )
+    {
+        ThreadEntry_t * pxEntry = prvThreadTableFind( thread );
+        rt_uint32_t ulSlot, ulNext, ulHome;
+
+        if ( pxEntry == NULL )
+        {
+            /* It was one of the threads that did not fit */
+            if ( uxThreadTableMissing > 0 )
+            {
+                uxThreadTableMissing -= 1;
+            }
+            return;
+        }
+
+        /* Move back every following entry of the run that may no longer be
+         * reached from its home slot once this one is freed */
+        ulSlot = ( rt_uint32_t ) ( pxEntry - xThreadTable );
+        ulNext = ulSlot;
+        for ( ;; )
+        {
+            ulNext = ( ulNext + 1U ) & taskTHREAD_TABLE_MASK;
+            if ( xThreadTable[ ulNext ].thread == RT_NULL )
+            {
+                break;
+            }
+            ulHome = prvThreadTableHome( xThreadTable[ ulNext ].thread );
+            if ( ( ( ulNext - ulHome ) & taskTHREAD_TABLE_MASK ) >= ( ( ulNext - ulSlot ) & taskTHREAD_TABLE_MASK ) )
+            {
+                xThreadTable[ ulSlot ] = xThreadTable[ ulNext ];
+                ulSlot = ulNext;
+            }
+        }
+        xThreadTable[ ulSlot ].thread = RT_NULL;
+        uxThreadTableUsed -= 1;
+    }
+
+#endif /* taskUSE_THREAD_TABLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_LIVE_TASK_COUNT == 1 ) || ( configUSE_NAME_INDEX == 1 ) || ( taskUSE_THREAD_TABLE == 1 )
+
+    #ifndef RT_USING_HOOK
+        #error configUSE_LIVE_TASK_COUNT, configUSE_NAME_INDEX and configGENERATE_RUN_TIME_STATS need RT_USING_HOOK to be defined.
+    #endif
+
+    #define taskUSE_OBJECT_HOOKS    1
+
+    #if ( configUSE_LIVE_TASK_COUNT == 1 )
+
+/* Number of thread objects, native threads included.  The object hooks keep
+ * it up to date as threads are created and freed, so that
+ * uxTaskGetNumberOfTasks() does not have to walk the object list. */
+        static volatile rt_uint32_t ulTaskCount = 0;
+
+    #endif
+
+/* Object hooks of the application, given to vTaskSetObjectHooks().  RT-Thread
+ * has a single slot for each hook, which the wrapper keeps for itself and
+ * forwards from. */
+    static void ( * volatile pxApplicationAttachHook )( struct rt_object * object ) = RT_NULL;
+    static void ( * volatile pxApplicationDetachHook )( struct rt_object * object ) = RT_NULL;
+
+/* Object initialised and detached at start-up to check that the hooks are
+ * still the wrapper's */
+    static struct rt_semaphore xObjectHooksProbe;
+    static volatile BaseType_t xObjectHooksProbeSeen = pdFALSE;
+
+/* Called when any kernel object is created, and again before it is freed.
+ * RT-Thread has set the name of the object by then. */
+    static void prvTaskObjectAttach( struct rt_object * object )
+    {
+    #if ( configUSE_LIVE_TASK_COUNT == 1 ) || ( taskUSE_THREAD_TABLE == 1 )
+        rt_base_t level;
+    #endif
+
+        if ( rt_object_get_type( object ) == RT_Object_Class_Thread )
+        {
+        #if ( configUSE_LIVE_TASK_COUNT == 1 )
+            level = rt_hw_interrupt_disable();
+            ulTaskCount += 1;
+            rt_hw_interrupt_enable( level );
+        #endif
+        #if ( taskUSE_THREAD_TABLE == 1 )
+            level = rt_hw_interrupt_disable();
+            prvThreadTableInsert( ( rt_thread_t ) object );
+            rt_hw_interrupt_enable( level );
+        #endif
+        #if ( configUSE_NAME_INDEX == 1 )
+            vTaskNameIndexInsert( object->name, object, taskNAME_INDEX_TASK );
+        #endif
+        }
+    }
+
+    static void prvTaskObjectDetach( struct rt_object * object )
+    {
+    #if ( configUSE_LIVE_TASK_COUNT == 1 ) || ( taskUSE_THREAD_TABLE == 1 )
+        rt_base_t level;
+    #endif
+
+        if ( rt_object_get_type( object ) == RT_Object_Class_Thread )
+        {
+        #if ( configUSE_LIVE_TASK_COUNT == 1 )
+            level = rt_hw_interrupt_disable();
+            ulTaskCount -= 1;
+            rt_hw_interrupt_enable( level );
+        #endif
+        #if ( taskUSE_THREAD_TABLE == 1 )
+            level = rt_hw_interrupt_disable();
+            prvThreadTableRemove( ( rt_thread_t ) object );
+            rt_hw_interrupt_enable( level );
+        #endif
+        #if ( configUSE_NAME_INDEX == 1 )
+            vTaskNameIndexRemove( object->name, object, taskNAME_INDEX_TASK );
+        #endif
+        }
+    }
+
+/* The hooks installed in RT-Thread: every feature that follows objects, then
+ * the application */
+    static void prvTaskObjectAttachHook( struct rt_object * object )
+    {
+        void ( * pxHook )( struct rt_object * object ) = pxApplicationAttachHook;
+
+        if ( object == &( xObjectHooksProbe.parent.parent ) )
+        {
+            xObjectHooksProbeSeen = pdTRUE;
+            return;
+        }
+        prvTaskObjectAttach( object );
+        if ( pxHook != RT_NULL )
+        {
+            pxHook( object );
+        }
+    }
+
+    static void prvTaskObjectDetachHook( struct rt_object * object )
+    {
+        void ( * pxHook )( struct rt_object * object ) = pxApplicationDetachHook;
+
+        if ( object == &( xObjectHooksProbe.parent.parent ) )
+        {
+            return;
+        }
+        prvTaskObjectDetach( object );
+        if ( pxHook != RT_NULL )
+        {
+            pxHook( object );
+        }
+    }
+
+    static int prvTaskObjectHooksInit( void )
+    {
+        rt_base_t level;
+        struct rt_object_information *information;
+        struct rt_list_node *node = RT_NULL;
+
+        information = rt_object_get_information( RT_Object_Class_Thread );
+        RT_ASSERT( information != RT_NULL );
+
+        /* Take in the threads created so far and install the hooks at once,
+         * so that no thread is missed or counted twice */
+        level = rt_hw_interrupt_disable();
+
+        rt_list_for_each( node, &( information->object_list ) )
+        {
+            prvTaskObjectAttach( rt_list_entry( node, struct rt_object, list ) );
+        }
+        rt_object_attach_sethook( prvTaskObjectAttachHook );
+        rt_object_detach_sethook( prvTaskObjectDetachHook );
+
+        rt_hw_interrupt_enable( level );
+
+        return 0;
+    }
+    INIT_PREV_EXPORT( prvTaskObjectHooksInit );
+
+    void vTaskSetObjectHooks( void ( * pxAttachHook )( struct rt_object * object ),
+                              void ( * pxDetachHook )( struct rt_object * object ) )
+    {
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        pxApplicationAttachHook = pxAttachHook;
+        pxApplicationDetachHook = pxDetachHook;
+        rt_hw_interrupt_enable( level );
+    }
+
+#else /* ( configUSE_LIVE_TASK_COUNT == 1 ) || ( configUSE_NAME_INDEX == 1 ) || ( taskUSE_THREAD_TABLE == 1 ) */
+
+    #define taskUSE_OBJECT_HOOKS    0
+
+    #ifdef RT_USING_HOOK
+
+        void vTaskSetObjectHooks( void ( * pxAttachHook )( struct rt_object * object ),
+                                  void ( * pxDetachHook )( struct rt_object * object ) )
+        {
+            rt_object_attach_sethook( pxAttachHook );
+            rt_object_detach_sethook( pxDetachHook );
+        }
+
+    #endif /* RT_USING_HOOK */
+
+#endif /* ( configUSE_LIVE_TASK_COUNT == 1 ) || ( configUSE_NAME_INDEX == 1 ) || ( taskUSE_THREAD_TABLE == 1 ) */
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxTaskGetNumberOfTasks( void )
 {
+#if ( configUSE_LIVE_TASK_COUNT == 1 )
+    return ( UBaseType_t ) portATOMIC_LOAD_ACQUIRE( &ulTaskCount );
+#else
     UBaseType_t uxReturn = 0;
     rt_base_t level;
     struct rt_object_information *information;
@@ -554,6 +1044,7 @@ UBaseType_t uxTaskGetNumberOfTasks( void )
     rt_hw_interrupt_enable( level );
 
     return uxReturn;
+#endif /* configUSE_LIVE_TASK_COUNT */
 }
 /*-----------------------------------------------------------*/
 
@@ -572,6 +1063,15 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 
     TaskHandle_t xTaskGetHandle( const char * pcNameToQuery )
     {
+    #if ( configUSE_NAME_INDEX == 1 )
+        void * pvHandle;
+
+        if ( xTaskNameIndexFind( pcNameToQuery, taskNAME_INDEX_TASK, &pvHandle ) != pdFALSE )
+        {
+            return ( TaskHandle_t ) pvHandle;
+        }
+    #endif /* configUSE_NAME_INDEX */
+
         return ( TaskHandle_t ) rt_thread_find( ( char * ) pcNameToQuery );
     }
 
@@ -1044,8 +1544,10 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
         if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
         {
             rt_thread_resume( ( rt_thread_t ) pxTCB );
+            vPortIsrYieldRequest( ( rt_thread_t ) pxTCB );
 
-            if( ( ( rt_thread_t ) pxTCB )->current_priority < rt_thread_self()->current_priority )
+            if( ( xPortIsrYieldDeferred() == pdFALSE ) &&
+                ( ( ( rt_thread_t ) pxTCB )->current_priority < rt_thread_self()->current_priority ) )
             {
                 /* The notified task has a priority above the currently
                  * executing task so a schedule is required. */
@@ -1070,12 +1572,11 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
                                           BaseType_t * pxHigherPriorityTaskWoken )
     {
         BaseType_t xReturn;
+        BaseType_t xPreviousYield;
 
+        xPreviousYield = xPortIsrYieldBegin();
         xReturn = xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue );
-        if ( pxHigherPriorityTaskWoken != NULL )
-        {
-            *pxHigherPriorityTaskWoken = pdFALSE;
-        }
+        vPortIsrYieldEnd( xPreviousYield, pxHigherPriorityTaskWoken );
 
         return xReturn;
     }
@@ -1089,11 +1590,11 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
                                         UBaseType_t uxIndexToNotify,
                                         BaseType_t * pxHigherPriorityTaskWoken )
     {
+        BaseType_t xPreviousYield;
+
+        xPreviousYield = xPortIsrYieldBegin();
         xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify );
-        if ( pxHigherPriorityTaskWoken != NULL )
-        {
-            *pxHigherPriorityTaskWoken = pdFALSE;
-        }
+        vPortIsrYieldEnd( xPreviousYield, pxHigherPriorityTaskWoken );
     }
 
 #endif /* configUSE_TASK_NOTIFICATIONS */
@@ -1163,37 +1664,126 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
 #endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_STACK_MONITOR == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
- * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
- * user to determine the return type.  It gets around the problem of the value
- * overflowing on 8-bit types without breaking backward compatibility for
- * applications that expect an 8-bit return type. */
-    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+/* RT-Thread fills a new stack with '#' bytes.  taskSTACK_FILL_WORD is a whole
+ * word of them, so that the untouched part of a stack can be compared a word
+ * at a time. */
+    #define taskSTACK_FILL_BYTE    ( ( rt_uint8_t ) '#' )
+    #define taskSTACK_FILL_WORD    ( ( ~( rt_ubase_t ) 0 / ( rt_ubase_t ) 0xFFU ) * ( rt_ubase_t ) taskSTACK_FILL_BYTE )
+    #define taskWORD_ALIGNED( p )  ( ( ( rt_ubase_t ) ( p ) & ( sizeof( rt_ubase_t ) - 1 ) ) == 0 )
+
+/* Returns the number of bytes at the far end of the stack that still hold the
+ * fill value.  The scan always starts at the far end: a deeper call may have
+ * left locals untouched between its frame and the previous high water mark,
+ * so resuming from a previous mark could miss it. */
+    static rt_uint32_t prvTaskUnusedStackBytes( rt_thread_t thread )
     {
-        uint32_t ulCount = 0U;
-        rt_thread_t thread = ( rt_thread_t ) prvGetTCBFromHandle( xTask );
-        rt_uint8_t * stack_addr = thread->stack_addr;
+        rt_uint8_t * start = ( rt_uint8_t * ) thread->stack_addr;
+        rt_uint8_t * end = start + thread->stack_size;
 
     #ifdef ARCH_CPU_STACK_GROWS_UPWARD
-        stack_addr = stack_addr + thread->stack_size - 1;
-        while ( *stack_addr == '#' )
+        rt_uint8_t * p = end;
+
+        while ( ( p > start ) && !taskWORD_ALIGNED( p ) && ( p[ -1 ] == taskSTACK_FILL_BYTE ) )
+        {
+            p -= 1;
+        }
+        if ( taskWORD_ALIGNED( p ) )
+        {
+            while ( ( p - start >= ( rt_base_t ) sizeof( rt_ubase_t ) ) &&
+                    ( *( ( rt_ubase_t * ) p - 1 ) == taskSTACK_FILL_WORD ) )
+            {
+                p -= sizeof( rt_ubase_t );
+            }
+        }
+        /* The first word in use may still end with unused bytes */
+        while ( ( p > start ) && ( p[ -1 ] == taskSTACK_FILL_BYTE ) )
         {
-            ulCount += 1;
-            stack_addr -= 1;
+            p -= 1;
         }
+
+        return ( rt_uint32_t ) ( end - p );
     #else
-        while ( *stack_addr == '#' )
+        rt_uint8_t * p = start;
+
+        while ( ( p < end ) && !taskWORD_ALIGNED( p ) && ( *p == taskSTACK_FILL_BYTE ) )
         {
-            ulCount += 1;
-            stack_addr += 1;
+            p += 1;
         }
-    #endif
+        if ( taskWORD_ALIGNED( p ) )
+        {
+            while ( ( end - p >= ( rt_base_t ) sizeof( rt_ubase_t ) ) &&
+                    ( *( rt_ubase_t * ) p == taskSTACK_FILL_WORD ) )
+            {
+                p += sizeof( rt_ubase_t );
+            }
+        }
+        /* The first word in use may still start with unused bytes */
+        while ( ( p < end ) && ( *p == taskSTACK_FILL_BYTE ) )
+        {
+            p += 1;
+        }
+
+        return ( rt_uint32_t ) ( p - start );
+    #endif /* ARCH_CPU_STACK_GROWS_UPWARD */
+    }
+
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( rt_thread_t thread )
+    {
+        return ( configSTACK_DEPTH_TYPE ) ( prvTaskUnusedStackBytes( thread ) / ( rt_uint32_t ) sizeof( StackType_t ) );
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_STACK_MONITOR == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_STACK_MONITOR == 1 ) )
+
+/* Must be called with interrupts disabled.  A thread is freed only after the
+ * detach hook has taken it out of the thread table, or off the thread object
+ * list without the table, so a thread that is still there and not closed
+ * stays valid until interrupts are enabled again, on any core.  The list is
+ * only walked for threads that the table had no room for. */
+    static BaseType_t prvTaskIsLive( struct rt_object_information * information,
+                                     rt_thread_t thread )
+    {
+        struct rt_list_node *node;
+
+    #if ( taskUSE_THREAD_TABLE == 1 )
+        if ( prvThreadTableFind( thread ) != NULL )
+        {
+            return ( ( thread->stat & RT_THREAD_STAT_MASK ) != RT_THREAD_CLOSE ) ? pdTRUE : pdFALSE;
+        }
+        if ( uxThreadTableMissing == 0 )
+        {
+            return pdFALSE;
+        }
+    #endif /* taskUSE_THREAD_TABLE */
+
+        rt_list_for_each( node, &( information->object_list ) )
+        {
+            if ( rt_list_entry( node, struct rt_object, list ) == ( struct rt_object * ) thread )
+            {
+                return ( ( thread->stat & RT_THREAD_STAT_MASK ) != RT_THREAD_CLOSE ) ? pdTRUE : pdFALSE;
+            }
+        }
+
+        return pdFALSE;
+    }
 
-        ulCount /= ( uint32_t ) sizeof( StackType_t );
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_STACK_MONITOR == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
 
-        return ( configSTACK_DEPTH_TYPE ) ulCount;
+/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+ * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+ * user to determine the return type.  It gets around the problem of the value
+ * overflowing on 8-bit types without breaking backward compatibility for
+ * applications that expect an 8-bit return type. */
+    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    {
+        return prvTaskCheckFreeStackSpace( ( rt_thread_t ) prvGetTCBFromHandle( xTask ) );
     }
 
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
@@ -1209,6 +1799,689 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STACK_MONITOR == 1 )
+
+/* Peak stack use seen for each thread name, in bytes.  Threads that share a
+ * name share an entry, which keeps the largest peak and the latest stack size.
+ * Only the monitor task writes the table, with interrupts disabled. */
+    static struct
+    {
+        char name[ RT_NAME_MAX ];
+        rt_uint32_t stack_size;
+        rt_uint32_t peak;
+    } xStackMonitorRecords[ configSTACK_MONITOR_MAX_TASKS ];
+    static UBaseType_t uxStackMonitorRecordCount = 0;
+
+/* Threads to measure in one pass, copied from the thread list */
+    static rt_thread_t xStackMonitorThreads[ configSTACK_MONITOR_MAX_TASKS ];
+
+    static struct rt_thread xStackMonitorThread;
+    static StackType_t uxStackMonitorStack[ configSTACK_MONITOR_STACK_SIZE ] rt_align( RT_ALIGN_SIZE );
+
+    static void prvStackMonitorRecord( rt_thread_t thread )
+    {
+        const char * name = pcTaskGetName( ( TaskHandle_t ) thread );
+        rt_uint32_t used = thread->stack_size - prvTaskUnusedStackBytes( thread );
+        UBaseType_t ux;
+
+        for ( ux = 0; ux < uxStackMonitorRecordCount; ux++ )
+        {
+            if ( rt_strncmp( xStackMonitorRecords[ ux ].name, name, RT_NAME_MAX ) == 0 )
+            {
+                break;
+            }
+        }
+        if ( ux == uxStackMonitorRecordCount )
+        {
+            if ( ux == ( UBaseType_t ) configSTACK_MONITOR_MAX_TASKS )
+            {
+                /* The table is full, this thread is not monitored */
+                return;
+            }
+            rt_strncpy( xStackMonitorRecords[ ux ].name, name, RT_NAME_MAX );
+            xStackMonitorRecords[ ux ].peak = 0;
+            uxStackMonitorRecordCount += 1;
+        }
+        xStackMonitorRecords[ ux ].stack_size = thread->stack_size;
+        if ( used > xStackMonitorRecords[ ux ].peak )
+        {
+            xStackMonitorRecords[ ux ].peak = used;
+        }
+    }
+
+    static void prvStackMonitorTask( void * pvParameters )
+    {
+        struct rt_object_information *information;
+        struct rt_list_node *node;
+        UBaseType_t uxSkip, uxCount, ux;
+        rt_base_t level;
+
+        ( void ) pvParameters;
+
+        information = rt_object_get_information( RT_Object_Class_Thread );
+        RT_ASSERT( information != RT_NULL );
+
+        for ( ;; )
+        {
+            /* Copy the threads a batch at a time, oldest first, then measure
+             * them one by one so that interrupts are never disabled for more
+             * than one stack.  A thread deleted since the copy may already be
+             * freed, so each one is looked up again first. */
+            uxSkip = 0;
+            do
+            {
+                uxCount = 0;
+                ux = 0;
+                level = rt_hw_interrupt_disable();
+                for ( node = information->object_list.prev;
+                      ( node != &( information->object_list ) ) && ( uxCount < ( UBaseType_t ) configSTACK_MONITOR_MAX_TASKS );
+                      node = node->prev )
+                {
+                    if ( ux++ >= uxSkip )
+                    {
+                        xStackMonitorThreads[ uxCount++ ] = ( rt_thread_t ) rt_list_entry( node, struct rt_object, list );
+                    }
+                }
+                rt_hw_interrupt_enable( level );
+
+                for ( ux = 0; ux < uxCount; ux++ )
+                {
+                    level = rt_hw_interrupt_disable();
+                    if ( prvTaskIsLive( information, xStackMonitorThreads[ ux ] ) != pdFALSE )
+                    {
+                        prvStackMonitorRecord( xStackMonitorThreads[ ux ] );
+                    }
+                    rt_hw_interrupt_enable( level );
+                }
+                uxSkip += uxCount;
+            } while ( uxCount == ( UBaseType_t ) configSTACK_MONITOR_MAX_TASKS );
+
+            rt_thread_mdelay( configSTACK_MONITOR_PERIOD_MS );
+        }
+    }
+
+    static int prvStackMonitorInit( void )
+    {
+        /* Just above the idle task */
+        rt_thread_init( &xStackMonitorThread, "stkmon", prvStackMonitorTask, RT_NULL,
+                        uxStackMonitorStack, sizeof( uxStackMonitorStack ),
+                        FREERTOS_PRIORITY_TO_RTTHREAD( tskIDLE_PRIORITY + 1 ), 1 );
+        rt_thread_startup( &xStackMonitorThread );
+
+        return 0;
+    }
+    INIT_APP_EXPORT( prvStackMonitorInit );
+
+    #if defined( RT_USING_FINSH )
+
+/*
+ * List the peak stack use of every monitored thread, in words of
+ * sizeof( StackType_t ) as usStackDepth is given to xTaskCreate(), with the
+ * depth suggested for it.
+ */
+        static int stack_monitor( void )
+        {
+            /* Static to keep the shell stack small; the shell runs one command at a time */
+            static struct
+            {
+                char name[ RT_NAME_MAX ];
+                rt_uint32_t stack_size;
+                rt_uint32_t peak;
+            } xEntries[ configSTACK_MONITOR_MAX_TASKS ];
+            UBaseType_t uxCount;
+            UBaseType_t ux;
+            rt_uint32_t ulSize, ulPeak, ulSuggested;
+            rt_base_t level;
+
+            level = rt_hw_interrupt_disable();
+            uxCount = uxStackMonitorRecordCount;
+            rt_memcpy( xEntries, xStackMonitorRecords, uxCount * sizeof( xEntries[ 0 ] ) );
+            rt_hw_interrupt_enable( level );
+
+            rt_kprintf( "thread     depth      peak       suggested\n" );
+            rt_kprintf( "---------- ---------- ---------- ----------\n" );
+            for ( ux = 0; ux < uxCount; ux++ )
+            {
+                ulSize = xEntries[ ux ].stack_size / ( rt_uint32_t ) sizeof( StackType_t );
+                ulPeak = ( xEntries[ ux ].peak + ( rt_uint32_t ) sizeof( StackType_t ) - 1 ) / ( rt_uint32_t ) sizeof( StackType_t );
+                ulSuggested = ulPeak + ( ulPeak * configSTACK_MONITOR_MARGIN + 99 ) / 100;
+                rt_kprintf( "%-10.*s %-10u %-10u %u\n", RT_NAME_MAX, xEntries[ ux ].name,
+                            ulSize, ulPeak, ulSuggested );
+            }
+
+            return 0;
+        }
+        MSH_CMD_EXPORT( stack_monitor, list peak stack use and suggested stack depths );
+
+    #endif /* RT_USING_FINSH */
+
+#endif /* configUSE_STACK_MONITOR */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    #ifndef RT_USING_HOOK
+        #error configGENERATE_RUN_TIME_STATS needs RT_USING_HOOK to be defined.
+    #endif
+
+    #ifdef RT_USING_SMP
+        #define taskRUN_TIME_CPUS    RT_CPUS_NR
+        #define taskRUN_TIME_CPU()   rt_hw_cpu_id()
+    #else
+        #define taskRUN_TIME_CPUS    1
+        #define taskRUN_TIME_CPU()   0
+    #endif
+
+/* The run time of each thread is kept in xThreadTable, which the object hooks
+ * keep in step with the threads.  ulTaskSwitchedInTime holds the time at
+ * which each core last switched tasks, xRunningTasks the task it switched to,
+ * and ulRunTimeStart the time at which the accounting started. */
+    static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ taskRUN_TIME_CPUS ];
+    static rt_thread_t xRunningTasks[ taskRUN_TIME_CPUS ];
+    static configRUN_TIME_COUNTER_TYPE ulRunTimeStart;
+    static rt_thread_t xIdleTasks[ taskRUN_TIME_CPUS ];
+
+/* Scheduler hook of the application, given to vTaskSetSchedulerHook() */
+    static void ( * volatile pxApplicationSchedulerHook )( struct rt_thread * from, struct rt_thread * to ) = RT_NULL;
+
+/* Called by the scheduler with interrupts disabled */
+    static void prvTaskSwitchHook( rt_thread_t from,
+                                   rt_thread_t to )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+        ThreadEntry_t * pxEntry = prvThreadTableFind( from );
+        void ( * pxHook )( struct rt_thread * from, struct rt_thread * to ) = pxApplicationSchedulerHook;
+        int cpu = taskRUN_TIME_CPU();
+
+        if ( pxEntry != NULL )
+        {
+            pxEntry->ulRunTime += ulNow - ulTaskSwitchedInTime[ cpu ];
+        }
+        ulTaskSwitchedInTime[ cpu ] = ulNow;
+        xRunningTasks[ cpu ] = to;
+
+        if ( pxHook != RT_NULL )
+        {
+            pxHook( from, to );
+        }
+    }
+
+    static int prvTaskRunTimeStatsInit( void )
+    {
+        char name[ RT_NAME_MAX ];
+        int cpu;
+
+        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+
+        for ( cpu = 0; cpu < taskRUN_TIME_CPUS; cpu++ )
+        {
+            rt_snprintf( name, sizeof( name ), "tidle%d", cpu );
+            xIdleTasks[ cpu ] = rt_thread_find( name );
+        }
+
+        ulRunTimeStart = portGET_RUN_TIME_COUNTER_VALUE();
+        for ( cpu = 0; cpu < taskRUN_TIME_CPUS; cpu++ )
+        {
+            ulTaskSwitchedInTime[ cpu ] = ulRunTimeStart;
+        }
+        /* The other cores are known from their first switch on */
+        xRunningTasks[ taskRUN_TIME_CPU() ] = rt_thread_self();
+        rt_scheduler_sethook( prvTaskSwitchHook );
+
+        return 0;
+    }
+    INIT_COMPONENT_EXPORT( prvTaskRunTimeStatsInit );
+
+    void vTaskSetSchedulerHook( void ( * pxHook )( struct rt_thread * from,
+                                                   struct rt_thread * to ) )
+    {
+        pxApplicationSchedulerHook = pxHook;
+    }
+
+/* Must be called with interrupts disabled.  A task that is running, on any
+ * core, is also given the time since that core last switched. */
+    static configRUN_TIME_COUNTER_TYPE prvTaskGetRunTime( rt_thread_t thread )
+    {
+        ThreadEntry_t * pxEntry = prvThreadTableFind( thread );
+        configRUN_TIME_COUNTER_TYPE ulRunTime;
+        int cpu;
+
+        if ( pxEntry == NULL )
+        {
+            /* The table was full when the thread was created */
+            return 0;
+        }
+        ulRunTime = pxEntry->ulRunTime;
+        for ( cpu = 0; cpu < taskRUN_TIME_CPUS; cpu++ )
+        {
+            if ( xRunningTasks[ cpu ] == thread )
+            {
+                ulRunTime += portGET_RUN_TIME_COUNTER_VALUE() - ulTaskSwitchedInTime[ cpu ];
+                break;
+            }
+        }
+
+        return ulRunTime;
+    }
+
+/* Must be called with interrupts disabled.  Adds up the idle tasks of all
+ * cores. */
+    static configRUN_TIME_COUNTER_TYPE prvTaskGetIdleRunTime( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulRunTime = 0;
+        int cpu;
+
+        for ( cpu = 0; cpu < taskRUN_TIME_CPUS; cpu++ )
+        {
+            if ( xIdleTasks[ cpu ] != RT_NULL )
+            {
+                ulRunTime += prvTaskGetRunTime( xIdleTasks[ cpu ] );
+            }
+        }
+
+        return ulRunTime;
+    }
+
+/* The run time of all cores together since the accounting started, so that
+ * the shares of all tasks add up to 100% */
+    static configRUN_TIME_COUNTER_TYPE prvTaskGetTotalRunTime( void )
+    {
+        return ( portGET_RUN_TIME_COUNTER_VALUE() - ulRunTimeStart ) * taskRUN_TIME_CPUS;
+    }
+
+    static configRUN_TIME_COUNTER_TYPE prvTaskRunTimePercent( configRUN_TIME_COUNTER_TYPE ulRunTime,
+                                                              configRUN_TIME_COUNTER_TYPE ulTotalTime )
+    {
+        /* For percentage calculations */
+        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+
+        if ( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        {
+            return ulRunTime / ulTotalTime;
+        }
+
+        return 0;
+    }
+/*-----------------------------------------------------------*/
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter( const TaskHandle_t xTask )
+    {
+        configRUN_TIME_COUNTER_TYPE ulReturn;
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        ulReturn = prvTaskGetRunTime( ( rt_thread_t ) prvGetTCBFromHandle( xTask ) );
+        rt_hw_interrupt_enable( level );
+
+        return ulReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimePercent( const TaskHandle_t xTask )
+    {
+        configRUN_TIME_COUNTER_TYPE ulRunTime, ulTotalTime;
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        ulRunTime = prvTaskGetRunTime( ( rt_thread_t ) prvGetTCBFromHandle( xTask ) );
+        ulTotalTime = prvTaskGetTotalRunTime();
+        rt_hw_interrupt_enable( level );
+
+        return prvTaskRunTimePercent( ulRunTime, ulTotalTime );
+    }
+/*-----------------------------------------------------------*/
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulReturn;
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        ulReturn = prvTaskGetIdleRunTime();
+        rt_hw_interrupt_enable( level );
+
+        return ulReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulRunTime, ulTotalTime;
+        rt_base_t level;
+
+        level = rt_hw_interrupt_disable();
+        ulRunTime = prvTaskGetIdleRunTime();
+        ulTotalTime = prvTaskGetTotalRunTime();
+        rt_hw_interrupt_enable( level );
+
+        return prvTaskRunTimePercent( ulRunTime, ulTotalTime );
+    }
+
+#elif defined( RT_USING_HOOK )
+
+    void vTaskSetSchedulerHook( void ( * pxHook )( struct rt_thread * from,
+                                                   struct rt_thread * to ) )
+    {
+        rt_scheduler_sethook( pxHook );
+    }
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( taskUSE_OBJECT_HOOKS == 1 )
+
+/*
+ * RT-Thread keeps a single slot for each hook, and says nothing when a hook is
+ * replaced.  Once the other initialisers have run, check that the hooks the
+ * wrapper installed are still in place, so that a component that set its own
+ * instead of going through vTaskSetObjectHooks() or vTaskSetSchedulerHook()
+ * is reported rather than leaving the task count, name index or run-time
+ * stats silently stale.
+ */
+    static int prvTaskHooksCheck( void )
+    {
+        rt_sem_init( &xObjectHooksProbe, "hkprobe", 0, RT_IPC_FLAG_PRIO );
+        rt_sem_detach( &xObjectHooksProbe );
+        if ( xObjectHooksProbeSeen == pdFALSE )
+        {
+            rt_kprintf( "FreeRTOS: the object hooks were replaced, use vTaskSetObjectHooks()\n" );
+            configASSERT( xObjectHooksProbeSeen != pdFALSE );
+        }
+
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            BaseType_t xSeen;
+            rt_base_t level;
+            int cpu;
+
+            /* The switch back to this task records it again */
+            level = rt_hw_interrupt_disable();
+            for ( cpu = 0; cpu < taskRUN_TIME_CPUS; cpu++ )
+            {
+                if ( xRunningTasks[ cpu ] == rt_thread_self() )
+                {
+                    xRunningTasks[ cpu ] = RT_NULL;
+                }
+            }
+            rt_hw_interrupt_enable( level );
+            rt_thread_mdelay( 1 );
+            level = rt_hw_interrupt_disable();
+            xSeen = ( xRunningTasks[ taskRUN_TIME_CPU() ] == rt_thread_self() ) ? pdTRUE : pdFALSE;
+            rt_hw_interrupt_enable( level );
+            if ( xSeen == pdFALSE )
+            {
+                rt_kprintf( "FreeRTOS: the scheduler hook was replaced, use vTaskSetSchedulerHook()\n" );
+                configASSERT( xSeen != pdFALSE );
+            }
+        }
+    #endif /* configGENERATE_RUN_TIME_STATS */
+
+        return 0;
+    }
+    INIT_APP_EXPORT( prvTaskHooksCheck );
+
+#endif /* taskUSE_OBJECT_HOOKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
+                                      const UBaseType_t uxArraySize,
+                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    {
+        UBaseType_t uxTask = 0;
+        UBaseType_t uxSnapshot;
+        UBaseType_t x;
+        rt_thread_t thread;
+        rt_base_t level;
+        struct rt_object_information *information;
+        struct rt_list_node *node;
+        configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0;
+
+        information = rt_object_get_information( RT_Object_Class_Thread );
+        RT_ASSERT( information != RT_NULL );
+
+        /* Only copy the raw fields with interrupts disabled. New threads are
+         * inserted at the head of the list, so walk it from the tail to report
+         * the oldest thread first */
+        level = rt_hw_interrupt_disable();
+
+        for ( node = information->object_list.prev; node != &( information->object_list ); node = node->prev )
+        {
+            if ( uxTask == uxArraySize )
+            {
+                /* The array is too small to hold every task */
+                uxTask = 0;
+                break;
+            }
+            thread = ( rt_thread_t ) rt_list_entry( node, struct rt_object, list );
+            pxTaskStatusArray[ uxTask ].xHandle = ( TaskHandle_t ) thread;
+            pxTaskStatusArray[ uxTask ].eCurrentState = prvTaskGetState( thread );
+            pxTaskStatusArray[ uxTask ].uxCurrentPriority = thread->current_priority;
+            pxTaskStatusArray[ uxTask ].pxStackBase = ( StackType_t * ) thread->stack_addr;
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            pxTaskStatusArray[ uxTask ].ulRunTimeCounter = prvTaskGetRunTime( thread );
+        #else
+            pxTaskStatusArray[ uxTask ].ulRunTimeCounter = 0;
+        #endif
+            uxTask += 1;
+        }
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        ulTotalRunTime = prvTaskGetTotalRunTime();
+    #endif
+
+        rt_hw_interrupt_enable( level );
+
+        /* Scan the stacks one thread at a time, so that interrupts are never
+         * disabled for more than one stack.  A thread deleted since the
+         * snapshot may already be freed, so each one is looked up again
+         * first and left out if it is gone. */
+        uxSnapshot = uxTask;
+        uxTask = 0;
+        for ( x = 0; x < uxSnapshot; x++ )
+        {
+            thread = ( rt_thread_t ) pxTaskStatusArray[ x ].xHandle;
+
+            level = rt_hw_interrupt_disable();
+            if ( prvTaskIsLive( information, thread ) == pdFALSE )
+            {
+                rt_hw_interrupt_enable( level );
+                continue;
+            }
+            pxTaskStatusArray[ x ].pcTaskName = pcTaskGetName( ( TaskHandle_t ) thread );
+            pxTaskStatusArray[ x ].usStackHighWaterMark = prvTaskCheckFreeStackSpace( thread );
+            rt_hw_interrupt_enable( level );
+
+            if ( uxTask != x )
+            {
+                pxTaskStatusArray[ uxTask ] = pxTaskStatusArray[ x ];
+            }
+            pxTaskStatusArray[ uxTask ].xTaskNumber = uxTask + 1;
+            pxTaskStatusArray[ uxTask ].uxCurrentPriority = RTTHREAD_PRIORITY_TO_FREERTOS( pxTaskStatusArray[ uxTask ].uxCurrentPriority );
+            pxTaskStatusArray[ uxTask ].uxBasePriority = pxTaskStatusArray[ uxTask ].uxCurrentPriority;
+            uxTask += 1;
+        }
+
+        if ( pulTotalRunTime != NULL )
+        {
+            *pulTotalRunTime = ulTotalRunTime;
+        }
+
+        return uxTask;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetInfo( TaskHandle_t xTask,
+                       TaskStatus_t * pxTaskStatus,
+                       BaseType_t xGetFreeStackSpace,
+                       eTaskState eState )
+    {
+        rt_thread_t thread = ( rt_thread_t ) prvGetTCBFromHandle( xTask );
+        rt_uint8_t current_priority;
+        rt_base_t level;
+
+        configASSERT( pxTaskStatus );
+
+        level = rt_hw_interrupt_disable();
+        if ( eState == eInvalid )
+        {
+            eState = prvTaskGetState( thread );
+        }
+        current_priority = thread->current_priority;
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        pxTaskStatus->ulRunTimeCounter = prvTaskGetRunTime( thread );
+    #else
+        pxTaskStatus->ulRunTimeCounter = 0;
+    #endif
+        rt_hw_interrupt_enable( level );
+
+        pxTaskStatus->xHandle = ( TaskHandle_t ) thread;
+        pxTaskStatus->pcTaskName = pcTaskGetName( ( TaskHandle_t ) thread );
+        pxTaskStatus->xTaskNumber = 0;
+        pxTaskStatus->eCurrentState = eState;
+        pxTaskStatus->uxCurrentPriority = RTTHREAD_PRIORITY_TO_FREERTOS( current_priority );
+        pxTaskStatus->uxBasePriority = pxTaskStatus->uxCurrentPriority;
+        pxTaskStatus->pxStackBase = ( StackType_t * ) thread->stack_addr;
+        if ( xGetFreeStackSpace != pdFALSE )
+        {
+            pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( thread );
+        }
+        else
+        {
+            pxTaskStatus->usStackHighWaterMark = 0;
+        }
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+/* Takes a snapshot into an array allocated from the heap, which the caller
+ * must free.  Returns NULL if the array could not be allocated. */
+    static TaskStatus_t * prvTaskGetSnapshot( UBaseType_t * puxTasks,
+                                              configRUN_TIME_COUNTER_TYPE * pulTotalRunTime )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize;
+
+        do
+        {
+            uxArraySize = uxTaskGetNumberOfTasks();
+            pxTaskStatusArray = pvPortMalloc( uxArraySize * sizeof( TaskStatus_t ) );
+            if ( pxTaskStatusArray == NULL )
+            {
+                return NULL;
+            }
+            *puxTasks = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, pulTotalRunTime );
+            if ( *puxTasks == 0 )
+            {
+                /* A thread was created after the tasks were counted */
+                vPortFree( pxTaskStatusArray );
+            }
+        } while ( *puxTasks == 0 );
+
+        return pxTaskStatusArray;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskList( char * pcWriteBuffer )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        char cStatus;
+
+        *pcWriteBuffer = ( char ) 0x00;
+
+        pxTaskStatusArray = prvTaskGetSnapshot( &uxArraySize, NULL );
+        if ( pxTaskStatusArray == NULL )
+        {
+            return;
+        }
+
+        for ( x = 0; x < uxArraySize; x++ )
+        {
+            switch ( pxTaskStatusArray[ x ].eCurrentState )
+            {
+                case eRunning:
+                    cStatus = tskRUNNING_CHAR;
+                    break;
+                case eReady:
+                    cStatus = tskREADY_CHAR;
+                    break;
+                case eBlocked:
+                    cStatus = tskBLOCKED_CHAR;
+                    break;
+                case eSuspended:
+                    cStatus = tskSUSPENDED_CHAR;
+                    break;
+                case eDeleted:
+                    cStatus = tskDELETED_CHAR;
+                    break;
+                case eInvalid:
+                default:
+                    cStatus = ( char ) 0x00;
+                    break;
+            }
+
+            pcWriteBuffer += rt_sprintf( pcWriteBuffer, "%-*.*s\t%c\t%u\t%u\t%u\r\n",
+                                         RT_NAME_MAX, RT_NAME_MAX, pxTaskStatusArray[ x ].pcTaskName, cStatus,
+                                         ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority,
+                                         ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark,
+                                         ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber );
+        }
+
+        vPortFree( pxTaskStatusArray );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetRunTimeStats( char * pcWriteBuffer )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
+
+        *pcWriteBuffer = ( char ) 0x00;
+
+        pxTaskStatusArray = prvTaskGetSnapshot( &uxArraySize, &ulTotalTime );
+        if ( pxTaskStatusArray == NULL )
+        {
+            return;
+        }
+
+        /* For percentage calculations */
+        ulTotalTime /= 100UL;
+
+        for ( x = 0; x < uxArraySize; x++ )
+        {
+            ulStatsAsPercentage = 0;
+            if ( ulTotalTime > 0UL )
+            {
+                ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+            }
+
+            if ( ulStatsAsPercentage > 0UL )
+            {
+                pcWriteBuffer += rt_sprintf( pcWriteBuffer, "%-*.*s\t%lu\t\t%lu%%\r\n",
+                                             RT_NAME_MAX, RT_NAME_MAX, pxTaskStatusArray[ x ].pcTaskName,
+                                             ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter,
+                                             ( unsigned long ) ulStatsAsPercentage );
+            }
+            else
+            {
+                /* Less than 1% of the total run time was spent in this task */
+                pcWriteBuffer += rt_sprintf( pcWriteBuffer, "%-*.*s\t%lu\t\t<1%%\r\n",
+                                             RT_NAME_MAX, RT_NAME_MAX, pxTaskStatusArray[ x ].pcTaskName,
+                                             ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
+            }
+        }
+
+        vPortFree( pxTaskStatusArray );
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 
 #ifdef ESP_PLATFORM
 BaseType_t xTaskGetAffinity( TaskHandle_t xTask )
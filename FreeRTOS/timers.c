@@ -80,6 +80,9 @@
                 pxNewTimer->pvTimerID = pvTimerID;
                 /* Mark as dynamic so we can distinguish when deleting */
                 ( ( rt_timer_t ) pxNewTimer )->parent.type &= ~RT_Object_Class_Static;
+                #if ( configUSE_NAME_INDEX == 1 )
+                    vTaskNameIndexInsert( ( ( rt_timer_t ) pxNewTimer )->parent.name, pxNewTimer, taskNAME_INDEX_TIMER );
+                #endif
             }
 
             return pxNewTimer;
@@ -127,6 +130,9 @@
                 }
                 rt_timer_init( ( rt_timer_t ) pxNewTimer, pcTimerName, ( rt_timer_callback_t ) pxCallbackFunction, pxNewTimer, xTimerPeriodInTicks, flag );
                 pxNewTimer->pvTimerID = pvTimerID;
+                #if ( configUSE_NAME_INDEX == 1 )
+                    vTaskNameIndexInsert( ( ( rt_timer_t ) pxNewTimer )->parent.name, pxNewTimer, taskNAME_INDEX_TIMER );
+                #endif
             }
 
             return pxNewTimer;
@@ -166,6 +172,9 @@
         }
         else if ( xCommandID == tmrCOMMAND_DELETE )
         {
+        #if ( configUSE_NAME_INDEX == 1 )
+            vTaskNameIndexRemove( ( ( rt_timer_t ) xTimer )->parent.name, xTimer, taskNAME_INDEX_TIMER );
+        #endif
         #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
             if ( rt_object_is_systemobject( ( rt_object_t ) xTimer ) )
         #endif
@@ -273,6 +282,47 @@
     }
 /*-----------------------------------------------------------*/
 
+    TimerHandle_t xTimerGetHandle( const char * pcTimerName )
+    {
+        TimerHandle_t xReturn = NULL;
+        rt_base_t level;
+        rt_timer_t timer;
+        struct rt_object_information *information;
+        struct rt_list_node *node = RT_NULL;
+
+    #if ( configUSE_NAME_INDEX == 1 )
+        void * pvHandle;
+
+        if ( xTaskNameIndexFind( pcTimerName, taskNAME_INDEX_TIMER, &pvHandle ) != pdFALSE )
+        {
+            return ( TimerHandle_t ) pvHandle;
+        }
+    #endif /* configUSE_NAME_INDEX */
+
+        information = rt_object_get_information( RT_Object_Class_Timer );
+        RT_ASSERT( information != RT_NULL );
+
+        level = rt_hw_interrupt_disable();
+
+        rt_list_for_each( node, &( information->object_list ) )
+        {
+            timer = ( rt_timer_t ) rt_list_entry( node, struct rt_object, list );
+            /* Only the timers created here pass themselves to their callback,
+             * which tells them apart from native timers and thread timers */
+            if ( ( timer->parameter == ( void * ) timer ) &&
+                 ( rt_strncmp( timer->parent.name, pcTimerName, RT_NAME_MAX ) == 0 ) )
+            {
+                xReturn = ( TimerHandle_t ) timer;
+                break;
+            }
+        }
+
+        rt_hw_interrupt_enable( level );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
     BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer )
     {
         BaseType_t xReturn;
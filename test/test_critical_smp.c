@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: critical section stress test
+ *
+ * This demo runs one task per core, each bound to its core on SMP builds,
+ * that enters and leaves taskENTER_CRITICAL sections as fast as it can and
+ * increments a shared counter inside them, every tenth time through a nested
+ * section. The counter must end up at exactly the number of sections entered,
+ * and the time taken gives the cost of a section under contention. On a
+ * single core build one task runs and the number is the uncontended cost.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define ITERATIONS            100000
+
+#ifdef RT_USING_SMP
+#define TASK_COUNT            RT_CPUS_NR
+#else
+#define TASK_COUNT            1
+#endif
+
+static volatile uint32_t counter;
+static volatile int tasks_ready;
+static volatile int tasks_done;
+
+static void vStressTask(void *pvParameters)
+{
+    uint32_t value;
+    int i;
+
+#ifdef RT_USING_SMP
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_BIND_CPU, pvParameters);
+#endif
+    /* Start together so that the cores contend from the first section */
+    taskENTER_CRITICAL();
+    tasks_ready++;
+    taskEXIT_CRITICAL();
+    while (tasks_ready < TASK_COUNT);
+
+    for (i = 0; i < ITERATIONS; i++)
+    {
+        taskENTER_CRITICAL();
+        if (i % 10 == 0)
+        {
+            taskENTER_CRITICAL();
+        }
+        /* A separate read and write, so a lost update shows in the total */
+        value = counter;
+        counter = value + 1;
+        if (i % 10 == 0)
+        {
+            taskEXIT_CRITICAL();
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    taskENTER_CRITICAL();
+    tasks_done++;
+    taskEXIT_CRITICAL();
+    vTaskDelete(NULL);
+}
+
+static void vReportTask(void *pvParameters)
+{
+    TickType_t xStart;
+    TickType_t xTicks;
+    uint32_t ns;
+
+    xStart = xTaskGetTickCount();
+    while (tasks_done < TASK_COUNT)
+    {
+        vTaskDelay(1);
+    }
+    xTicks = xTaskGetTickCount() - xStart;
+    /* Nanoseconds per section, kept in 32 bits */
+    ns = (uint32_t)((uint64_t)xTicks * (1000000000ULL / configTICK_RATE_HZ) / ((uint64_t)ITERATIONS * TASK_COUNT));
+    rt_kprintf("%d tasks, counter %d of %d, %d ticks, about %d ns per section\n",
+               TASK_COUNT, counter, ITERATIONS * TASK_COUNT, xTicks, ns);
+    vTaskDelete(NULL);
+}
+
+int critical_stress(void)
+{
+    int i;
+
+    counter = 0;
+    tasks_ready = 0;
+    tasks_done = 0;
+    for (i = 0; i < TASK_COUNT; i++)
+    {
+        xTaskCreate(vStressTask, "Stress", configMINIMAL_STACK_SIZE, (void *)(rt_ubase_t)i, TASK_PRIORITY, NULL);
+    }
+    xTaskCreate(vReportTask, "Report", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(critical_stress, critical section stress test);
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: deferred yield from ISR
+ *
+ * This demo creates a periodic hard timer whose handler gives a semaphore,
+ * sends to a queue and notifies a task, collecting xHigherPriorityTaskWoken
+ * from all three calls and switching context once with portYIELD_FROM_ISR.
+ * With configUSE_DEFERRED_ISR_YIELD set to 1 the three tasks are only made
+ * ready by the FromISR calls, and the handler reports whether it asked for a
+ * switch.
+ *
+ */
+
+#include <rtthread.h>
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <semphr.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define ROUND_COUNT           5
+
+static SemaphoreHandle_t xSemaphore = NULL;
+static QueueHandle_t xQueue = NULL;
+static TaskHandle_t xNotifyTask = NULL;
+static rt_timer_t timer1;
+static volatile uint32_t ulSwitches = 0;
+
+static void vSemaphoreTask(void *pvParameters)
+{
+    int i;
+
+    for (i = 0; i < ROUND_COUNT; i++)
+    {
+        xSemaphoreTake(xSemaphore, portMAX_DELAY);
+        rt_kprintf("Semaphore task woken\n");
+    }
+    vTaskDelete(NULL);
+}
+
+static void vQueueTask(void *pvParameters)
+{
+    uint32_t round;
+    int i;
+
+    for (i = 0; i < ROUND_COUNT; i++)
+    {
+        xQueueReceive(xQueue, &round, portMAX_DELAY);
+        rt_kprintf("Queue task received round %d\n", round);
+    }
+    vTaskDelete(NULL);
+}
+
+static void vNotifyTask(void *pvParameters)
+{
+    int i;
+
+    for (i = 0; i < ROUND_COUNT; i++)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        rt_kprintf("Notify task woken\n");
+    }
+    /* The notified task finishes last */
+    rt_timer_stop(timer1);
+    rt_timer_delete(timer1);
+    rt_kprintf("Timer handler requested %d context switches\n", ulSwitches);
+    vSemaphoreDelete(xSemaphore);
+    vQueueDelete(xQueue);
+    vTaskDelete(NULL);
+}
+
+static void timeout(void *parameter)
+{
+    static uint32_t round = 0;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if (round >= ROUND_COUNT)
+    {
+        return;
+    }
+    round++;
+    xSemaphoreGiveFromISR(xSemaphore, &xHigherPriorityTaskWoken);
+    xQueueSendFromISR(xQueue, &round, &xHigherPriorityTaskWoken);
+    vTaskNotifyGiveFromISR(xNotifyTask, &xHigherPriorityTaskWoken);
+    if (xHigherPriorityTaskWoken != pdFALSE)
+    {
+        ulSwitches++;
+    }
+    /* One context switch for the three wake ups */
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+int isr_yield(void)
+{
+    xSemaphore = xSemaphoreCreateBinary();
+    xQueue = xQueueCreate(ROUND_COUNT, sizeof(uint32_t));
+    if (xSemaphore == NULL || xQueue == NULL)
+    {
+        rt_kprintf("create semaphore or queue failed.\n");
+        return -1;
+    }
+    xTaskCreate(vSemaphoreTask, "SemTask", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+    xTaskCreate(vQueueTask, "QueueTask", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+    xTaskCreate(vNotifyTask, "NotifyTask", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &xNotifyTask);
+    /* Create a hard timer which wakes all three tasks every 100 ms */
+    timer1 = rt_timer_create("timer1", timeout, RT_NULL, rt_tick_from_millisecond(100), RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    if (timer1 != RT_NULL)
+    {
+        rt_timer_start(timer1);
+    }
+    return 0;
+}
+
+MSH_CMD_EXPORT(isr_yield, deferred yield from ISR sample);
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: lean mutex priority inheritance
+ *
+ * This demo shows a mutex created by xSemaphoreCreateMutex with
+ * configUSE_LEAN_MUTEXES set to 1. A low priority task takes the mutex, which
+ * is a single compare-and-swap, and is then preempted by a high priority task
+ * that blocks on it. The holder is raised to the waiter's priority until it
+ * gives the mutex back, so a medium priority task cannot delay the waiter.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+
+static SemaphoreHandle_t xMutex = NULL;
+
+static void vHighTask(void *pvParameters)
+{
+    vTaskDelay(pdMS_TO_TICKS(10));
+    rt_kprintf("High task waiting for the mutex\n");
+    xSemaphoreTake(xMutex, portMAX_DELAY);
+    rt_kprintf("High task took the mutex\n");
+    xSemaphoreGive(xMutex);
+    vTaskDelete(NULL);
+}
+
+static void vMediumTask(void *pvParameters)
+{
+    vTaskDelay(pdMS_TO_TICKS(20));
+    rt_kprintf("Medium task running\n");
+    vTaskDelete(NULL);
+}
+
+static void vLowTask(void *pvParameters)
+{
+    TickType_t xStart;
+
+    xSemaphoreTake(xMutex, portMAX_DELAY);
+    rt_kprintf("Low task took the mutex at priority %d\n", uxTaskPriorityGet(NULL));
+    /* Hold the mutex without blocking while the other tasks wake up */
+    xStart = xTaskGetTickCount();
+    while (xTaskGetTickCount() - xStart < pdMS_TO_TICKS(50));
+    rt_kprintf("Low task gives the mutex at priority %d\n", uxTaskPriorityGet(NULL));
+    xSemaphoreGive(xMutex);
+    rt_kprintf("Low task back at priority %d\n", uxTaskPriorityGet(NULL));
+    vSemaphoreDelete(xMutex);
+    vTaskDelete(NULL);
+}
+
+int mutex_lean(void)
+{
+    xMutex = xSemaphoreCreateMutex();
+    if (xMutex == NULL)
+    {
+        rt_kprintf("create mutex failed.\n");
+        return -1;
+    }
+    xTaskCreate(vLowTask, "Low", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+    xTaskCreate(vMediumTask, "Medium", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+    xTaskCreate(vHighTask, "High", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 2, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(mutex_lean, lean mutex priority inheritance sample);
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: mutex profiling
+ *
+ * This demo runs three workers against two mutexes. The bus mutex is held
+ * for a long time by one worker, so the others queue up behind it, while the
+ * log mutex is held only briefly. When the workers finish, the profile of each
+ * mutex is printed; run mutex_stats to list them by wait time, or
+ * mutex_stats Bus to see the histograms of the bus mutex.
+ * configUSE_MUTEX_PROFILING must be 1.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define WORKER_COUNT          3
+#define ROUND_COUNT           10
+
+#if ( configUSE_MUTEX_PROFILING == 1 )
+
+static SemaphoreHandle_t xBusMutex = NULL;
+static SemaphoreHandle_t xLogMutex = NULL;
+static SemaphoreHandle_t xDone = NULL;
+
+static void prvPrintProfile(const char *name, SemaphoreHandle_t xMutex)
+{
+    MutexProfile_t xProfile;
+
+    vSemaphoreGetMutexProfile(xMutex, &xProfile);
+    rt_kprintf("%s: %d takes, %d contended, max wait %d, max hold %d by %s\n",
+               name, xProfile.ulAcquisitions, xProfile.ulContended,
+               xProfile.ulMaxWait, xProfile.ulMaxHold, xProfile.pcMaxHoldTaskName);
+}
+
+static void vWorkerTask(void *pvParameters)
+{
+    int index = (int)(rt_ubase_t)pvParameters;
+    int i;
+
+    for (i = 0; i < ROUND_COUNT; i++)
+    {
+        xSemaphoreTake(xBusMutex, portMAX_DELAY);
+        /* Worker0 makes long transfers */
+        vTaskDelay(pdMS_TO_TICKS(index == 0 ? 20 : 2));
+        xSemaphoreGive(xBusMutex);
+
+        xSemaphoreTake(xLogMutex, portMAX_DELAY);
+        xSemaphoreGive(xLogMutex);
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    xSemaphoreGive(xDone);
+    vTaskDelete(NULL);
+}
+
+static void vReportTask(void *pvParameters)
+{
+    int i;
+
+    for (i = 0; i < WORKER_COUNT; i++)
+    {
+        xSemaphoreTake(xDone, portMAX_DELAY);
+    }
+    prvPrintProfile("Bus", xBusMutex);
+    prvPrintProfile("Log", xLogMutex);
+    vTaskDelete(NULL);
+}
+
+int mutex_profile(void)
+{
+    static const char *names[WORKER_COUNT] = {"Worker0", "Worker1", "Worker2"};
+    int i;
+
+    if (xBusMutex == NULL)
+    {
+        xBusMutex = xSemaphoreCreateMutex();
+        xLogMutex = xSemaphoreCreateMutex();
+        xDone = xSemaphoreCreateCounting(WORKER_COUNT, 0);
+        if (xBusMutex == NULL || xLogMutex == NULL || xDone == NULL)
+        {
+            rt_kprintf("create mutexes failed.\n");
+            return -1;
+        }
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        vQueueAddToRegistry(xBusMutex, "Bus");
+        vQueueAddToRegistry(xLogMutex, "Log");
+    #endif
+    }
+    /* The mutexes are kept so that mutex_stats can list them afterwards */
+    vSemaphoreResetMutexProfile(xBusMutex);
+    vSemaphoreResetMutexProfile(xLogMutex);
+    for (i = 0; i < WORKER_COUNT; i++)
+    {
+        xTaskCreate(vWorkerTask, names[i], configMINIMAL_STACK_SIZE, (void *)(rt_ubase_t)i, TASK_PRIORITY, NULL);
+    }
+    xTaskCreate(vReportTask, "Report", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(mutex_profile, mutex profiling sample);
+
+#endif /* ( configUSE_MUTEX_PROFILING == 1 ) */
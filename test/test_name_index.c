@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: name index
+ *
+ * This demo resolves tasks, a timer and a registered queue by name, as a
+ * request handler that only receives names would. A dispatcher looks each
+ * name up with xTaskGetHandle, xTimerGetHandle and xQueueGetHandle many times
+ * and prints how long it took. With configUSE_NAME_INDEX set to 1 the names
+ * are found in a hash index instead of by comparing every name.
+ * configQUEUE_REGISTRY_SIZE must be greater than 0.
+ *
+ */
+
+#include <rtthread.h>
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+#include <timers.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define WORKER_COUNT          4
+#define LOOKUP_COUNT          10000
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+static const char * const pcWorkerNames[WORKER_COUNT] = {"worker0", "worker1", "worker2", "worker3"};
+static TaskHandle_t xWorkers[WORKER_COUNT];
+static TimerHandle_t xTimer = NULL;
+static QueueHandle_t xQueue = NULL;
+
+static void vWorkerTask(void *pvParameters)
+{
+    for (;;)
+    {
+        vTaskDelay(portMAX_DELAY);
+    }
+}
+
+static void vTimerCallback(TimerHandle_t xTimer)
+{
+}
+
+static void vDispatchTask(void *pvParameters)
+{
+    TickType_t xStart;
+    int i, found = 0;
+
+    xStart = xTaskGetTickCount();
+    for (i = 0; i < LOOKUP_COUNT; i++)
+    {
+        if (xTaskGetHandle(pcWorkerNames[i % WORKER_COUNT]) == xWorkers[i % WORKER_COUNT])
+        {
+            found++;
+        }
+        if (xTimerGetHandle("watchdog") == xTimer)
+        {
+            found++;
+        }
+        if (xQueueGetHandle("requests") == xQueue)
+        {
+            found++;
+        }
+    }
+    rt_kprintf("%d of %d lookups found in %d ticks\n", found, 3 * LOOKUP_COUNT, xTaskGetTickCount() - xStart);
+    rt_kprintf("Unknown name gives %s\n", xTaskGetHandle("nobody") == NULL ? "NULL" : "a task");
+
+    for (i = 0; i < WORKER_COUNT; i++)
+    {
+        if (xWorkers[i] != NULL)
+        {
+            vTaskDelete(xWorkers[i]);
+        }
+    }
+    xTimerDelete(xTimer, 0);
+    vQueueDelete(xQueue);
+    rt_kprintf("Deleted timer gives %s\n", xTimerGetHandle("watchdog") == NULL ? "NULL" : "a timer");
+    vTaskDelete(NULL);
+}
+
+int name_index(void)
+{
+    int i;
+
+    xTimer = xTimerCreate("watchdog", pdMS_TO_TICKS(1000), pdTRUE, NULL, vTimerCallback);
+    xQueue = xQueueCreate(4, sizeof(uint32_t));
+    if (xTimer == NULL || xQueue == NULL)
+    {
+        rt_kprintf("create timer or queue failed.\n");
+        return -1;
+    }
+    /* The registry keeps the pointer, so the name must not live on the stack */
+    vQueueAddToRegistry(xQueue, "requests");
+    for (i = 0; i < WORKER_COUNT; i++)
+    {
+        xWorkers[i] = NULL;
+        xTaskCreate(vWorkerTask, pcWorkerNames[i], configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &xWorkers[i]);
+    }
+    xTaskCreate(vDispatchTask, "Dispatch", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(name_index, name index sample);
+
+#endif /* configQUEUE_REGISTRY_SIZE > 0 */
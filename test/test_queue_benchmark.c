@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: queue and semaphore benchmark
+ *
+ * This demo times uncontended semaphore give/take, mutex take/give and queue
+ * send/receive pairs. Nothing ever blocks, so the numbers are the cost of the
+ * calls themselves. Run it on two builds to compare them.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <semphr.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define ITERATIONS            100000
+
+static SemaphoreHandle_t xSemaphore = NULL;
+static SemaphoreHandle_t xMutex = NULL;
+static QueueHandle_t xQueue = NULL;
+
+static void prvReport(const char *name, TickType_t xTicks)
+{
+    /* Nanoseconds per pair, kept in 32 bits */
+    uint32_t ns = (uint32_t) ((uint64_t) xTicks * (1000000000ULL / configTICK_RATE_HZ) / ITERATIONS);
+
+    rt_kprintf("%-10s %d pairs in %d ticks, %d ns per pair\n", name, ITERATIONS, xTicks, ns);
+}
+
+static void vBenchmarkTask(void *pvParameters)
+{
+    uint32_t num = 0;
+    TickType_t xStart;
+    int i;
+
+    /* Start on a tick boundary */
+    vTaskDelay(1);
+    xStart = xTaskGetTickCount();
+    for (i = 0; i < ITERATIONS; i++)
+    {
+        xSemaphoreGive(xSemaphore);
+        xSemaphoreTake(xSemaphore, 0);
+    }
+    prvReport("semaphore", xTaskGetTickCount() - xStart);
+
+    vTaskDelay(1);
+    xStart = xTaskGetTickCount();
+    for (i = 0; i < ITERATIONS; i++)
+    {
+        xSemaphoreTake(xMutex, 0);
+        xSemaphoreGive(xMutex);
+    }
+    prvReport("mutex", xTaskGetTickCount() - xStart);
+
+    vTaskDelay(1);
+    xStart = xTaskGetTickCount();
+    for (i = 0; i < ITERATIONS; i++)
+    {
+        xQueueSend(xQueue, &num, 0);
+        xQueueReceive(xQueue, &num, 0);
+    }
+    prvReport("queue", xTaskGetTickCount() - xStart);
+
+    vSemaphoreDelete(xSemaphore);
+    vSemaphoreDelete(xMutex);
+    vQueueDelete(xQueue);
+    vTaskDelete(NULL);
+}
+
+int queue_benchmark(void)
+{
+    xSemaphore = xSemaphoreCreateBinary();
+    xMutex = xSemaphoreCreateMutex();
+    xQueue = xQueueCreate(1, sizeof(uint32_t));
+    if (xSemaphore == NULL || xMutex == NULL || xQueue == NULL)
+    {
+        rt_kprintf("create benchmark objects failed.\n");
+        return -1;
+    }
+    xTaskCreate(vBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_benchmark, queue and semaphore benchmark);
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: broadcast queue
+ *
+ * This demo fans one stream of samples out to three consumers through a
+ * queue created by xQueueCreateBroadcast. Each consumer subscribes and
+ * receives every sample with xQueueReceive at its own pace. The queue drops
+ * the oldest sample of a consumer that falls too far behind, so the slow
+ * consumer skips samples while the producer and the fast consumers carry on.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          4
+#define SAMPLE_COUNT          20
+#define CONSUMER_COUNT        3
+
+static QueueHandle_t xFeed = NULL;
+static QueueHandle_t xSubscribers[CONSUMER_COUNT];
+
+static void vProducerTask(void *pvParameters)
+{
+    uint32_t num;
+
+    for (num = 0; num < SAMPLE_COUNT; num++)
+    {
+        xQueueSend(xFeed, &num, portMAX_DELAY);
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    vTaskDelete(NULL);
+}
+
+static void vConsumerTask(void *pvParameters)
+{
+    int index = (int)(rt_ubase_t)pvParameters;
+    uint32_t num = 0;
+    int received = 0;
+
+    /* The last consumer is too slow to keep up */
+    while (num < SAMPLE_COUNT - 1)
+    {
+        if (xQueueReceive(xSubscribers[index], &num, pdMS_TO_TICKS(500)) != pdPASS)
+        {
+            break;
+        }
+        received++;
+        if (index == CONSUMER_COUNT - 1)
+        {
+            vTaskDelay(pdMS_TO_TICKS(30));
+        }
+    }
+    rt_kprintf("Consumer %d received %d of %d samples\n", index, received, SAMPLE_COUNT);
+    vTaskDelete(NULL);
+}
+
+static void vCleanupTask(void *pvParameters)
+{
+    int i;
+
+    vTaskDelay(pdMS_TO_TICKS(2000));
+    for (i = 0; i < CONSUMER_COUNT; i++)
+    {
+        vQueueDelete(xSubscribers[i]);
+    }
+    vQueueDelete(xFeed);
+    vTaskDelete(NULL);
+}
+
+int queue_broadcast(void)
+{
+    int i;
+
+    xFeed = xQueueCreateBroadcast(QUEUE_LENGTH, sizeof(uint32_t), queueBROADCAST_DROP_OLDEST);
+    if (xFeed == NULL)
+    {
+        rt_kprintf("create broadcast queue failed.\n");
+        return -1;
+    }
+    /* Subscribe before the producer starts so that no sample is missed */
+    for (i = 0; i < CONSUMER_COUNT; i++)
+    {
+        xSubscribers[i] = xQueueSubscribe(xFeed);
+        if (xSubscribers[i] == NULL)
+        {
+            rt_kprintf("subscribe failed.\n");
+            return -1;
+        }
+        xTaskCreate(vConsumerTask, "Consumer", configMINIMAL_STACK_SIZE, (void *)(rt_ubase_t)i, TASK_PRIORITY + 1, NULL);
+    }
+    xTaskCreate(vProducerTask, "Producer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+    xTaskCreate(vCleanupTask, "Cleanup", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_broadcast, broadcast queue sample);
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: mailbox
+ * This demo creates a periodic hard timer which publishes a battery level to a
+ * mailbox with xQueueOverwriteFromISR. Two threads read the latest value with
+ * xQueuePeek at different rates
+ *
+ */
+
+#include <rtthread.h>
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define READ_COUNT            10
+#define FAST_PERIOD           pdMS_TO_TICKS(20)
+#define SLOW_PERIOD           pdMS_TO_TICKS(100)
+
+struct battery
+{
+    uint32_t millivolts;
+    uint32_t sample;
+};
+
+static QueueHandle_t xMailbox = NULL;
+static rt_timer_t timer1;
+
+static void vReaderTask(void *pvParameters)
+{
+    TickType_t xPeriod = (TickType_t) (rt_ubase_t) pvParameters;
+    struct battery level;
+    int i;
+
+    for (i = 0; i < READ_COUNT; i++)
+    {
+        /* Blocks only until the first value has been published */
+        if (xQueuePeek(xMailbox, &level, portMAX_DELAY) == pdPASS)
+        {
+            rt_kprintf("%s read sample %d: %d mV\n", pcTaskGetName(NULL), level.sample, level.millivolts);
+        }
+        vTaskDelay(xPeriod);
+    }
+    if (xPeriod == SLOW_PERIOD)
+    {
+        /* The slow reader finishes last */
+        rt_timer_stop(timer1);
+        rt_timer_delete(timer1);
+        vQueueDelete(xMailbox);
+    }
+    vTaskDelete(NULL);
+}
+
+static void timeout(void *parameter)
+{
+    static struct battery level = { 4200, 0 };
+
+    level.millivolts -= 1;
+    level.sample += 1;
+    xQueueOverwriteFromISR(xMailbox, &level, NULL);
+}
+
+int queue_mailbox(void)
+{
+    xMailbox = xQueueCreateMailbox(sizeof(struct battery));
+    if (xMailbox == NULL)
+    {
+        rt_kprintf("create mailbox failed.\n");
+        return -1;
+    }
+    xTaskCreate(vReaderTask, "Fast", configMINIMAL_STACK_SIZE, (void *) (rt_ubase_t) FAST_PERIOD, TASK_PRIORITY + 1, NULL);
+    xTaskCreate(vReaderTask, "Slow", configMINIMAL_STACK_SIZE, (void *) (rt_ubase_t) SLOW_PERIOD, TASK_PRIORITY, NULL);
+    /* Create a hard timer which publishes every tick */
+    timer1 = rt_timer_create("timer1", timeout, RT_NULL, 1, RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    if (timer1 != RT_NULL)
+    {
+        rt_timer_start(timer1);
+    }
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_mailbox, mailbox sample);
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: batched queue send and receive
+ *
+ * This demo demonstrates a producer posting log records in blocks with
+ * xQueueSendMultiple and a consumer draining them with xQueueReceiveMultiple,
+ * waking once per batch instead of once per record.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          32
+#define BLOCK_SIZE            12
+#define RECORD_COUNT          120
+
+struct log_record
+{
+    uint32_t id;
+    TickType_t tick;
+};
+
+/* queue handler */
+static QueueHandle_t xQueue = NULL;
+
+static void vProducerTask(void *pvParameters)
+{
+    static struct log_record records[BLOCK_SIZE];
+    UBaseType_t uxSent;
+    uint32_t id = 0;
+    int i;
+
+    while (id < RECORD_COUNT)
+    {
+        for (i = 0; i < BLOCK_SIZE; i++)
+        {
+            records[i].id = id + i;
+            records[i].tick = xTaskGetTickCount();
+        }
+        /* Keep posting until the whole block is queued */
+        uxSent = 0;
+        while (uxSent < BLOCK_SIZE)
+        {
+            uxSent += xQueueSendMultiple(xQueue, &records[uxSent], BLOCK_SIZE - uxSent, portMAX_DELAY);
+        }
+        id += BLOCK_SIZE;
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    vTaskDelete(NULL);
+}
+
+static void vConsumerTask(void *pvParameters)
+{
+    static struct log_record records[QUEUE_LENGTH];
+    UBaseType_t uxCount;
+    UBaseType_t i;
+    uint32_t expected = 0;
+    uint32_t batches = 0;
+
+    while (expected < RECORD_COUNT)
+    {
+        uxCount = xQueueReceiveMultiple(xQueue, records, QUEUE_LENGTH, portMAX_DELAY);
+        for (i = 0; i < uxCount; i++)
+        {
+            if (records[i].id != expected)
+            {
+                rt_kprintf("Consumer expected record %d, got %d\n", expected, records[i].id);
+            }
+            expected = records[i].id + 1;
+        }
+        batches++;
+        /* Process slowly so that records pile up between wake ups */
+        vTaskDelay(pdMS_TO_TICKS(20));
+    }
+    rt_kprintf("Consumer received %d records in %d batches\n", expected, batches);
+    vQueueDelete(xQueue);
+    vTaskDelete(NULL);
+}
+
+int queue_multiple(void)
+{
+    /* Create a queue dynamically */
+    xQueue = xQueueCreate(QUEUE_LENGTH, sizeof(struct log_record));
+    if (xQueue == NULL)
+    {
+        rt_kprintf("create dynamic queue failed.\n");
+        return -1;
+    }
+    xTaskCreate(vConsumerTask, "Consumer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+    xTaskCreate(vProducerTask, "Producer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_multiple, batched queue send and receive sample);
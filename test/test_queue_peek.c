@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: queue peek
+ *
+ * This demo demonstrates two tasks blocking in xQueuePeek and one in xQueueReceive
+ * on an empty queue. Every item sent wakes all three: the peekers see it without
+ * removing it, then the receiver takes it.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          4
+#define ITEM_SIZE             sizeof( uint32_t )
+#define ITEM_COUNT            5
+
+/* queue handler */
+static QueueHandle_t xQueue = NULL;
+
+static void vPeekTask(void *pvParameters)
+{
+    uint32_t num = 0;
+    uint32_t last = 0;
+    while (last < ITEM_COUNT)
+    {
+        if (xQueuePeek(xQueue, &num, portMAX_DELAY) != pdPASS)
+        {
+            rt_kprintf("%s peek from queue failed\n", pcTaskGetName(NULL));
+            continue;
+        }
+        if (num != last)
+        {
+            rt_kprintf("%s peek data %d, %d items still queued\n", pcTaskGetName(NULL), num, uxQueueMessagesWaiting(xQueue));
+            last = num;
+        }
+        /* Let the receiver take the item before peeking again */
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    vTaskDelete(NULL);
+}
+
+static void vReceiveTask(void *pvParameters)
+{
+    uint32_t num = 0;
+    while (num < ITEM_COUNT)
+    {
+        if (xQueueReceive(xQueue, &num, portMAX_DELAY) == pdPASS)
+        {
+            rt_kprintf("Receiver receive data %d from queue\n", num);
+        }
+    }
+    vTaskDelete(NULL);
+}
+
+static void vSendTask(void *pvParameters)
+{
+    uint32_t num;
+    for (num = 1; num <= ITEM_COUNT; num++)
+    {
+        vTaskDelay(pdMS_TO_TICKS(100));
+        xQueueSendToBack(xQueue, &num, 0);
+    }
+    vTaskDelete(NULL);
+}
+
+int queue_peek(void)
+{
+    /* Create a queue dynamically */
+    xQueue = xQueueCreate(QUEUE_LENGTH, ITEM_SIZE);
+    if (xQueue == NULL)
+    {
+        rt_kprintf("create dynamic queue failed.\n");
+        return -1;
+    }
+    /* Peekers run first so that they are ahead of the receiver when an item arrives */
+    xTaskCreate(vPeekTask, "Peek1", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 2, NULL);
+    xTaskCreate(vPeekTask, "Peek2", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 2, NULL);
+    xTaskCreate(vReceiveTask, "Recv", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+    xTaskCreate(vSendTask, "Send", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_peek, queue peek sample);
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: per-session queues and semaphores
+ *
+ * This demo mimics a connection handler that creates a queue and a semaphore
+ * for every session and deletes them when the session ends. Each object is a
+ * single allocation; with configQUEUE_POOL_BLOCK_COUNT greater than 0 both are
+ * taken from the object pool and the heap is left untouched.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <semphr.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          4
+#define SESSION_COUNT         1000
+
+static void vSessionTask(void *pvParameters)
+{
+    SemaphoreHandle_t xSemaphore;
+    QueueHandle_t xQueue;
+    uint32_t num;
+    TickType_t xStart;
+    int i;
+
+    xStart = xTaskGetTickCount();
+    for (i = 0; i < SESSION_COUNT; i++)
+    {
+        xQueue = xQueueCreate(QUEUE_LENGTH, sizeof(uint32_t));
+        xSemaphore = xSemaphoreCreateBinary();
+        if (xQueue == NULL || xSemaphore == NULL)
+        {
+            rt_kprintf("Session %d: create failed.\n", i);
+            break;
+        }
+        num = i;
+        xQueueSend(xQueue, &num, 0);
+        xSemaphoreGive(xSemaphore);
+        xQueueReceive(xQueue, &num, 0);
+        xSemaphoreTake(xSemaphore, 0);
+        vSemaphoreDelete(xSemaphore);
+        vQueueDelete(xQueue);
+    }
+    rt_kprintf("%d sessions in %d ticks\n", i, xTaskGetTickCount() - xStart);
+    vTaskDelete(NULL);
+}
+
+int queue_pool(void)
+{
+    xTaskCreate(vSessionTask, "Session", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_pool, per-session queue and semaphore sample);
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: priority queue
+ *
+ * This demo multiplexes bulk and control messages on one consumer through a
+ * queue created by xQueueCreatePriority. A producer fills the queue with bulk
+ * messages, then a timer sends a control message from its handler. The
+ * consumer receives the control message before the bulk messages that were
+ * queued ahead of it.
+ *
+ */
+
+#include <rtthread.h>
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          16
+#define BULK_COUNT            10
+#define PRIORITY_BULK         0
+#define PRIORITY_CONTROL      1
+#define PRIORITY_LEVELS       2
+
+struct message
+{
+    uint8_t type;
+    uint32_t id;
+};
+
+static QueueHandle_t xQueue = NULL;
+static rt_timer_t timer1;
+
+static void vProducerTask(void *pvParameters)
+{
+    struct message msg = {PRIORITY_BULK, 0};
+
+    for (msg.id = 0; msg.id < BULK_COUNT; msg.id++)
+    {
+        xQueueSendWithPriority(xQueue, &msg, PRIORITY_BULK, portMAX_DELAY);
+    }
+    /* The control message arrives while the bulk messages are still queued */
+    rt_timer_start(timer1);
+    vTaskDelete(NULL);
+}
+
+static void vConsumerTask(void *pvParameters)
+{
+    struct message msg;
+    int i;
+
+    /* Let the queue fill up first */
+    vTaskDelay(pdMS_TO_TICKS(100));
+    for (i = 0; i < BULK_COUNT + 1; i++)
+    {
+        xQueueReceive(xQueue, &msg, portMAX_DELAY);
+        rt_kprintf("Received %s message %d\n", msg.type == PRIORITY_CONTROL ? "control" : "bulk", msg.id);
+    }
+    rt_timer_delete(timer1);
+    vQueueDelete(xQueue);
+    vTaskDelete(NULL);
+}
+
+static void timeout(void *parameter)
+{
+    struct message msg = {PRIORITY_CONTROL, 0};
+
+    xQueueSendWithPriorityFromISR(xQueue, &msg, PRIORITY_CONTROL, NULL);
+}
+
+int queue_priority(void)
+{
+    xQueue = xQueueCreatePriority(QUEUE_LENGTH, sizeof(struct message), PRIORITY_LEVELS);
+    timer1 = rt_timer_create("timer1", timeout, RT_NULL, rt_tick_from_millisecond(10), RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+    if (xQueue == NULL || timer1 == RT_NULL)
+    {
+        rt_kprintf("create priority queue or timer failed.\n");
+        return -1;
+    }
+    xTaskCreate(vConsumerTask, "Consumer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+    xTaskCreate(vProducerTask, "Producer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_priority, priority queue sample);
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: queue registry and statistics
+ *
+ * This demo registers two queues under readable names. A fast producer feeds
+ * a slow consumer through the first one, which fills up and blocks the
+ * producer, while the second one is lightly used. When both tasks finish, the
+ * counters of each queue are printed; run queue_stats to see them sorted by
+ * contention. configQUEUE_REGISTRY_SIZE must be greater than 0 and
+ * configUSE_QUEUE_STATISTICS must be 1.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          4
+#define ITEM_COUNT            20
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATISTICS == 1 )
+
+static QueueHandle_t xWorkQueue = NULL;
+static QueueHandle_t xLogQueue = NULL;
+
+static void prvPrintStatistics(QueueHandle_t xQueue)
+{
+    QueueStatistics_t xStatistics;
+
+    vQueueGetStatistics(xQueue, &xStatistics);
+    rt_kprintf("%s: %d sent, %d received, %d sends and %d receives blocked for %d ticks, peak %d\n",
+               pcQueueGetName(xQueue), xStatistics.ulSends, xStatistics.ulReceives,
+               xStatistics.ulSendsBlocked, xStatistics.ulReceivesBlocked,
+               xStatistics.xBlockedTicks, xStatistics.uxPeakMessages);
+}
+
+static void vProducerTask(void *pvParameters)
+{
+    uint32_t num;
+
+    for (num = 0; num < ITEM_COUNT; num++)
+    {
+        /* Blocks whenever the consumer falls behind */
+        xQueueSend(xWorkQueue, &num, portMAX_DELAY);
+        if (num % 5 == 0)
+        {
+            xQueueSend(xLogQueue, &num, 0);
+        }
+    }
+    vTaskDelete(NULL);
+}
+
+static void vConsumerTask(void *pvParameters)
+{
+    uint32_t num;
+    int i;
+
+    for (i = 0; i < ITEM_COUNT; i++)
+    {
+        xQueueReceive(xWorkQueue, &num, portMAX_DELAY);
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    while (xQueueReceive(xLogQueue, &num, 0) == pdPASS)
+    {
+        rt_kprintf("Log entry %d\n", num);
+    }
+    prvPrintStatistics(xWorkQueue);
+    prvPrintStatistics(xLogQueue);
+    vQueueDelete(xWorkQueue);
+    vQueueDelete(xLogQueue);
+    vTaskDelete(NULL);
+}
+
+int queue_registry(void)
+{
+    xWorkQueue = xQueueCreate(QUEUE_LENGTH, sizeof(uint32_t));
+    xLogQueue = xQueueCreate(ITEM_COUNT, sizeof(uint32_t));
+    if (xWorkQueue == NULL || xLogQueue == NULL)
+    {
+        rt_kprintf("create queues failed.\n");
+        return -1;
+    }
+    /* The registry keeps the pointer, so the names must not live on the stack */
+    vQueueAddToRegistry(xWorkQueue, "WorkQueue");
+    vQueueAddToRegistry(xLogQueue, "LogQueue");
+    xTaskCreate(vConsumerTask, "Consumer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+    xTaskCreate(vProducerTask, "Producer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_registry, queue registry and statistics sample);
+
+#endif /* ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_QUEUE_STATISTICS == 1 ) */
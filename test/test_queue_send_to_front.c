@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: queue send to front
+ *
+ * This demo demonstrates a task blocking in xQueueSendToFront until a slow consumer
+ * frees space in a full queue, and the time out when nobody does.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          2
+#define ITEM_SIZE             sizeof( uint32_t )
+
+/* queue handler */
+static QueueHandle_t xQueue = NULL;
+static TaskHandle_t TaskHandle1 = NULL;
+static TaskHandle_t TaskHandle2 = NULL;
+
+static void vTask1Code(void *pvParameters)
+{
+    uint32_t num = 0;
+    while (1)
+    {
+        /* Consume slowly so that the queue stays full */
+        vTaskDelay(pdMS_TO_TICKS(100));
+        if (xQueueReceive(xQueue, &num, portMAX_DELAY) == pdPASS)
+        {
+            rt_kprintf("Task 1 receive data %d from queue\n", num);
+        }
+        if (num >= 9)
+        {
+            return;
+        }
+    }
+}
+
+static void vTask2Code(void * pvParameters)
+{
+    BaseType_t xReturn;
+    uint32_t num = 0;
+    TickType_t xStart;
+
+    for (num = 0; num < 10; num++)
+    {
+        xStart = xTaskGetTickCount();
+        xReturn = xQueueSendToFront(xQueue, &num, portMAX_DELAY);
+        if (xReturn != pdPASS)
+        {
+            rt_kprintf("Task 2 send to queue failed\n");
+        }
+        else
+        {
+            rt_kprintf("Task 2 send data %d after blocking %d ticks\n", num, xTaskGetTickCount() - xStart);
+        }
+    }
+
+    /* Nobody receives any more: the queue fills up and the send times out */
+    num = 0;
+    while (xQueueSendToFront(xQueue, &num, pdMS_TO_TICKS(50)) == pdPASS);
+    rt_kprintf("Task 2 send timed out on a full queue\n");
+    vQueueDelete(xQueue);
+}
+
+int queue_send_to_front(void)
+{
+    /* Create a queue dynamically */
+    xQueue = xQueueCreate(QUEUE_LENGTH, ITEM_SIZE);
+    if (xQueue == NULL)
+    {
+        rt_kprintf("create dynamic queue failed.\n");
+        return -1;
+    }
+    xTaskCreate( vTask1Code, "Task1", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &TaskHandle1 );
+    if (TaskHandle1 == NULL)
+    {
+        rt_kprintf("Create task 1 failed\n");
+        return -1;
+    }
+    xTaskCreate( vTask2Code, "Task2", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, &TaskHandle2 );
+    if (TaskHandle2 == NULL)
+    {
+        rt_kprintf("Create task 2 failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_send_to_front, queue send to front sample);
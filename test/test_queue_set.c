@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: queue set
+ *
+ * This demo adds a queue, a binary semaphore and a held mutex to one queue set.
+ * A single task blocks in xQueueSelectFromSet and reads whichever member becomes
+ * ready, until the producer releases the mutex. configUSE_QUEUE_SETS must be 1.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <semphr.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          4
+#define ITEM_SIZE             sizeof( uint32_t )
+/* One event for every queue item, the binary semaphore and the mutex */
+#define SET_LENGTH            (QUEUE_LENGTH + 1 + 1)
+#define ROUND_COUNT           3
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+static QueueHandle_t xQueue = NULL;
+static SemaphoreHandle_t xSemaphore = NULL;
+static SemaphoreHandle_t xMutex = NULL;
+static QueueSetHandle_t xQueueSet = NULL;
+
+static void vSelectTask(void *pvParameters)
+{
+    QueueSetMemberHandle_t xActivated;
+    uint32_t num;
+
+    while (1)
+    {
+        xActivated = xQueueSelectFromSet(xQueueSet, pdMS_TO_TICKS(500));
+        if (xActivated == NULL)
+        {
+            rt_kprintf("Select timed out\n");
+            break;
+        }
+        if (xActivated == (QueueSetMemberHandle_t) xQueue)
+        {
+            xQueueReceive(xQueue, &num, 0);
+            rt_kprintf("Select: queue data %d\n", num);
+        }
+        else if (xActivated == (QueueSetMemberHandle_t) xSemaphore)
+        {
+            xSemaphoreTake(xSemaphore, 0);
+            rt_kprintf("Select: semaphore given\n");
+        }
+        else if (xActivated == (QueueSetMemberHandle_t) xMutex)
+        {
+            /* The producer released the mutex: all work is done */
+            xSemaphoreTake(xMutex, 0);
+            rt_kprintf("Select: mutex released\n");
+            break;
+        }
+    }
+
+    xQueueRemoveFromSet(xQueue, xQueueSet);
+    xQueueRemoveFromSet(xSemaphore, xQueueSet);
+    xQueueRemoveFromSet(xMutex, xQueueSet);
+    xSemaphoreGive(xMutex);
+    vQueueDelete(xQueueSet);
+    vQueueDelete(xQueue);
+    vSemaphoreDelete(xSemaphore);
+    vSemaphoreDelete(xMutex);
+    vTaskDelete(NULL);
+}
+
+static void vGiveTask(void *pvParameters)
+{
+    uint32_t num = 0;
+    int i;
+
+    /* The mutex is held when it is added to the set */
+    xSemaphoreTake(xMutex, portMAX_DELAY);
+    xQueueAddToSet(xMutex, xQueueSet);
+    for (i = 0; i < ROUND_COUNT; i++)
+    {
+        vTaskDelay(pdMS_TO_TICKS(100));
+        num++;
+        xQueueSendToBack(xQueue, &num, 0);
+        num++;
+        xQueueSendToBack(xQueue, &num, 0);
+        xSemaphoreGive(xSemaphore);
+    }
+    /* Posts the mutex to the set now that it has no owner */
+    xSemaphoreGive(xMutex);
+    vTaskDelete(NULL);
+}
+
+int queue_set(void)
+{
+    xQueueSet = xQueueCreateSet(SET_LENGTH);
+    xQueue = xQueueCreate(QUEUE_LENGTH, ITEM_SIZE);
+    xSemaphore = xSemaphoreCreateBinary();
+    xMutex = xSemaphoreCreateMutex();
+    if (xQueueSet == NULL || xQueue == NULL || xSemaphore == NULL || xMutex == NULL)
+    {
+        rt_kprintf("create queue set failed.\n");
+        return -1;
+    }
+    /* Members must be empty when they are added */
+    xQueueAddToSet(xQueue, xQueueSet);
+    xQueueAddToSet(xSemaphore, xQueueSet);
+
+    xTaskCreate(vSelectTask, "Select", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+    xTaskCreate(vGiveTask, "Give", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_set, queue set sample);
+
+#endif /* configUSE_QUEUE_SETS */
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: single producer, single consumer queue
+ * This demo creates a periodic hard timer which streams samples to an SPSC queue,
+ * the way an ADC ISR would. A thread blocks to receive from the queue
+ *
+ */
+
+#include <rtthread.h>
+#include <FreeRTOS.h>
+#include <queue.h>
+
+#define THREAD_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define THREAD_TIMESLICE        5
+#define QUEUE_LENGTH            16
+#define ITEM_SIZE               sizeof( uint16_t )
+#define SAMPLE_COUNT            200
+
+static QueueHandle_t xQueue = NULL;
+static StaticQueue_t xQueueBuffer;
+/* No per message overhead: QUEUE_LENGTH * ITEM_SIZE is enough */
+static uint8_t ucQueueStorage[ QUEUE_LENGTH * ITEM_SIZE ];
+static rt_timer_t timer1;
+
+#ifdef rt_align
+rt_align(RT_ALIGN_SIZE)
+#else
+ALIGN(RT_ALIGN_SIZE)
+#endif
+static char thread1_stack[1024];
+static struct rt_thread thread1;
+static void rt_thread1_entry(void *parameter)
+{
+    uint16_t expected = 0;
+    uint16_t sample = 0;
+    uint32_t lost = 0;
+
+    while (expected < SAMPLE_COUNT)
+    {
+        /* The last samples may have been dropped, so the stream can end early */
+        if (xQueueReceive(xQueue, &sample, pdMS_TO_TICKS(100)) != pdPASS)
+        {
+            rt_kprintf("Task 1 timed out waiting for sample %d\n", expected);
+            break;
+        }
+        /* Samples the timer could not queue are skipped, never reordered */
+        lost += sample - expected;
+        expected = sample + 1;
+    }
+    lost += SAMPLE_COUNT - expected;
+    rt_timer_stop(timer1);
+    rt_timer_delete(timer1);
+    rt_kprintf("Task 1 received %d samples, %d dropped, %d still queued\n",
+               SAMPLE_COUNT - lost, lost, uxQueueMessagesWaiting(xQueue));
+    vQueueDelete(xQueue);
+}
+
+static void timeout(void *parameter)
+{
+    static uint16_t sample = 0;
+
+    if (sample < SAMPLE_COUNT)
+    {
+        /* Only wakes the thread when the queue was empty */
+        xQueueSendToBackFromISR(xQueue, &sample, NULL);
+        sample += 1;
+    }
+}
+
+int queue_spsc()
+{
+    xQueue = xQueueCreateSPSCStatic(QUEUE_LENGTH, ITEM_SIZE, ucQueueStorage, &xQueueBuffer);
+    if (xQueue == NULL)
+    {
+        rt_kprintf("create spsc queue failed.\n");
+        return -1;
+    }
+    rt_thread_init(&thread1,
+                   "thread1",
+                   rt_thread1_entry,
+                   RT_NULL,
+                   &thread1_stack[0],
+                   sizeof(thread1_stack),
+                   THREAD_PRIORITY, THREAD_TIMESLICE);
+    rt_thread_startup(&thread1);
+    /* Create a hard timer which fires every tick */
+    timer1 = rt_timer_create("timer1", timeout, RT_NULL, 1, RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+    if (timer1 != RT_NULL)
+    {
+        rt_timer_start(timer1);
+    }
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_spsc, spsc queue sample);
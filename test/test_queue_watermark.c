@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: queue watermarks
+ *
+ * This demo throttles a fast producer before the queue it feeds is full. The
+ * producer asks to be notified when the queue reaches its high mark and when
+ * it drains back to its low mark. It sends without blocking while the queue
+ * is below the high mark, and pauses until the slow consumer has caught up
+ * once it is reached. configUSE_QUEUE_WATERMARKS must be 1.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          10
+#define HIGH_MARK             8
+#define LOW_MARK              2
+#define ITEM_COUNT            30
+
+#if ( configUSE_QUEUE_WATERMARKS == 1 )
+
+static QueueHandle_t xQueue = NULL;
+
+static void vProducerTask(void *pvParameters)
+{
+    uint32_t ulBits;
+    uint32_t num;
+
+    xQueueSetWatermarkNotify(xQueue, HIGH_MARK, LOW_MARK, xTaskGetCurrentTaskHandle());
+    for (num = 0; num < ITEM_COUNT; num++)
+    {
+        if (xQueueSend(xQueue, &num, 0) != pdPASS)
+        {
+            rt_kprintf("Item %d dropped\n", num);
+        }
+        if (xTaskNotifyWait(0, queueWATERMARK_HIGH_BIT, &ulBits, 0) == pdPASS && (ulBits & queueWATERMARK_HIGH_BIT))
+        {
+            rt_kprintf("Queue congested after item %d, pausing\n", num);
+            /* Wait for the consumer to drain the queue to the low mark */
+            xTaskNotifyWait(0, queueWATERMARK_LOW_BIT, &ulBits, portMAX_DELAY);
+            rt_kprintf("Queue drained, resuming\n");
+        }
+    }
+    vTaskDelete(NULL);
+}
+
+static void vConsumerTask(void *pvParameters)
+{
+    uint32_t num;
+    int i;
+
+    for (i = 0; i < ITEM_COUNT; i++)
+    {
+        xQueueReceive(xQueue, &num, portMAX_DELAY);
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    rt_kprintf("Consumer received %d items\n", i);
+    vQueueDelete(xQueue);
+    vTaskDelete(NULL);
+}
+
+int queue_watermark(void)
+{
+    xQueue = xQueueCreate(QUEUE_LENGTH, sizeof(uint32_t));
+    if (xQueue == NULL)
+    {
+        rt_kprintf("create queue failed.\n");
+        return -1;
+    }
+    xTaskCreate(vConsumerTask, "Consumer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+    xTaskCreate(vProducerTask, "Producer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_watermark, queue watermark sample);
+
+#endif /* configUSE_QUEUE_WATERMARKS == 1 */
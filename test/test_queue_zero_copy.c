@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: queue zero-copy
+ *
+ * This demo demonstrates filling and reading queue slots in place. The producer
+ * writes each frame directly into the queue storage and the consumer processes
+ * it without copying it out.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define QUEUE_LENGTH          4
+#define FRAME_SIZE            64
+
+struct frame
+{
+    uint32_t seq;
+    uint8_t payload[FRAME_SIZE - sizeof(uint32_t)];
+};
+
+/* queue handler */
+static QueueHandle_t xQueue = NULL;
+static TaskHandle_t TaskHandle1 = NULL;
+static TaskHandle_t TaskHandle2 = NULL;
+
+static void vTask1Code(void *pvParameters)
+{
+    BaseType_t xReturn;
+    struct frame *pxFrame;
+    uint32_t seq = 0;
+    while (1)
+    {
+        xReturn = xQueueAcquireReceiveSlot(xQueue, (void **)&pxFrame, portMAX_DELAY);
+        if (xReturn != pdPASS)
+        {
+            rt_kprintf("Task 1 acquire receive slot failed\n");
+            continue;
+        }
+        seq = pxFrame->seq;
+        rt_kprintf("Task 1 receive frame %d, first byte %d\n", seq, pxFrame->payload[0]);
+        xQueueReleaseReceiveSlot(xQueue, pxFrame);
+        if (seq >= 10)
+        {
+            return;
+        }
+    }
+}
+
+static void vTask2Code(void * pvParameters)
+{
+    BaseType_t xReturn;
+    struct frame *pxFrame;
+    uint32_t seq = 0;
+    while (1)
+    {
+        xReturn = xQueueAcquireSendSlot(xQueue, (void **)&pxFrame, portMAX_DELAY);
+        if (xReturn != pdPASS)
+        {
+            rt_kprintf("Task 2 acquire send slot failed\n");
+            continue;
+        }
+        pxFrame->seq = seq;
+        rt_memset(pxFrame->payload, (int)seq, sizeof(pxFrame->payload));
+        xQueueCommitSend(xQueue, pxFrame);
+        seq += 1;
+        if (seq > 10)
+        {
+            return;
+        }
+    }
+}
+
+int queue_zero_copy(void)
+{
+    xQueue = xQueueCreate(QUEUE_LENGTH, sizeof(struct frame));
+    if (xQueue == NULL)
+    {
+        rt_kprintf("create queue failed.\n");
+        return -1;
+    }
+    xTaskCreate( vTask1Code, "Task1", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, &TaskHandle1 );
+    if (TaskHandle1 == NULL)
+    {
+        rt_kprintf("Create task 1 failed\n");
+        return -1;
+    }
+    xTaskCreate( vTask2Code, "Task2", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &TaskHandle2 );
+    if (TaskHandle2 == NULL)
+    {
+        rt_kprintf("Create task 2 failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(queue_zero_copy, queue zero-copy sample);
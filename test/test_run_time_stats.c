@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: run-time stats
+ *
+ * This demo runs a busy task that spins for most of every period and a light
+ * task that only wakes up briefly, then prints the share of the CPU used by
+ * each of them, the CPU load, and the table written by vTaskGetRunTimeStats.
+ * configGENERATE_RUN_TIME_STATS, configUSE_TRACE_FACILITY and
+ * configUSE_STATS_FORMATTING_FUNCTIONS must be 1.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define STATS_BUFFER_SIZE     1024
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 )
+
+static TaskHandle_t xBusyTask = NULL;
+static TaskHandle_t xLightTask = NULL;
+
+static void vBusyTask(void *pvParameters)
+{
+    TickType_t xStart;
+
+    for (;;)
+    {
+        /* Spin for 8 ticks out of every 10 */
+        xStart = xTaskGetTickCount();
+        while (xTaskGetTickCount() - xStart < 8)
+        {
+        }
+        vTaskDelay(2);
+    }
+}
+
+static void vLightTask(void *pvParameters)
+{
+    for (;;)
+    {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+static void vReportTask(void *pvParameters)
+{
+    char *pcBuffer;
+
+    vTaskDelay(pdMS_TO_TICKS(1000));
+
+    rt_kprintf("Busy task %d%%, light task %d%%, CPU load %d%%\n",
+               ulTaskGetRunTimePercent(xBusyTask), ulTaskGetRunTimePercent(xLightTask),
+               100 - ulTaskGetIdleRunTimePercent());
+    pcBuffer = pvPortMalloc(STATS_BUFFER_SIZE);
+    if (pcBuffer != NULL)
+    {
+        vTaskGetRunTimeStats(pcBuffer);
+        rt_kprintf("%s", pcBuffer);
+        vPortFree(pcBuffer);
+    }
+    vTaskDelete(xBusyTask);
+    vTaskDelete(xLightTask);
+    vTaskDelete(NULL);
+}
+
+int run_time_stats(void)
+{
+    xTaskCreate(vBusyTask, "Busy", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &xBusyTask);
+    xTaskCreate(vLightTask, "Light", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &xLightTask);
+    xTaskCreate(vReportTask, "Report", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(run_time_stats, run-time stats sample);
+
+#endif /* ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: reader-writer lock
+ *
+ * This demo guards a small table with a lock created by
+ * xSemaphoreCreateRWLock. Three readers look the table up and hold the lock
+ * together, while a writer updates it now and then. Once the writer waits,
+ * new readers queue up behind it, so the writer gets the lock as soon as the
+ * current readers are done.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define READER_COUNT          3
+#define ROUND_COUNT           5
+
+static SemaphoreHandle_t xLock = NULL;
+static uint32_t table[4];
+static volatile int readers_inside = 0;
+static volatile int readers_done = 0;
+
+static void vReaderTask(void *pvParameters)
+{
+    int index = (int)(rt_ubase_t)pvParameters;
+    uint32_t version;
+    int inside;
+    int i;
+
+    for (i = 0; i < ROUND_COUNT * 2; i++)
+    {
+        xSemaphoreTakeRead(xLock, portMAX_DELAY);
+        inside = ++readers_inside;
+        version = table[0];
+        vTaskDelay(pdMS_TO_TICKS(10));
+        readers_inside--;
+        xSemaphoreGiveRWLock(xLock);
+        rt_kprintf("Reader %d saw version %d with %d readers inside\n", index, version, inside);
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    readers_done++;
+    vTaskDelete(NULL);
+}
+
+static void vWriterTask(void *pvParameters)
+{
+    int i;
+
+    for (i = 0; i < ROUND_COUNT; i++)
+    {
+        vTaskDelay(pdMS_TO_TICKS(20));
+        xSemaphoreTakeWrite(xLock, portMAX_DELAY);
+        /* No reader can be inside while the writer holds the lock */
+        rt_kprintf("Writer updates to version %d, %d readers inside\n", i + 1, readers_inside);
+        table[0] = i + 1;
+        xSemaphoreGiveRWLock(xLock);
+    }
+    while (readers_done < READER_COUNT)
+    {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    vSemaphoreDelete(xLock);
+    vTaskDelete(NULL);
+}
+
+int rwlock_sample(void)
+{
+    int i;
+
+    readers_done = 0;
+    xLock = xSemaphoreCreateRWLock();
+    if (xLock == NULL)
+    {
+        rt_kprintf("create reader-writer lock failed.\n");
+        return -1;
+    }
+    for (i = 0; i < READER_COUNT; i++)
+    {
+        xTaskCreate(vReaderTask, "Reader", configMINIMAL_STACK_SIZE, (void *)(rt_ubase_t)i, TASK_PRIORITY, NULL);
+    }
+    xTaskCreate(vWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(rwlock_sample, reader-writer lock sample);
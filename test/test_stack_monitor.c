@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: stack monitor
+ *
+ * This demo creates a task with a generous stack that only ever needs a small
+ * part of it, and prints its stack high water mark as it goes deeper. Once
+ * the stack monitor has seen it, run stack_monitor to see its peak use and the
+ * suggested usStackDepth. configUSE_STACK_MONITOR must be 1.
+ *
+ */
+
+#include <rtthread.h>
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define TASK_STACK_DEPTH      1024
+
+#if ( configUSE_STACK_MONITOR == 1 )
+
+static void prvUseStack(int depth)
+{
+    volatile uint8_t buffer[64];
+
+    rt_memset((void *)buffer, depth, sizeof(buffer));
+    if (depth > 0)
+    {
+        prvUseStack(depth - 1);
+    }
+}
+
+static void vOversizedTask(void *pvParameters)
+{
+    int depth;
+
+    for (depth = 0; depth < 4; depth++)
+    {
+        prvUseStack(depth);
+        rt_kprintf("Depth %d: %d of %d words never used\n", depth,
+                   uxTaskGetStackHighWaterMark(NULL), TASK_STACK_DEPTH);
+        vTaskDelay(pdMS_TO_TICKS(configSTACK_MONITOR_PERIOD_MS));
+    }
+    rt_kprintf("Run stack_monitor to see the suggested depth of task Oversize\n");
+    vTaskDelete(NULL);
+}
+
+int stack_monitor_sample(void)
+{
+    xTaskCreate(vOversizedTask, "Oversize", TASK_STACK_DEPTH, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(stack_monitor_sample, stack monitor sample);
+
+#endif /* configUSE_STACK_MONITOR == 1 */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: task count
+ *
+ * This demo creates tasks through the wrapper and threads through the
+ * RT-Thread API, and prints uxTaskGetNumberOfTasks as they come and go. Both
+ * kinds are counted. A deleted task is still counted until the idle thread
+ * has freed it. With configUSE_LIVE_TASK_COUNT set to 1 the count is read
+ * without walking the thread list.
+ *
+ */
+
+#include <rtthread.h>
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define TASK_COUNT            4
+
+static void vIdleTask(void *pvParameters)
+{
+    for (;;)
+    {
+        vTaskDelay(portMAX_DELAY);
+    }
+}
+
+static void vReportTask(void *pvParameters)
+{
+    TaskHandle_t xTasks[TASK_COUNT];
+    rt_thread_t threads[TASK_COUNT];
+    int i;
+
+    rt_kprintf("%d tasks at start\n", uxTaskGetNumberOfTasks());
+    for (i = 0; i < TASK_COUNT; i++)
+    {
+        xTasks[i] = NULL;
+        xTaskCreate(vIdleTask, "Task", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, &xTasks[i]);
+        threads[i] = rt_thread_create("thread", vIdleTask, RT_NULL, 512, FINSH_THREAD_PRIORITY, 10);
+        if (threads[i] != RT_NULL)
+        {
+            rt_thread_startup(threads[i]);
+        }
+    }
+    rt_kprintf("%d tasks after creating %d tasks and %d threads\n", uxTaskGetNumberOfTasks(), TASK_COUNT, TASK_COUNT);
+    for (i = 0; i < TASK_COUNT; i++)
+    {
+        if (xTasks[i] != NULL)
+        {
+            vTaskDelete(xTasks[i]);
+        }
+        if (threads[i] != RT_NULL)
+        {
+            rt_thread_delete(threads[i]);
+        }
+    }
+    /* Let the idle thread free them */
+    vTaskDelay(pdMS_TO_TICKS(100));
+    rt_kprintf("%d tasks after deleting them\n", uxTaskGetNumberOfTasks());
+    vTaskDelete(NULL);
+}
+
+int task_count(void)
+{
+    xTaskCreate(vReportTask, "Report", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(task_count, task count sample);
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Demo: task snapshot
+ *
+ * This demo starts two worker tasks, one that keeps blocking on a delay and
+ * one that suspends itself, then takes a snapshot of every task with
+ * uxTaskGetSystemState and prints it, followed by the same information
+ * formatted by vTaskList. configUSE_TRACE_FACILITY and
+ * configUSE_STATS_FORMATTING_FUNCTIONS must be 1.
+ *
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define TASK_PRIORITY         (FINSH_THREAD_PRIORITY + 1)
+#define LIST_BUFFER_SIZE      1024
+
+#if ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 )
+
+static TaskHandle_t xDelayTask = NULL;
+static TaskHandle_t xSuspendTask = NULL;
+static const char *pcStates[] = {"Running", "Ready", "Blocked", "Suspended", "Deleted", "Invalid"};
+
+static void vDelayTask(void *pvParameters)
+{
+    for (;;)
+    {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+static void vSuspendTask(void *pvParameters)
+{
+    for (;;)
+    {
+        vTaskSuspend(NULL);
+    }
+}
+
+static void vReportTask(void *pvParameters)
+{
+    TaskStatus_t *pxTaskStatusArray;
+    UBaseType_t uxArraySize, x;
+    char *pcBuffer;
+
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    /* Leave room for tasks created between counting and the snapshot */
+    uxArraySize = uxTaskGetNumberOfTasks() + 4;
+    pxTaskStatusArray = pvPortMalloc(uxArraySize * sizeof(TaskStatus_t));
+    pcBuffer = pvPortMalloc(LIST_BUFFER_SIZE);
+    if (pxTaskStatusArray != NULL && pcBuffer != NULL)
+    {
+        uxArraySize = uxTaskGetSystemState(pxTaskStatusArray, uxArraySize, NULL);
+        for (x = 0; x < uxArraySize; x++)
+        {
+            rt_kprintf("%-8.8s %-9s priority %2d, %4d words of stack unused\n",
+                       pxTaskStatusArray[x].pcTaskName, pcStates[pxTaskStatusArray[x].eCurrentState],
+                       pxTaskStatusArray[x].uxCurrentPriority, pxTaskStatusArray[x].usStackHighWaterMark);
+        }
+        vTaskList(pcBuffer);
+        rt_kprintf("%s", pcBuffer);
+    }
+    vPortFree(pcBuffer);
+    vPortFree(pxTaskStatusArray);
+    vTaskDelete(xDelayTask);
+    vTaskDelete(xSuspendTask);
+    vTaskDelete(NULL);
+}
+
+int task_snapshot(void)
+{
+    xTaskCreate(vDelayTask, "Delay", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, &xDelayTask);
+    xTaskCreate(vSuspendTask, "Suspend", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY + 1, &xSuspendTask);
+    xTaskCreate(vReportTask, "Report", configMINIMAL_STACK_SIZE, NULL, TASK_PRIORITY, NULL);
+
+    return 0;
+}
+
+MSH_CMD_EXPORT(task_snapshot, task snapshot sample);
+
+#endif /* ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) */